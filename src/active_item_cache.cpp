@@ -3,31 +3,113 @@
 #include <algorithm>
 #include <utility>
 
+#include "calendar.h"
 #include "item.h"
 #include "safe_reference.h"
 
-void active_item_cache::remove( const item *it )
+void item_timer_wheel::start( int now )
+{
+    cursor = now;
+    started = true;
+}
+
+void item_timer_wheel::schedule( entry &&e )
 {
-    for( auto &list : active_items ) {
-        int count = 0;
-        list.second.second.erase( std::remove_if( list.second.second.begin(),
-        list.second.second.end(), [it, &count, &list]( const cache_reference<item> &active_item ) {
-            if( !active_item ) {
-                count++;
-                return true;
+    if( !started ) {
+        // Nothing can be due before the first entry is scheduled
+        start( e.due - 1 );
+    }
+    e.due = std::max( e.due, cursor + 1 );
+    insert( std::move( e ) );
+}
+
+void item_timer_wheel::insert( entry &&e )
+{
+    const int delta = e.due - cursor;
+    count++;
+    if( delta < level0_size ) {
+        level0[e.due & ( level0_size - 1 )].push_back( std::move( e ) );
+    } else if( delta < span ) {
+        level1[( e.due >> level0_bits ) & ( level1_size - 1 )].push_back( std::move( e ) );
+    } else {
+        overflow.push_back( std::move( e ) );
+    }
+}
+
+void item_timer_wheel::cascade( std::vector<entry> &slot )
+{
+    std::vector<entry> moving;
+    moving.swap( slot );
+    count -= moving.size();
+    // Runs once cursor reached the slot, before its first level0 slot is collected, so
+    // entries due on the cursor turn itself are still on time
+    for( entry &e : moving ) {
+        insert( std::move( e ) );
+    }
+}
+
+bool item_timer_wheel::contains( const item &it ) const
+{
+    const auto in_slot = [&it]( const std::vector<entry> &slot ) {
+        return std::any_of( slot.begin(), slot.end(), [&it]( const entry & e ) {
+            return e.ref == it;
+        } );
+    };
+    return std::any_of( level0.begin(), level0.end(), in_slot ) ||
+           std::any_of( level1.begin(), level1.end(), in_slot ) || in_slot( overflow );
+}
+
+void item_timer_wheel::advance( int now, std::vector<entry> &due )
+{
+    if( !started ) {
+        start( now );
+        return;
+    }
+    if( now - cursor >= span ) {
+        // Wheel wasn't advanced for longer than it covers, everything is overdue
+        const auto drain = [&]( std::vector<entry> &slot ) {
+            for( entry &e : slot ) {
+                due.push_back( std::move( e ) );
             }
-            item *const target = &*active_item;
-            if( !target || target == it ) {
-                if( count >= list.second.first ) {
-                    list.second.first = std::max( 0, list.second.first - 1 );
-                }
-                count++;
-                return true;
+            slot.clear();
+        };
+        for( std::vector<entry> &slot : level0 ) {
+            drain( slot );
+        }
+        for( std::vector<entry> &slot : level1 ) {
+            drain( slot );
+        }
+        drain( overflow );
+        count = 0;
+        cursor = now;
+        return;
+    }
+    while( cursor < now ) {
+        cursor++;
+        if( ( cursor & ( level0_size - 1 ) ) == 0 ) {
+            if( ( cursor & ( span - 1 ) ) == 0 ) {
+                cascade( overflow );
             }
-            count++;
-            return false;
-        } ), list.second.second.end() );
+            cascade( level1[( cursor >> level0_bits ) & ( level1_size - 1 )] );
+        }
+        std::vector<entry> &slot = level0[cursor & ( level0_size - 1 )];
+        for( entry &e : slot ) {
+            due.push_back( std::move( e ) );
+        }
+        count -= slot.size();
+        slot.clear();
     }
+}
+
+void active_item_cache::remove( const item *it )
+{
+    every_turn.erase( std::remove_if( every_turn.begin(), every_turn.end(),
+    [it]( const cache_reference<item> &active_item ) {
+        return !active_item || active_item == it;
+    } ), every_turn.end() );
+    scheduled.remove_if( [it]( const item_timer_wheel::entry & e ) {
+        return !e.ref || e.ref == it;
+    } );
     if( it->can_revive() ) {
         std::vector<cache_reference<item>> &corpse = special_items[ special_item_type::corpse ];
         corpse.erase( std::remove( corpse.begin(), corpse.end(), it ), corpse.end() );
@@ -41,9 +123,15 @@ void active_item_cache::remove( const item *it )
 void active_item_cache::add( item &it )
 {
     // If the item is alread in the cache for some reason, don't add a second reference
-    std::vector<cache_reference<item>> &target_list = active_items[it.processing_speed()].second;
-    if( std::find( target_list.begin(), target_list.end(), it ) != target_list.end() ) {
-        return;
+    const int speed = it.processing_speed();
+    if( speed <= 1 ) {
+        if( std::find( every_turn.begin(), every_turn.end(), it ) != every_turn.end() ) {
+            return;
+        }
+    } else {
+        if( scheduled.contains( it ) ) {
+            return;
+        }
     }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].emplace_back( it );
@@ -51,72 +139,66 @@ void active_item_cache::add( item &it )
     if( it.get_use( "explosion" ) ) {
         special_items[ special_item_type::explosive ].emplace_back( it );
     }
-    target_list.emplace_back( it );
+    if( speed <= 1 ) {
+        every_turn.emplace_back( it );
+        return;
+    }
+    // First wakeup lands somewhere within the next `speed` turns, so that a batch of
+    // items added at once doesn't get processed all on the same turn.
+    stagger = ( stagger + 1 ) % speed;
+    scheduled.schedule( { cache_reference<item>( it ), to_turn<int>( calendar::turn ) + 1 + stagger, speed } );
 }
 
 bool active_item_cache::empty() const
 {
-    return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
-        return active_queue.second.second.empty();
-    } );
+    return every_turn.empty() && scheduled.size() == 0;
 }
 
 std::vector<item *> active_item_cache::get()
 {
     std::vector<item *> all_cached_items;
-    for( std::pair<const int, std::pair<int, std::vector<cache_reference<item>>>> &kv : active_items ) {
-        for( std::vector<cache_reference<item>>::iterator it = kv.second.second.begin();
-             it != kv.second.second.end(); ) {
-            if( *it ) {
-                all_cached_items.push_back( & **it );
-                ++it;
-            } else {
-                it = kv.second.second.erase( it );
-            }
+    every_turn.erase( std::remove_if( every_turn.begin(), every_turn.end(),
+    [&all_cached_items]( const cache_reference<item> &active_item ) {
+        if( !active_item ) {
+            return true;
         }
-    }
+        all_cached_items.push_back( &*active_item );
+        return false;
+    } ), every_turn.end() );
+    scheduled.remove_if( [&all_cached_items]( const item_timer_wheel::entry & e ) {
+        if( !e.ref ) {
+            return true;
+        }
+        all_cached_items.push_back( &*e.ref );
+        return false;
+    } );
     return all_cached_items;
 }
 
 std::vector<item *> active_item_cache::get_for_processing()
 {
     std::vector<item *> items_to_process;
-    for( std::pair < const int, std::pair<int, std::vector<cache_reference<item>>>> &kv :
-         active_items ) {
-        //The algorithm here is a bit weird. We're going to process a fraction of the list at a time, keeping track of where we are in the list with a simple int.
-        //But, the list could change between each run. As such the number will be reduced when items are removed from it (in ::remove) to prevent skips.
-
-        if( kv.second.second.empty() ) { //Prevents a div by 0 in the modulo operations
-            kv.second.first = 0; //May as well reset the position
-            continue;
+    every_turn.erase( std::remove_if( every_turn.begin(), every_turn.end(),
+    [&items_to_process]( const cache_reference<item> &active_item ) {
+        if( !active_item ) {
+            // The item has been destroyed, so remove the reference from the cache
+            return true;
         }
+        items_to_process.push_back( &*active_item );
+        return false;
+    } ), every_turn.end() );
 
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = std::max( 1, static_cast<int>( kv.second.second.size() / kv.first ) );
-        std::vector<cache_reference<item>>::iterator it = kv.second.second.begin();
-
-
-        kv.second.first = kv.second.first %
-                          kv.second.second.size(); //Make sure the key isn't larger than the array
-        std::advance( it, kv.second.first );
-
-        kv.second.first += num_to_process + 1;
-        while( num_to_process > 0 ) {
-            if( *it ) {
-                items_to_process.push_back( & **it );
-                --num_to_process;
-                ++it;
-            } else {
-                // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.second.erase( it );
-                if( kv.second.second.empty() ) {
-                    break;
-                }
-            }
-            if( it == kv.second.second.end() ) {
-                it = kv.second.second.begin();
-            }
+    const int now = to_turn<int>( calendar::turn );
+    std::vector<item_timer_wheel::entry> due;
+    scheduled.advance( now, due );
+    for( item_timer_wheel::entry &e : due ) {
+        if( !e.ref ) {
+            continue;
         }
+        items_to_process.push_back( &*e.ref );
+        // Keep the phase of the item, unless it fell behind by more than a whole interval
+        e.due = std::max( e.due + e.interval, now + 1 );
+        scheduled.schedule( std::move( e ) );
     }
     return items_to_process;
 }
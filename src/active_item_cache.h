@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iosfwd>
 #include <list>
 #include <unordered_map>
@@ -26,10 +28,70 @@ struct hash<special_item_type> {
 };
 } // namespace std
 
+/**
+ * Hierarchical timer wheel of item references, keyed by the turn they are next due.
+ *
+ * The first level has one slot per turn, the second one slot per first level revolution.
+ * Entries further in the future than the second level covers wait in an overflow list.
+ * Advancing the wheel only touches slots of the turns that passed, so the cost scales
+ * with the number of due entries rather than the number of scheduled ones.
+ */
+class item_timer_wheel
+{
+    public:
+        struct entry {
+            cache_reference<item> ref;
+            // Turn at which the entry is due
+            int due = 0;
+            // Turns between consecutive wakeups
+            int interval = 1;
+        };
+
+        /** Schedules an entry, clamping due turns that already passed to the next turn. */
+        void schedule( entry &&e );
+        /**
+         * Moves all entries due at or before given turn into @p due, in order of due turn.
+         * Turns skipped while the wheel wasn't advanced are caught up at once.
+         */
+        void advance( int now, std::vector<entry> &due );
+        bool contains( const item &it ) const;
+        /** Calls @p fn on every scheduled entry; entries for which it returns true are removed. */
+        template<typename F>
+        void remove_if( F fn );
+        /** Number of scheduled entries. */
+        size_t size() const {
+            return count;
+        }
+
+        static constexpr int level0_bits = 8;
+        static constexpr int level0_size = 1 << level0_bits;
+        static constexpr int level1_size = 64;
+        static constexpr int span = level0_size * level1_size;
+
+    private:
+        void start( int now );
+        // Places an entry due at or after the cursor turn into its slot
+        void insert( entry &&e );
+        void cascade( std::vector<entry> &slot );
+
+        // Last turn whose slot was collected
+        int cursor = 0;
+        bool started = false;
+        size_t count = 0;
+        std::array<std::vector<entry>, level0_size> level0;
+        std::array<std::vector<entry>, level1_size> level1;
+        std::vector<entry> overflow;
+};
+
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::pair<int, std::vector<cache_reference<item>>>> active_items;
+        // Items processed on every turn
+        std::vector<cache_reference<item>> every_turn;
+        // Items processed once every item::processing_speed() turns
+        item_timer_wheel scheduled;
+        // Spreads out the first wakeup of items added on the same turn
+        int stagger = 0;
         std::unordered_map<special_item_type, std::vector<cache_reference<item>>> special_items;
 
     public:
@@ -58,9 +120,9 @@ class active_item_cache
         std::vector<item *> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the items due for processing on the current turn: every item with a
+         * processing speed of 1, and the slower items whose wakeup turn has come.
+         * Items returned are rescheduled processing_speed() turns later.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
@@ -73,3 +135,20 @@ class active_item_cache
         std::vector<item *> get_special( special_item_type type );
 };
 
+
+template<typename F>
+void item_timer_wheel::remove_if( F fn )
+{
+    const auto prune = [&]( std::vector<entry> &slot ) {
+        const size_t before = slot.size();
+        slot.erase( std::remove_if( slot.begin(), slot.end(), fn ), slot.end() );
+        count -= before - slot.size();
+    };
+    for( std::vector<entry> &slot : level0 ) {
+        prune( slot );
+    }
+    for( std::vector<entry> &slot : level1 ) {
+        prune( slot );
+    }
+    prune( overflow );
+}
@@ -224,6 +224,20 @@ bool string_id<bionic_data>::is_valid() const
     return bionic_factory.is_valid( *this );
 }
 
+/** @relates string_id */
+template<>
+int_id<bionic_data> string_id<bionic_data>::id() const
+{
+    return bionic_factory.convert( *this, int_id<bionic_data>( -1 ) );
+}
+
+/** @relates string_id */
+template<>
+int_id<bionic_data> string_id<bionic_data>::id_or( const int_id<bionic_data> &fallback ) const
+{
+    return bionic_factory.is_valid( *this ) ? bionic_factory.convert( *this, fallback ) : fallback;
+}
+
 std::vector<bodypart_id> get_occupied_bodyparts( const bionic_id &bid )
 {
     std::vector<bodypart_id> parts;
@@ -1158,7 +1172,7 @@ bool Character::activate_bionic( bionic &bio, bool eff_only, bool *close_bionics
     }
 
     // Recalculate stats (strength, mods from pain etc.) that could have been affected
-    reset_encumbrance();
+    invalidate_derived( char_input::bionics );
     reset();
 
     // Also reset crafting inventory cache if this bionic spawned a fake item
@@ -1239,7 +1253,7 @@ bool Character::deactivate_bionic( bionic &bio, bool eff_only )
     }
 
     // Recalculate stats (strength, mods from pain etc.) that could have been affected
-    reset_encumbrance();
+    invalidate_derived( char_input::bionics );
     reset();
     if( !bio.id->enchantments.empty() ) {
         recalculate_enchantment_cache();
@@ -2828,6 +2842,7 @@ void Character::add_bionic( const bionic_id &b )
 
     const auto invlet = b.obj().activated ? get_free_invlet( *my_bionics ) : ' ';
     my_bionics->push_back( bionic( b, invlet ) );
+    bionic_bits.set( b.id() );
     if( b->has_flag( flag_INITIALLY_ACTIVATE ) ) {
         activate_bionic( my_bionics->back() );
     }
@@ -2858,7 +2873,7 @@ void Character::add_bionic( const bionic_id &b )
         }
     }
 
-    reset_encumbrance();
+    invalidate_derived( char_input::bionics );
     recalc_sight_limits();
     if( !b->enchantments.empty() ) {
         recalculate_enchantment_cache();
@@ -2898,7 +2913,11 @@ void Character::remove_bionic( const bionic_id &b )
     }
 
     *my_bionics = new_my_bionics;
-    reset_encumbrance();
+    bionic_bits.clear();
+    for( const bionic &i : *my_bionics ) {
+        bionic_bits.set( i.id.id() );
+    }
+    invalidate_derived( char_input::bionics );
     recalc_sight_limits();
     if( !b->enchantments.empty() ) {
         recalculate_enchantment_cache();
@@ -2913,6 +2932,8 @@ bool Character::has_bionics() const
 void Character::clear_bionics()
 {
     my_bionics->clear();
+    bionic_bits.clear();
+    invalidate_derived( char_input::bionics );
 }
 
 void bionic::set_flag( const std::string &flag )
@@ -3,6 +3,7 @@
 // A collection of options which are accessed frequently enough that we don't
 // want to pay the overhead of a string lookup each time one is tested.
 // They should be updated when the corresponding option is changed (in options.cpp).
+// Other frequently read options can use an option_handle (see options.h) instead.
 
 /**
  * Set to true when running in test mode (e.g. unit tests, checking mods).
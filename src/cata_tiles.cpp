@@ -12,6 +12,7 @@
 #include <iterator>
 #include <optional>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <tuple>
 #include <unordered_set>
@@ -59,6 +60,7 @@
 #include "omdata.h"
 #include "output.h"
 #include "overlay_ordering.h"
+#include "overmap.h"
 #include "overmap_location.h"
 #include "path_info.h"
 #include "pixel_minimap.h"
@@ -77,6 +79,7 @@
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
+#include "uistate.h"
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
@@ -236,6 +239,12 @@ struct tile_render_info {
     }
 };
 
+// Lighting sprite drawn on a tile that isn't clearly visible
+struct vision_effect_info {
+    tripoint pos;
+    visibility_type visibility;
+};
+
 cata_tiles::cata_tiles( const SDL_Renderer_Ptr &renderer, const GeometryRenderer_Ptr &geometry ) :
     renderer( renderer ),
     geometry( geometry ),
@@ -372,6 +381,7 @@ void cata_tiles::load_tileset(
     loader.load( tileset_id, precheck, /*pump_events=*/pump_events );
     tileset_ptr = std::move( new_tileset_ptr );
     tileset_mod_list_stamp = mod_list;
+    invalidate_view_cache();
 
     set_draw_scale( 16 );
 
@@ -1935,11 +1945,18 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
     }
 
     std::vector<tile_render_info> &draw_points = *draw_points_cache;
+    draw_points.clear();
+    // Index of the first draw point of each row, and the end of the last row
+    std::vector<size_t> row_starts;
+    // Vision effects are drawn with the row they are on, before its tiles
+    std::vector<vision_effect_info> vision_effects;
+    std::vector<size_t> effect_row_starts;
     int min_z = OVERMAP_HEIGHT;
 
     for( int row = min_row; row < max_row; row ++ ) {
 
-        draw_points.clear();
+        row_starts.push_back( draw_points.size() );
+        effect_row_starts.push_back( vision_effects.size() );
         for( int col = min_col; col < max_col; col ++ ) {
             int temp_x;
             int temp_y;
@@ -2118,7 +2135,7 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
                             ll = lit_level::DARK;
                             invisible[0] = true;
                         } else {
-                            apply_vision_effects( pos, offscreen_type );
+                            vision_effects.push_back( { pos, offscreen_type } );
                             break;
                         }
                     }
@@ -2132,7 +2149,9 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
                                            would_apply_vision_effects( here.get_visibility( ch.visibility_cache[np.x][np.y], cache ) );
                     }
 
-                    if( !invisible[0] && apply_vision_effects( pos, here.get_visibility( ll, cache ) ) ) {
+                    const visibility_type visibility = here.get_visibility( ll, cache );
+                    if( !invisible[0] && would_apply_vision_effects( visibility ) ) {
+                        vision_effects.push_back( { pos, visibility } );
                         if( has_draw_override( pos ) || has_memory_at( pos ) ) {
                             invisible[0] = true;
                         }
@@ -2160,35 +2179,44 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
             }
         }
 
-        auto compare_z = [&]( tile_render_info a, tile_render_info b ) -> bool {
-            return ( a.pos.z < b.pos.z );
-        };
+    }
+    row_starts.push_back( draw_points.size() );
+    effect_row_starts.push_back( vision_effects.size() );
 
-        const std::array<decltype( &cata_tiles::draw_furniture ), 3> base_drawing_layers = {{
-                &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap
-            }
-        };
-        struct zlevel_layer {
-            bool hide_unseen;
-            decltype( &cata_tiles::draw_furniture ) function;
-        };
-        const std::array < zlevel_layer, 3 > zlevel_drawing_layers = {{
-                {true, &cata_tiles::draw_field_or_item}, {false, &cata_tiles::draw_vpart}, {true, &cata_tiles::draw_critter_at}
-            }
-        };
+    auto compare_z = [&]( tile_render_info a, tile_render_info b ) -> bool {
+        return ( a.pos.z < b.pos.z );
+    };
 
-        const std::array<decltype( &cata_tiles::draw_furniture ), 2> final_drawing_layers = {{
-                &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
-            }
-        };
+    const std::array<decltype( &cata_tiles::draw_furniture ), 3> base_drawing_layers = {{
+            &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap
+        }
+    };
+    struct zlevel_layer {
+        bool hide_unseen;
+        decltype( &cata_tiles::draw_furniture ) function;
+    };
+    const std::array < zlevel_layer, 3 > zlevel_drawing_layers = {{
+            {true, &cata_tiles::draw_field_or_item}, {false, &cata_tiles::draw_vpart}, {true, &cata_tiles::draw_critter_at}
+        }
+    };
 
-        std::stable_sort( draw_points.begin(), draw_points.end(), compare_z );
-        for( tile_render_info &p : draw_points ) {
+    const std::array<decltype( &cata_tiles::draw_furniture ), 2> final_drawing_layers = {{
+            &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
+        }
+    };
+
+    const auto draw_row = [&]( std::span<const vision_effect_info> row_effects,
+    std::span<tile_render_info> row_points ) {
+        for( const vision_effect_info &effect : row_effects ) {
+            apply_vision_effects( effect.pos, effect.visibility );
+        }
+        std::stable_sort( row_points.begin(), row_points.end(), compare_z );
+        for( tile_render_info &p : row_points ) {
             draw_terrain( p.pos, p.ll, p.height_3d, p.invisible, center.z - p.pos.z );
         }
 
         for( int z = min_z; z <= center.z; z++ ) {
-            for( tile_render_info &p : draw_points ) {
+            for( tile_render_info &p : row_points ) {
                 if( p.pos.z > z ) {
                     break;
                 }
@@ -2212,11 +2240,74 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
             }
         }
 
-        for( tile_render_info &p : draw_points ) {
+        for( tile_render_info &p : row_points ) {
             for( decltype( &cata_tiles::draw_furniture ) f : final_drawing_layers ) {
                 ( this->*f )( p.pos, p.ll, p.height_3d, p.invisible, 0 );
             }
         }
+    };
+
+    // The map layers are drawn into a texture that is reused as long as
+    // nothing drawn on screen changes, e.g. while a menu is open on top.
+    const point view_size( width, height );
+    if( !cache_terrain_view ) {
+        view_cache.valid = false;
+        view_cache.texture.reset();
+    } else if( view_cache.size != view_size || !view_cache.texture ) {
+        view_cache.valid = false;
+        view_cache.size = view_size;
+        view_cache.texture.reset();
+        if( SDL_RenderTargetSupported( renderer.get() ) ) {
+            view_cache.texture = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                SDL_TEXTUREACCESS_TARGET, width, height );
+        }
+    }
+    const bool cacheable = view_cache.texture && view_cacheable();
+    bool reuse_view = false;
+    if( cacheable ) {
+        size_t frame_hash = view_frame_hash( dest, center, width, height );
+        for( const vision_effect_info &effect : vision_effects ) {
+            cata::hash_combine( frame_hash, effect.pos.x );
+            cata::hash_combine( frame_hash, effect.pos.y );
+            cata::hash_combine( frame_hash, effect.pos.z );
+            cata::hash_combine( frame_hash, static_cast<int>( effect.visibility ) );
+        }
+        reuse_view = view_cache.valid && view_cache.frame_hash == frame_hash &&
+                     view_cache.tile_hashes.size() == draw_points.size();
+        view_cache.frame_hash = frame_hash;
+        view_cache.tile_hashes.resize( draw_points.size() );
+        for( size_t i = 0; i < draw_points.size(); i++ ) {
+            const size_t tile_hash = view_tile_hash( draw_points[i], center.z );
+            reuse_view = reuse_view && view_cache.tile_hashes[i] == tile_hash;
+            view_cache.tile_hashes[i] = tile_hash;
+        }
+    }
+
+    if( !reuse_view ) {
+        const auto render_state = sdl_save_render_state( renderer.get() );
+        if( view_cache.texture ) {
+            SetRenderTarget( renderer, view_cache.texture );
+            SetRenderDrawColor( renderer, 0, 0, 0, 255 );
+            RenderClear( renderer );
+            // Draw relative to the texture
+            op = point_zero;
+        }
+        for( size_t row = 0; row + 1 < row_starts.size(); row++ ) {
+            draw_row( std::span<const vision_effect_info>( vision_effects.begin() + effect_row_starts[row],
+                      vision_effects.begin() + effect_row_starts[row + 1] ),
+                      std::span<tile_render_info>( draw_points.begin() + row_starts[row],
+                                                   draw_points.begin() + row_starts[row + 1] ) );
+        }
+        if( view_cache.texture ) {
+            sdl_restore_render_state( renderer.get(), render_state );
+            op = dest;
+        }
+        view_cache.valid = cacheable && !idle_animations.present();
+    }
+    if( view_cache.texture ) {
+        const SDL_Rect view_rect{ dest.x, dest.y, width, height };
+        SetTextureBlendMode( view_cache.texture, SDL_BLENDMODE_NONE );
+        RenderCopy( renderer, view_cache.texture, nullptr, &view_rect );
     }
 
     // display number of monsters to spawn in mapgen preview
@@ -2451,6 +2542,98 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
                   "SDL_RenderSetClipRect failed" );
 }
 
+size_t cata_tiles::view_frame_hash( point dest, const tripoint &center, int width,
+                                    int height ) const
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, dest.x );
+    cata::hash_combine( seed, dest.y );
+    cata::hash_combine( seed, width );
+    cata::hash_combine( seed, height );
+    cata::hash_combine( seed, center.x );
+    cata::hash_combine( seed, center.y );
+    cata::hash_combine( seed, center.z );
+    cata::hash_combine( seed, tile_width );
+    cata::hash_combine( seed, tile_height );
+    cata::hash_combine( seed, tile_iso );
+    cata::hash_combine( seed, fov_3d );
+    cata::hash_combine( seed, tileset_ptr.get() );
+    cata::hash_combine( seed, memory_map_mode );
+    cata::hash_combine( seed, nv_goggles_activated );
+    // Creatures and the player may change appearance whenever anyone acts
+    cata::hash_combine( seed, to_turns<int>( calendar::turn - calendar::turn_zero ) );
+    cata::hash_combine( seed, g->u.moves );
+    cata::hash_combine( seed, static_cast<int>( g->u.facing ) );
+    for( const Character::overlay_entry &overlay : g->u.get_overlay_ids() ) {
+        cata::hash_combine( seed, overlay.id );
+    }
+    return seed;
+}
+
+size_t cata_tiles::view_tile_hash( const tile_render_info &tile, const int center_z ) const
+{
+    const map &here = get_map();
+    size_t seed = 0;
+    cata::hash_combine( seed, tile.pos.x );
+    cata::hash_combine( seed, tile.pos.y );
+    cata::hash_combine( seed, tile.pos.z );
+    cata::hash_combine( seed, static_cast<int>( tile.ll ) );
+    for( const bool invisible : tile.invisible ) {
+        cata::hash_combine( seed, invisible );
+    }
+    if( tile.invisible[0] || !here.inbounds( tile.pos ) ) {
+        const memorized_terrain_tile &memory = g->u.get_memorized_tile( here.getabs( tile.pos ) );
+        cata::hash_combine( seed, memory.tile );
+        cata::hash_combine( seed, memory.subtile );
+        cata::hash_combine( seed, memory.rotation );
+    }
+    if( !here.inbounds( tile.pos ) ) {
+        return seed;
+    }
+    cata::hash_combine( seed, here.ter( tile.pos ) );
+    cata::hash_combine( seed, here.furn( tile.pos ) );
+    cata::hash_combine( seed, here.tr_at( tile.pos ).loadid );
+    cata::hash_combine( seed, here.has_graffiti_at( tile.pos ) );
+    // Layers above the tile are drawn too, down to the tile itself
+    for( int z = tile.pos.z; z <= center_z; z++ ) {
+        const tripoint p( tile.pos.xy(), z );
+        const field &fields = here.field_at( p );
+        const field_type_id displayed = fields.displayed_field_type();
+        cata::hash_combine( seed, displayed );
+        if( const field_entry *entry = fields.find_field( displayed ) ) {
+            cata::hash_combine( seed, entry->get_field_intensity() );
+        }
+        const maptile items = here.maptile_at( p );
+        const size_t item_count = items.get_item_count();
+        cata::hash_combine( seed, item_count );
+        if( item_count > 0 ) {
+            cata::hash_combine( seed, items.get_uppermost_item().typeId() );
+        }
+        if( const optional_vpart_position vp = here.veh_at( p ) ) {
+            const vehicle &veh = vp->vehicle();
+            cata::hash_combine( seed, &veh );
+            cata::hash_combine( seed, vp->part_index() );
+            cata::hash_combine( seed, to_degrees( veh.face.dir() ) );
+        }
+        if( const Creature *critter = g->critter_at<Creature>( p, true ) ) {
+            cata::hash_combine( seed, critter );
+            cata::hash_combine( seed, critter->get_hp() );
+            cata::hash_combine( seed, static_cast<int>( critter->facing ) );
+        }
+    }
+    return seed;
+}
+
+bool cata_tiles::view_cacheable() const
+{
+    // Overrides and zone marks are only shown while a menu edits them
+    return radiation_override.empty() && terrain_override.empty() &&
+           furniture_override.empty() && graffiti_override.empty() && trap_override.empty() &&
+           field_override.empty() && item_override.empty() && vpart_override.empty() &&
+           draw_below_override.empty() && monster_override.empty() &&
+           !g->is_zones_manager_open();
+}
+
 bool cata_tiles::terrain_requires_animation() const
 {
     return idle_animations.enabled() && idle_animations.present();
@@ -2880,6 +3063,109 @@ void cata_tiles::draw_om_tile_recursively( const tripoint_abs_omt omp, const std
         ll, false, base_z_offset, false );
 }
 
+void cata_tiles::draw_om_terrain( const tripoint_abs_omt &omp, const std::string &id,
+                                  int rotation, int subtile, const bool has_debug_vision, int &height_3d )
+{
+    if( overmap_transparency ) {
+        std::string shown_id = id;
+        int z_offset = 0;
+        while( shown_id == "open_air" ) {
+            z_offset++;
+            const tripoint_abs_omt lower_omp = omp + tripoint( 0, 0, -z_offset );
+            const bool lower_see = has_debug_vision || overmap_buffer.seen( lower_omp );
+            if( !lower_see ) {
+                //actually really strange situation when above overmap is explored, but below one isn't
+                //so let's account for this just in case, drawing highest seen tile
+                z_offset--;
+                break;
+            }
+            shown_id = get_omt_id_rotation_and_subtile( lower_omp, rotation, subtile );
+        }
+        draw_om_tile_recursively( omp + tripoint( 0, 0, -z_offset ), shown_id, rotation, subtile,
+                                  z_offset );
+    } else {
+        const lit_level ll = overmap_buffer.is_explored( omp ) ? lit_level::LOW : lit_level::LIT;
+
+        auto [bgCol, fgCol] = get_overmap_color( overmap_buffer, omp );
+
+        // light level is now used for choosing between grayscale filter and normal lit tiles.
+        const tile_search_params tile { id, C_OVERMAP_TERRAIN, "overmap_terrain", subtile, rotation };
+        draw_from_id_string( tile, omp.raw(), bgCol, fgCol, ll, false, 0, false, height_3d );
+    }
+}
+
+size_t cata_tiles::om_chunk_key( const tripoint_abs_omt &origin, const bool has_debug_vision ) const
+{
+    size_t seed = 0;
+    // Connected terrain looks at the neighbours just outside the chunk
+    const point_abs_om om_min = project_to<coords::om>( origin.xy() + point_north_west );
+    const point_abs_om om_max = project_to<coords::om>( origin.xy() + point( om_chunk_size,
+                                om_chunk_size ) );
+    for( int y = om_min.y(); y <= om_max.y(); y++ ) {
+        for( int x = om_min.x(); x <= om_max.x(); x++ ) {
+            const overmap *om = overmap_buffer.get_existing( point_abs_om( x, y ) );
+            cata::hash_combine( seed, om ? om->get_revision() : int64_t( -1 ) );
+        }
+    }
+    cata::hash_combine( seed, tileset_ptr.get() );
+    cata::hash_combine( seed, static_cast<int>( season_of_year( calendar::turn ) ) );
+    cata::hash_combine( seed, has_debug_vision );
+    cata::hash_combine( seed, overmap_transparency );
+    cata::hash_combine( seed, uistate.overmap_show_forest_trails );
+    return seed;
+}
+
+bool cata_tiles::update_om_chunk( overmap_chunk &chunk, const tripoint_abs_omt &origin,
+                                  const bool has_debug_vision )
+{
+    const size_t key = om_chunk_key( origin, has_debug_vision );
+    if( chunk.texture && chunk.key == key ) {
+        return true;
+    }
+    if( !chunk.texture ) {
+        chunk.texture = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                       om_chunk_size * tile_width, om_chunk_size * tile_height );
+        if( !chunk.texture ) {
+            return false;
+        }
+        SetTextureBlendMode( chunk.texture, SDL_BLENDMODE_BLEND );
+    }
+    chunk.key = key;
+
+    const auto render_state = sdl_save_render_state( renderer.get() );
+    SetRenderTarget( renderer, chunk.texture );
+    SetRenderDrawColor( renderer, 0, 0, 0, 0 );
+    RenderClear( renderer );
+    // Draw relative to the chunk
+    const point old_o = o;
+    const point old_op = op;
+    const int old_screentile_width = screentile_width;
+    const int old_screentile_height = screentile_height;
+    o = origin.raw().xy();
+    op = point_zero;
+    screentile_width = om_chunk_size;
+    screentile_height = om_chunk_size;
+
+    int height_3d = 0;
+    for( int y = 0; y < om_chunk_size; y++ ) {
+        for( int x = 0; x < om_chunk_size; x++ ) {
+            const tripoint_abs_omt omp = origin + point( x, y );
+            int rotation = 0;
+            int subtile = -1;
+            const std::string id = has_debug_vision || overmap_buffer.seen( omp ) ?
+                                   get_omt_id_rotation_and_subtile( omp, rotation, subtile ) : "unknown_terrain";
+            draw_om_terrain( omp, id, rotation, subtile, has_debug_vision, height_3d );
+        }
+    }
+
+    o = old_o;
+    op = old_op;
+    screentile_width = old_screentile_width;
+    screentile_height = old_screentile_height;
+    sdl_restore_render_state( renderer.get(), render_state );
+    return true;
+}
+
 bool cata_tiles::draw_sprite_at( const tile_type &tile, point p,
                                  unsigned int loc_rand, bool is_fg, int rota,
                                  std::optional<SDL_Color> color, lit_level ll,
@@ -432,6 +432,34 @@ class idle_animation_manager
  *     - The color of the block at 'point'.
  */
 using color_block_overlay_container = std::pair<SDL_BlendMode, std::multimap<point, SDL_Color>>;
+
+/**
+ * Render target holding the map layers drawn by the last @ref cata_tiles::draw call,
+ * along with hashes of what was drawn on each screen tile.
+ * The layers are only drawn again when the view or any of the tiles changed.
+ */
+struct terrain_view_cache {
+    SDL_Texture_Ptr texture;
+    point size;
+    /** Whether @ref texture holds a frame that may be reused. */
+    bool valid = false;
+    /** Hash of the view parameters and of state affecting every tile. */
+    size_t frame_hash = 0;
+    /** Hash of the draw inputs of each tile, in draw order. */
+    std::vector<size_t> tile_hashes;
+};
+
+/**
+ * Terrain of a square block of overmap tiles on one z-level, pre-rendered by
+ * @ref cata_tiles::draw_om so that panning the overmap mostly copies textures.
+ */
+struct overmap_chunk {
+    SDL_Texture_Ptr texture;
+    /** Hash of the overmap revisions and settings the texture was drawn with. */
+    size_t key = 0;
+    /** Overmap frame this chunk was last shown in. */
+    int last_used = 0;
+};
 using color_tint_pair = std::pair<std::optional<SDL_Color>, std::optional<SDL_Color>>;
 
 struct tile_render_info;
@@ -470,11 +498,23 @@ class cata_tiles
 
         void on_options_changed();
 
+        /** Forget the cached map layers, e.g. after the render targets were lost. */
+        void invalidate_view_cache() {
+            view_cache.valid = false;
+            om_chunks.clear();
+        }
+
         /** Draw to screen */
         void draw( point dest, const tripoint &center, int width, int height,
                    std::multimap<point, formatted_text> &overlay_strings,
                    color_block_overlay_container &color_blocks );
+        /** Whether @ref draw keeps the map layers in a render target, see @ref terrain_view_cache. */
+        bool cache_terrain_view = true;
         void draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bool blink );
+        /** Draw the overmap into a @p size pixels area, independent of the overmap font. */
+        void draw_om( point dest, point size, const tripoint_abs_omt &center_abs_omt, bool blink );
+        /** Whether @ref draw_om draws terrain from pre-rendered @ref overmap_chunk textures. */
+        bool cache_overmap_chunks = true;
 
         bool terrain_requires_animation() const;
 
@@ -962,6 +1002,34 @@ class cata_tiles
         // int represents spawn count
         std::map<tripoint, std::tuple<mtype_id, int, bool, Attitude>> monster_override;
         pimpl<std::vector<tile_render_info>> draw_points_cache;
+        terrain_view_cache view_cache;
+
+        /** Hash of the draw inputs of one tile, see @ref terrain_view_cache. */
+        size_t view_tile_hash( const tile_render_info &tile, int center_z ) const;
+        /** Hash of the draw inputs shared by all tiles, see @ref terrain_view_cache. */
+        size_t view_frame_hash( point dest, const tripoint &center, int width, int height ) const;
+        /** Whether the map layers of this frame may be kept for following frames. */
+        bool view_cacheable() const;
+
+        /** Size, in overmap tiles, of the blocks kept in @ref om_chunks. */
+        static constexpr int om_chunk_size = 32;
+        /** Pre-rendered overmap terrain, by north west corner of the block. */
+        std::unordered_map<tripoint_abs_omt, overmap_chunk> om_chunks;
+        /** Tile size the textures in @ref om_chunks were created for. */
+        point om_chunks_tile_size;
+        int om_frame = 0;
+
+        /** Hash of everything the terrain in the chunk at @p origin is drawn from. */
+        size_t om_chunk_key( const tripoint_abs_omt &origin, bool has_debug_vision ) const;
+        /** Redraws the chunk at @p origin if it is outdated, false if it has no texture. */
+        bool update_om_chunk( overmap_chunk &chunk, const tripoint_abs_omt &origin,
+                              bool has_debug_vision );
+        /**
+         * Draws the terrain of one overmap tile, the part of @ref draw_om kept in chunks.
+         * @param height_3d return parameter for height of the sprite
+         */
+        void draw_om_terrain( const tripoint_abs_omt &omp, const std::string &id, int rotation,
+                              int subtile, bool has_debug_vision, int &height_3d );
 
     private:
         /**
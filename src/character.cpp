@@ -38,6 +38,7 @@
 #include "coordinate_conversions.h"
 #include "coordinates.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "detached_ptr.h"
@@ -520,6 +521,7 @@ void Character::move_operator_common( Character &&source ) noexcept
 
     scent = source.scent ;
     my_bionics = std::move( source.my_bionics );
+    bionic_bits = std::move( source.bionic_bits );
     martial_arts_data = std::move( source.martial_arts_data );
 
     stomach = std::move( source.stomach );
@@ -559,11 +561,13 @@ void Character::move_operator_common( Character &&source ) noexcept
 
     known_traps = std::move( source.known_traps );
     encumbrance_cache = std::move( source.encumbrance_cache );
+    encumbrance_stale_inputs.set();
     my_mutations = std::move( source.my_mutations );
     last_sleep_check = source.last_sleep_check ;
     bio_soporific_powered_at_last_sleep_check = source.bio_soporific_powered_at_last_sleep_check ;
     my_traits = std::move( source.my_traits );
     cached_mutations = std::move( source.cached_mutations );
+    trait_bits = std::move( source.trait_bits );
     _skills = std::move( source._skills );
     autolearn_skills_stamp = std::move( source.autolearn_skills_stamp );
     learned_recipes = std::move( source.learned_recipes );
@@ -617,6 +621,9 @@ void Character::move_operator_common( Character &&source ) noexcept
 
 
     enchantment_cache = std::move( source.enchantment_cache );
+    trait_enchantment_cache = std::move( source.trait_enchantment_cache );
+    trait_enchantment_sources.clear();
+    trait_enchantment_stale_inputs.set();
 
     overmap_time = std::move( source.overmap_time );
 
@@ -2117,6 +2124,9 @@ bionic &Character::get_bionic_state( const bionic_id &id )
 
 bool Character::has_bionic( const bionic_id &b ) const
 {
+    if( !bionic_bits.test( b.id_or( int_id<bionic_data>( -1 ) ) ) ) {
+        return false;
+    }
     for( const bionic &i : get_bionic_collection() ) {
         if( i.id == b ) {
             return true;
@@ -4106,7 +4116,7 @@ void Character::practice( const skill_id &id, int amount, int cap, bool suppress
             g->events().send<event_type::gains_skill_level>( getID(), id, newLevel );
             // Athletics (swimming) skill modifies encumbrance, so make sure encumbrance is updated.
             // No harm updating it for any skill level-up in general.
-            reset_encumbrance();
+            invalidate_derived( char_input::skills );
         }
         if( is_player() && newLevel > oldLevel ) {
             add_msg( m_good, _( "Your skill in %s has increased to %d!" ), skill_name, newLevel );
@@ -4278,7 +4288,7 @@ void Character::do_skill_rust()
             add_msg_if_player( m_bad, _( "Your skill in %s has reduced to %d!" ), aSkill.name(), newSkill );
             // Athletics (swimming) skill modifies encumbrance, so make sure encumbrance is updated.
             // No harm updating it for any skill rust in general.
-            reset_encumbrance();
+            invalidate_derived( char_input::skills );
         }
     }
 }
@@ -4292,7 +4302,36 @@ void Character::reset()
 
 void Character::reset_encumbrance()
 {
+    invalidate_derived( char_input::worn );
+}
+
+derived_stat_counters &Character::get_derived_stat_counters()
+{
+    static derived_stat_counters counters;
+    return counters;
+}
+
+void Character::invalidate_derived( const char_input input )
+{
+    const size_t bit = static_cast<size_t>( input );
+    encumbrance_stale_inputs.set( bit );
+    if( input == char_input::mutations || input == char_input::bionics ) {
+        trait_enchantment_stale_inputs.set( bit );
+    }
+}
+
+const char_encumbrance_data &Character::updated_encumbrance() const
+{
+    derived_stat_counters &counters = get_derived_stat_counters();
+    if( encumbrance_stale_inputs.none() ) {
+        counters.encumbrance_reused++;
+        return *encumbrance_cache;
+    }
+    // Cleared first, so anything reading encumbrance while it's calculated sees the old values
+    encumbrance_stale_inputs.reset();
+    counters.encumbrance_computed++;
     *encumbrance_cache = calc_encumbrance();
+    return *encumbrance_cache;
 }
 
 char_encumbrance_data Character::calc_encumbrance() const
@@ -4346,7 +4385,7 @@ units::mass Character::get_weight() const
 
 char_encumbrance_data Character::get_encumbrance() const
 {
-    return *encumbrance_cache;
+    return updated_encumbrance();
 }
 
 char_encumbrance_data Character::get_encumbrance( const item &new_item ) const
@@ -4356,8 +4395,9 @@ char_encumbrance_data Character::get_encumbrance( const item &new_item ) const
 
 int Character::extra_encumbrance( layer_level level, const bodypart_str_id &bp ) const
 {
-    auto iter = encumbrance_cache->elems.find( bp );
-    if( iter != encumbrance_cache->elems.end() ) {
+    const char_encumbrance_data &enc = updated_encumbrance();
+    auto iter = enc.elems.find( bp );
+    if( iter != enc.elems.end() ) {
         return iter->second.layer_penalty_details[static_cast<int>( level )].total;
     }
 
@@ -4678,8 +4718,9 @@ void Character::item_encumb( char_encumbrance_data &vals, const item &new_item )
 
 int Character::encumb( const bodypart_str_id &bp ) const
 {
-    const auto iter = encumbrance_cache->elems.find( bp );
-    if( iter != encumbrance_cache->elems.end() ) {
+    const char_encumbrance_data &enc = updated_encumbrance();
+    const auto iter = enc.elems.find( bp );
+    if( iter != enc.elems.end() ) {
         // @todo Debugmsg?
         return iter->second.encumbrance;
     }
@@ -8668,15 +8709,38 @@ void Character::recalculate_enchantment_cache()
         return VisitResponse::NEXT;
     } );
 
+    // Items don't tell us when they change, but mutations and bionics do
+    update_trait_enchantments();
+    enchantment_cache->force_add( *trait_enchantment_cache );
+    enchantment_sources.insert( enchantment_sources.end(), trait_enchantment_sources.begin(),
+                                trait_enchantment_sources.end() );
+
+    rebuild_mutation_cache();
+}
+
+void Character::update_trait_enchantments()
+{
+    derived_stat_counters &counters = get_derived_stat_counters();
+    if( trait_enchantment_stale_inputs.none() && !trait_enchantments_conditional ) {
+        counters.trait_enchantments_reused++;
+        return;
+    }
+    trait_enchantment_stale_inputs.reset();
+    trait_enchantments_conditional = false;
+    counters.trait_enchantments_computed++;
+    *trait_enchantment_cache = enchantment();
+    trait_enchantment_sources.clear();
+
     // get from traits/ mutations
     for( const std::pair<const trait_id, char_trait_data> &mut_map : my_mutations ) {
         const mutation_branch &mut = mut_map.first.obj();
 
         for( const enchantment_id &ench_id : mut.enchantments ) {
             const enchantment &ench = ench_id.obj();
+            trait_enchantments_conditional |= !ench.is_unconditional();
             if( ench.is_active( *this, mut.activated && mut_map.second.powered ) ) {
-                enchantment_cache->force_add( ench );
-                enchantment_sources.emplace_back( &ench, &mut_map );
+                trait_enchantment_cache->force_add( ench );
+                trait_enchantment_sources.emplace_back( &ench, &mut_map );
             }
         }
     }
@@ -8686,19 +8750,19 @@ void Character::recalculate_enchantment_cache()
 
         for( const enchantment_id &ench_id : bid->enchantments ) {
             const enchantment &ench = ench_id.obj();
+            trait_enchantments_conditional |= !ench.is_unconditional();
             if( ench.is_active( *this, bio.powered &&
                                 bid->has_flag( STATIC( flag_id( "BIONIC_TOGGLED" ) ) ) ) ) {
-                enchantment_cache->force_add( ench );
-                enchantment_sources.emplace_back( &ench, &bio );
+                trait_enchantment_cache->force_add( ench );
+                trait_enchantment_sources.emplace_back( &ench, &bio );
             }
         }
     }
-
-    rebuild_mutation_cache();
 }
 
 void Character::rebuild_mutation_cache()
 {
+    const std::vector<const mutation_branch *> old_mutations = std::move( cached_mutations );
     cached_mutations.clear();
     for( const std::pair<const trait_id, char_trait_data> &mut : my_mutations ) {
         cached_mutations.push_back( &mut.first.obj() );
@@ -8706,6 +8770,14 @@ void Character::rebuild_mutation_cache()
     for( const trait_id &mut : enchantment_cache->get_mutations() ) {
         cached_mutations.push_back( &mut.obj() );
     }
+    trait_bits.clear();
+    for( const mutation_branch *mut : cached_mutations ) {
+        trait_bits.set( mut->id.id() );
+    }
+    // Mutations granted by enchantments change encumbrance too
+    if( cached_mutations != old_mutations ) {
+        encumbrance_stale_inputs.set( static_cast<size_t>( char_input::mutations ) );
+    }
 }
 
 double Character::bonus_from_enchantments( double base, enchant_vals::mod value,
@@ -11261,12 +11333,50 @@ bool Character::is_visible_in_range( const Creature &critter, const int range )
     return sees( critter ) && rl_dist( pos(), critter.pos() ) <= range;
 }
 
+void Character::setpos( const tripoint &p )
+{
+    position = p;
+    g->critter_tracker->note_changed();
+}
+
 std::vector<Creature *> Character::get_visible_creatures( const int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
-        return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
-        rl_dist( pos(), critter.pos() ) <= range && sees( critter );
-    } );
+    if( !is_avatar() ) {
+        return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+            return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
+            rl_dist( pos(), critter.pos() ) <= range && sees( critter );
+        } );
+    }
+
+    // The avatar's view only changes with the seen cache, the lightmap, creatures moving
+    // or the avatar acting, so all callers in between share one scan of the reality bubble.
+    visible_creatures_snapshot &snapshot = visible_creatures_cache;
+    const int64_t vision_revision = get_map().get_vision_revision();
+    const int64_t creatures_revision = g->critter_tracker->get_revision();
+    if( snapshot.vision_revision != vision_revision ||
+        snapshot.creatures_revision != creatures_revision ||
+        snapshot.turn != calendar::turn || snapshot.moves != moves ) {
+        snapshot.creatures = g->get_creatures_if( [this]( const Creature & critter ) -> bool {
+            return this != &critter && pos() != critter.pos() && sees( critter );
+        } );
+        snapshot.vision_revision = vision_revision;
+        snapshot.creatures_revision = creatures_revision;
+        snapshot.turn = calendar::turn;
+        snapshot.moves = moves;
+    }
+
+    std::vector<Creature *> result;
+    for( Creature *critter : snapshot.creatures ) {
+        const monster *mon = critter->as_monster();
+        const npc *guy = critter->as_npc();
+        if( ( mon != nullptr && mon->is_dead() ) || ( guy != nullptr && guy->is_dead() ) ) {
+            continue;
+        }
+        if( rl_dist( pos(), critter->pos() ) <= range ) {
+            result.push_back( critter );
+        }
+    }
+    return result;
 }
 
 std::vector<Creature *> Character::get_hostile_creatures( int range ) const
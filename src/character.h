@@ -33,6 +33,7 @@
 #include "mutation.h"
 #include "bionics.h"
 #include "game_constants.h"
+#include "int_id_bitset.h"
 #include "inventory.h"
 #include "item.h"
 #include "item_handling_util.h"
@@ -241,6 +242,27 @@ using mutation = std::pair<const trait_id, char_trait_data>;
 using enchantment_source =
     std::variant<std::monostate, const item *, const mutation *, const bionic *>;
 
+/**
+ * Inputs of character values that are only recomputed when one of their inputs changed,
+ * see @ref Character::invalidate_derived.
+ */
+enum class char_input : int {
+    worn = 0,
+    mutations,
+    bionics,
+    skills,
+    num_inputs
+};
+using char_input_set = std::bitset<static_cast<size_t>( char_input::num_inputs )>;
+
+/** How often lazily derived character values were recomputed or reused, summed over all characters. */
+struct derived_stat_counters {
+    int64_t encumbrance_computed = 0;
+    int64_t encumbrance_reused = 0;
+    int64_t trait_enchantments_computed = 0;
+    int64_t trait_enchantments_reused = 0;
+};
+
 struct mountable_status {
     bool mountable;
     bool skills;
@@ -540,8 +562,14 @@ class Character : public Creature, public location_visitable<Character>
 
         void environmental_revert_effect();
 
-        /** Recalculates encumbrance cache. */
+        /** Marks encumbrance for recalculation after worn items changed. */
         void reset_encumbrance();
+        /**
+         * Marks the values derived from @p input as outdated, they are recalculated
+         * the next time they are needed.
+         */
+        void invalidate_derived( char_input input );
+        static derived_stat_counters &get_derived_stat_counters();
         /** Returns ENC provided by armor, etc. */
         int encumb( const bodypart_str_id &bp ) const;
 
@@ -891,9 +919,7 @@ class Character : public Creature, public location_visitable<Character>
         void setz( int z ) {
             setpos( tripoint( position.xy(), z ) );
         }
-        void setpos( const tripoint &p ) override {
-            position = p;
-        }
+        void setpos( const tripoint &p ) override;
 
         /**
          * Global position, expressed in map square coordinate system
@@ -2323,7 +2349,10 @@ class Character : public Creature, public location_visitable<Character>
         creature_size size_class = creature_size::medium;
 
         trap_map known_traps;
-        pimpl<char_encumbrance_data> encumbrance_cache;
+        mutable pimpl<char_encumbrance_data> encumbrance_cache;
+        /** Inputs that changed since @ref encumbrance_cache was calculated. */
+        mutable char_input_set encumbrance_stale_inputs = char_input_set().set();
+        const char_encumbrance_data &updated_encumbrance() const;
     public:
         /**
          * Traits / mutations of the character. Key is the mutation id (it's also a valid
@@ -2343,6 +2372,16 @@ class Character : public Creature, public location_visitable<Character>
          * Pointers to mutation branches in @ref my_mutations.
          */
         std::vector<const mutation_branch *> cached_mutations;
+        /**
+         * Traits in @ref cached_mutations, so has_trait can reject absent traits without
+         * searching my_mutations and the enchantment mutations.
+         */
+        int_id_bitset<mutation_branch> trait_bits;
+        /**
+         * Bionics that were added to @ref my_bionics. May keep a bit set after
+         * its bionic was removed, has_bionic checks the collection when the bit is set.
+         */
+        int_id_bitset<bionic_data> bionic_bits;
 
         void store( JsonOut &json ) const;
         void load( const JsonObject &data );
@@ -2361,6 +2400,19 @@ class Character : public Creature, public location_visitable<Character>
         float nv_range = 0;
         int sight_max = 0;
 
+        /**
+         * Creatures the avatar sees anywhere in the reality bubble, shared by all callers
+         * of @ref get_visible_creatures until vision or creature positions change.
+         */
+        struct visible_creatures_snapshot {
+            int64_t vision_revision = -1;
+            int64_t creatures_revision = -1;
+            time_point turn = calendar::before_time_starts;
+            int moves = 0;
+            std::vector<Creature *> creatures;
+        };
+        mutable visible_creatures_snapshot visible_creatures_cache;
+
         // turn the character expired, if calendar::before_time_starts it has not been set yet.
         // TODO: change into an optional<time_point>
         time_point time_died = calendar::before_time_starts;
@@ -2463,6 +2515,14 @@ class Character : public Creature, public location_visitable<Character>
         pimpl<enchantment> enchantment_cache;
         // for enchantment mutations sprite display, recalculated alongside the cache
         std::vector<std::pair<const enchantment *, enchantment_source>> enchantment_sources;
+        // the part of the cache from mutations and bionics, kept while those don't change
+        pimpl<enchantment> trait_enchantment_cache;
+        std::vector<std::pair<const enchantment *, enchantment_source>> trait_enchantment_sources;
+        /** Inputs that changed since @ref trait_enchantment_cache was calculated. */
+        char_input_set trait_enchantment_stale_inputs = char_input_set().set();
+        /** Whether a trait enchantment depends on more than having the trait, e.g. time of day. */
+        bool trait_enchantments_conditional = true;
+        void update_trait_enchantments();
 
         /** Amount of time the player has spent in each overmap tile. */
         std::unordered_map<point_abs_omt, time_duration> overmap_time;
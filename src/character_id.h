@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <ostream>
 
 class JsonIn;
@@ -49,4 +50,12 @@ class character_id
         int value;
 };
 
-
+namespace std
+{
+template <>
+struct hash<character_id> {
+    std::size_t operator()( character_id id ) const noexcept {
+        return std::hash<int>()( id.get_value() );
+    }
+};
+} // namespace std
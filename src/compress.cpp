@@ -1,6 +1,11 @@
 #include "compress.h"
 
 #include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -50,4 +55,403 @@ void zlib_decompress( const void *compressed_data, int compressed_size, std::str
     } while( result == Z_BUF_ERROR );
 
     output.resize( decompressedSize );
-}
\ No newline at end of file
+}
+
+void zlib_compress( const std::string &input, const std::string &dictionary,
+                    std::vector<std::byte> &output )
+{
+    z_stream stream{};
+    if( deflateInit( &stream, Z_BEST_SPEED ) != Z_OK ) {
+        throw std::runtime_error( "Zlib compression error" );
+    }
+    if( deflateSetDictionary( &stream, reinterpret_cast<const Bytef *>( dictionary.data() ),
+                              dictionary.size() ) != Z_OK ) {
+        deflateEnd( &stream );
+        throw std::runtime_error( "Zlib compression error" );
+    }
+
+    output.resize( deflateBound( &stream, input.size() ) );
+    stream.next_in = reinterpret_cast<Bytef *>( const_cast<char *>( input.data() ) );
+    stream.avail_in = input.size();
+    stream.next_out = reinterpret_cast<Bytef *>( output.data() );
+    stream.avail_out = output.size();
+
+    const int result = deflate( &stream, Z_FINISH );
+    const uLong compressedSize = stream.total_out;
+    deflateEnd( &stream );
+    if( result != Z_STREAM_END ) {
+        throw std::runtime_error( "Zlib compression error" );
+    }
+
+    output.resize( compressedSize );
+}
+
+void zlib_decompress( const void *compressed_data, int compressed_size,
+                      const std::string &dictionary, std::string &output )
+{
+    z_stream stream{};
+    if( inflateInit( &stream ) != Z_OK ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+    stream.next_in = reinterpret_cast<Bytef *>( const_cast<void *>( compressed_data ) );
+    stream.avail_in = compressed_size;
+
+    // Same guess as above, the buffer grows as needed.
+    output.resize( static_cast<size_t>( compressed_size ) * 8 );
+    int result;
+    do {
+        if( stream.total_out == output.size() ) {
+            output.resize( std::max<size_t>( output.size() * 2, 1024 ) );
+        }
+        stream.next_out = reinterpret_cast<Bytef *>( output.data() + stream.total_out );
+        stream.avail_out = output.size() - stream.total_out;
+
+        result = inflate( &stream, Z_NO_FLUSH );
+        if( result == Z_NEED_DICT ) {
+            result = inflateSetDictionary( &stream, reinterpret_cast<const Bytef *>( dictionary.data() ),
+                                           dictionary.size() );
+        }
+    } while( result == Z_OK || ( result == Z_BUF_ERROR && stream.avail_out == 0 ) );
+
+    const uLong decompressedSize = stream.total_out;
+    inflateEnd( &stream );
+    if( result != Z_STREAM_END ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+
+    output.resize( decompressedSize );
+}
+
+namespace
+{
+
+// Length of the byte sequences the dictionary trainer counts.
+constexpr size_t dmer_size = 8;
+// Length of the sample segments the dictionary is assembled from.
+constexpr size_t segment_size = 256;
+
+struct dictionary_segment {
+    const std::string *sample;
+    size_t begin;
+    size_t end;
+};
+
+uint64_t dmer_at( const std::string &sample, size_t pos )
+{
+    uint64_t dmer;
+    std::memcpy( &dmer, sample.data() + pos, dmer_size );
+    return dmer;
+}
+
+} // namespace
+
+std::string train_compression_dictionary( const std::vector<std::string> &samples,
+        size_t max_size )
+{
+    std::unordered_map<uint64_t, uint32_t> frequencies;
+    std::vector<dictionary_segment> segments;
+    for( const std::string &sample : samples ) {
+        if( sample.size() < dmer_size ) {
+            continue;
+        }
+        for( size_t i = 0; i + dmer_size <= sample.size(); i++ ) {
+            frequencies[dmer_at( sample, i )]++;
+        }
+        for( size_t begin = 0; begin + dmer_size <= sample.size(); begin += segment_size ) {
+            segments.push_back( { &sample, begin, std::min( begin + segment_size, sample.size() ) } );
+        }
+    }
+
+    // A segment is worth the frequencies of the distinct sequences in it that are not
+    // covered by the dictionary yet. Sequences seen only once can't be matched again.
+    std::vector<uint64_t> dmers;
+    const auto score = [&]( const dictionary_segment & seg ) {
+        dmers.clear();
+        for( size_t i = seg.begin; i + dmer_size <= seg.end; i++ ) {
+            dmers.push_back( dmer_at( *seg.sample, i ) );
+        }
+        std::ranges::sort( dmers );
+        const auto [first, last] = std::ranges::unique( dmers );
+        dmers.erase( first, last );
+        uint64_t total = 0;
+        for( const uint64_t dmer : dmers ) {
+            const uint32_t freq = frequencies[dmer];
+            total += freq > 1 ? freq : 0;
+        }
+        return total;
+    };
+
+    // Scores only go down as the dictionary grows, so a stale score is an upper bound
+    // and segments only have to be rescored when they reach the top of the queue.
+    std::priority_queue<std::pair<uint64_t, size_t>> queue;
+    for( size_t i = 0; i < segments.size(); i++ ) {
+        queue.emplace( score( segments[i] ), i );
+    }
+    std::vector<size_t> picked;
+    size_t dictionary_size = 0;
+    while( !queue.empty() && dictionary_size < max_size ) {
+        const size_t index = queue.top().second;
+        queue.pop();
+        const dictionary_segment &seg = segments[index];
+        const uint64_t current = score( seg );
+        if( current == 0 ) {
+            continue;
+        }
+        if( !queue.empty() && current < queue.top().first ) {
+            queue.emplace( current, index );
+            continue;
+        }
+        if( dictionary_size + ( seg.end - seg.begin ) > max_size ) {
+            continue;
+        }
+        for( const uint64_t dmer : dmers ) {
+            frequencies[dmer] = 0;
+        }
+        picked.push_back( index );
+        dictionary_size += seg.end - seg.begin;
+    }
+
+    std::string dictionary;
+    dictionary.reserve( dictionary_size );
+    for( auto it = picked.rbegin(); it != picked.rend(); ++it ) {
+        const dictionary_segment &seg = segments[*it];
+        dictionary.append( *seg.sample, seg.begin, seg.end - seg.begin );
+    }
+    return dictionary;
+}
+
+namespace
+{
+
+void put_u32( std::byte *out, uint32_t value )
+{
+    for( int i = 0; i < 4; i++ ) {
+        out[i] = static_cast<std::byte>( ( value >> ( 8 * i ) ) & 0xFF );
+    }
+}
+
+uint32_t get_u32( const std::byte *in )
+{
+    uint32_t value = 0;
+    for( int i = 0; i < 4; i++ ) {
+        value |= static_cast<uint32_t>( in[i] ) << ( 8 * i );
+    }
+    return value;
+}
+
+} // namespace
+
+deflate_block_streambuf::deflate_block_streambuf( const std::string *dictionary,
+        std::string *prefix, size_t prefix_size )
+    : stream( std::make_unique<z_stream_s>() )
+    , dictionary( dictionary )
+    , prefix( prefix )
+    , prefix_size( prefix_size )
+    , block( block_size )
+{
+    if( deflateInit2( stream.get(), Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8,
+                      Z_DEFAULT_STRATEGY ) != Z_OK ) {
+        throw std::runtime_error( "Zlib compression error" );
+    }
+    if( dictionary != nullptr &&
+        deflateSetDictionary( stream.get(), reinterpret_cast<const Bytef *>( dictionary->data() ),
+                              dictionary->size() ) != Z_OK ) {
+        deflateEnd( stream.get() );
+        throw std::runtime_error( "Zlib compression error" );
+    }
+    setp( block.data(), block.data() + block.size() );
+}
+
+deflate_block_streambuf::~deflate_block_streambuf()
+{
+    deflateEnd( stream.get() );
+}
+
+deflate_block_streambuf::int_type deflate_block_streambuf::overflow( int_type ch )
+{
+    compress_block();
+    if( !traits_type::eq_int_type( ch, traits_type::eof() ) ) {
+        *pptr() = traits_type::to_char_type( ch );
+        pbump( 1 );
+    }
+    return traits_type::not_eof( ch );
+}
+
+std::byte *deflate_block_streambuf::output_space( size_t &available )
+{
+    if( chunks.empty() || chunk_fill == chunks.back().size() ) {
+        chunks.emplace_back( block_size );
+        chunk_fill = 0;
+    }
+    available = chunks.back().size() - chunk_fill;
+    return chunks.back().data() + chunk_fill;
+}
+
+void deflate_block_streambuf::compress_block()
+{
+    const size_t size = pptr() - pbase();
+    if( size == 0 ) {
+        return;
+    }
+    if( prefix != nullptr && prefix->size() < prefix_size ) {
+        prefix->append( pbase(), std::min( size, prefix_size - prefix->size() ) );
+    }
+
+    const uLong before = stream->total_out;
+    stream->next_in = reinterpret_cast<Bytef *>( pbase() );
+    stream->avail_in = size;
+    // A full flush ends the block on a byte boundary with no references to earlier data
+    do {
+        size_t available;
+        stream->next_out = reinterpret_cast<Bytef *>( output_space( available ) );
+        stream->avail_out = available;
+        if( deflate( stream.get(), Z_FULL_FLUSH ) == Z_STREAM_ERROR ) {
+            throw std::runtime_error( "Zlib compression error" );
+        }
+        chunk_fill += available - stream->avail_out;
+    } while( stream->avail_out == 0 );
+
+    index.emplace_back( static_cast<uint32_t>( stream->total_out - before ),
+                        static_cast<uint32_t>( size ) );
+    if( dictionary != nullptr ) {
+        deflateSetDictionary( stream.get(), reinterpret_cast<const Bytef *>( dictionary->data() ),
+                              dictionary->size() );
+    }
+    setp( block.data(), block.data() + block.size() );
+}
+
+void deflate_block_streambuf::finish()
+{
+    compress_block();
+    std::vector<std::byte> trailer( index.size() * 8 + 4 );
+    for( size_t i = 0; i < index.size(); i++ ) {
+        put_u32( trailer.data() + i * 8, index[i].first );
+        put_u32( trailer.data() + i * 8 + 4, index[i].second );
+    }
+    put_u32( trailer.data() + index.size() * 8, static_cast<uint32_t>( index.size() ) );
+
+    for( size_t written = 0; written < trailer.size(); ) {
+        size_t available;
+        std::byte *out = output_space( available );
+        const size_t n = std::min( available, trailer.size() - written );
+        std::memcpy( out, trailer.data() + written, n );
+        chunk_fill += n;
+        written += n;
+    }
+    chunks.back().resize( chunk_fill );
+    total_out = stream->total_out + trailer.size();
+}
+
+inflate_block_streambuf::inflate_block_streambuf( size_t compressed_size, read_fn read,
+        const std::string *dictionary )
+    : stream( std::make_unique<z_stream_s>() )
+    , read( std::move( read ) )
+    , dictionary( dictionary )
+{
+    if( inflateInit2( stream.get(), -MAX_WBITS ) != Z_OK ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+
+    std::byte count_bytes[4];
+    if( compressed_size < sizeof( count_bytes ) ) {
+        throw std::runtime_error( "Invalid deflate block index" );
+    }
+    this->read( compressed_size - 4, 4, count_bytes );
+    const size_t count = get_u32( count_bytes );
+    if( count > ( compressed_size - 4 ) / 8 ) {
+        throw std::runtime_error( "Invalid deflate block index" );
+    }
+    const size_t index_start = compressed_size - 4 - count * 8;
+    std::vector<std::byte> index( count * 8 );
+    this->read( index_start, index.size(), index.data() );
+
+    compressed_starts.reserve( count + 1 );
+    block_starts.reserve( count + 1 );
+    compressed_starts.push_back( 0 );
+    block_starts.push_back( 0 );
+    for( size_t i = 0; i < count; i++ ) {
+        compressed_starts.push_back( compressed_starts.back() + get_u32( index.data() + i * 8 ) );
+        block_starts.push_back( block_starts.back() + get_u32( index.data() + i * 8 + 4 ) );
+    }
+    if( compressed_starts.back() != index_start ) {
+        throw std::runtime_error( "Invalid deflate block index" );
+    }
+}
+
+inflate_block_streambuf::~inflate_block_streambuf()
+{
+    inflateEnd( stream.get() );
+}
+
+void inflate_block_streambuf::load_block( size_t i )
+{
+    const size_t compressed = compressed_starts[i + 1] - compressed_starts[i];
+    const size_t raw = block_starts[i + 1] - block_starts[i];
+    input.resize( compressed );
+    read( compressed_starts[i], compressed, input.data() );
+    block.resize( raw );
+
+    inflateReset( stream.get() );
+    if( dictionary != nullptr ) {
+        inflateSetDictionary( stream.get(), reinterpret_cast<const Bytef *>( dictionary->data() ),
+                              dictionary->size() );
+    }
+    stream->next_in = reinterpret_cast<Bytef *>( input.data() );
+    stream->avail_in = compressed;
+    stream->next_out = reinterpret_cast<Bytef *>( block.data() );
+    stream->avail_out = raw;
+    const int result = inflate( stream.get(), Z_SYNC_FLUSH );
+    if( ( result != Z_OK && result != Z_BUF_ERROR && result != Z_STREAM_END ) ||
+        stream->avail_out != 0 ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+
+    current = i;
+    loaded = true;
+    setg( block.data(), block.data(), block.data() + block.size() );
+}
+
+inflate_block_streambuf::int_type inflate_block_streambuf::underflow()
+{
+    if( gptr() < egptr() ) {
+        return traits_type::to_int_type( *gptr() );
+    }
+    const size_t next = loaded ? current + 1 : 0;
+    if( next + 1 >= block_starts.size() ) {
+        return traits_type::eof();
+    }
+    load_block( next );
+    return traits_type::to_int_type( *gptr() );
+}
+
+inflate_block_streambuf::pos_type inflate_block_streambuf::seekoff( off_type off,
+        std::ios_base::seekdir dir, std::ios_base::openmode which )
+{
+    off_type base = 0;
+    if( dir == std::ios_base::cur ) {
+        base = loaded ? block_starts[current] + ( gptr() - eback() ) : 0;
+    } else if( dir == std::ios_base::end ) {
+        base = size();
+    }
+    return seekpos( base + off, which );
+}
+
+inflate_block_streambuf::pos_type inflate_block_streambuf::seekpos( pos_type pos,
+        std::ios_base::openmode which )
+{
+    const off_type target = pos;
+    if( !( which & std::ios_base::in ) || target < 0 || static_cast<size_t>( target ) > size() ) {
+        return pos_type( off_type( -1 ) );
+    }
+    if( block_starts.size() < 2 ) {
+        return pos;
+    }
+    // The end of the data is the end of the last block
+    const auto after = std::ranges::upper_bound( block_starts, static_cast<size_t>( target ) );
+    const size_t i = std::min<size_t>( after - block_starts.begin() - 1, block_starts.size() - 2 );
+    if( !loaded || current != i ) {
+        load_block( i );
+    }
+    setg( eback(), eback() + ( target - block_starts[i] ), egptr() );
+    return pos;
+}
@@ -1,10 +1,129 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <streambuf>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "fstream_utils.h"
 
 void zlib_compress( const std::string &input, std::vector<std::byte> &output );
 void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output );
 
+/**
+ * Same as above, with a preset dictionary. Data that resembles the dictionary compresses
+ * better, in particular small inputs that would otherwise start with an empty window.
+ * The same dictionary must be given for decompression.
+ */
+void zlib_compress( const std::string &input, const std::string &dictionary,
+                    std::vector<std::byte> &output );
+void zlib_decompress( const void *compressed_data, int compressed_size,
+                      const std::string &dictionary, std::string &output );
 
+/** Largest dictionary zlib can make use of, the size of its window. */
+constexpr size_t zlib_max_dictionary_size = 32 * 1024;
+
+/**
+ * Builds a preset dictionary of at most max_size bytes from samples of the data it is
+ * meant for. Picks the segments of the samples that cover the most frequent 8 byte
+ * sequences, with the most valuable ones at the end, where zlib matches are cheapest.
+ */
+std::string train_compression_dictionary( const std::vector<std::string> &samples,
+        size_t max_size = zlib_max_dictionary_size );
+
+struct z_stream_s;
+
+/**
+ * Output stream buffer that compresses into independently decodable raw deflate blocks
+ * of @ref block_size uncompressed bytes, followed by an index of the block sizes.
+ * Each block starts from the dictionary, if there is one, so a reader can seek to any
+ * block. Only one block of input and the compressed output are held in memory.
+ */
+class deflate_block_streambuf : public std::streambuf
+{
+    public:
+        /**
+         * @param dictionary Preset dictionary for every block, or nullptr.
+         * @param prefix If given, receives up to prefix_size bytes from the start of the input.
+         */
+        explicit deflate_block_streambuf( const std::string *dictionary, std::string *prefix = nullptr,
+                                          size_t prefix_size = 0 );
+        ~deflate_block_streambuf() override;
+
+        /** Compresses the last block and appends the index. Call once, after all input. */
+        void finish();
+        /** Compressed output, in chunks of at most @ref block_size bytes. */
+        const std::vector<std::vector<std::byte>> &get_chunks() const {
+            return chunks;
+        }
+        size_t compressed_size() const {
+            return total_out;
+        }
+
+        static constexpr size_t block_size = 64 * 1024;
+
+    protected:
+        int_type overflow( int_type ch ) override;
+
+    private:
+        void compress_block();
+        // Free space in the last output chunk, which is added if needed
+        std::byte *output_space( size_t &available );
+
+        std::unique_ptr<z_stream_s> stream;
+        const std::string *dictionary;
+        std::string *prefix;
+        size_t prefix_size;
+        std::vector<char> block;
+        std::vector<std::vector<std::byte>> chunks;
+        size_t chunk_fill = 0;
+        // Compressed and uncompressed size of each block
+        std::vector<std::pair<uint32_t, uint32_t>> index;
+        size_t total_out = 0;
+};
+
+/**
+ * Input stream buffer over data written by @ref deflate_block_streambuf. Reads the
+ * compressed data through read_fn, one block at a time, and supports seeking.
+ */
+class inflate_block_streambuf : public std::streambuf
+{
+    public:
+        /** Reads size bytes at offset of the compressed data into out. */
+        using read_fn = std::function<void( size_t offset, size_t size, std::byte *out )>;
+
+        /** Throws std::runtime_error if the index is invalid. */
+        inflate_block_streambuf( size_t compressed_size, read_fn read,
+                                 const std::string *dictionary );
+        ~inflate_block_streambuf() override;
+
+        /** Uncompressed size of the data. */
+        size_t size() const {
+            return block_starts.back();
+        }
+
+    protected:
+        int_type underflow() override;
+        pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                          std::ios_base::openmode which ) override;
+        pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override;
+
+    private:
+        void load_block( size_t index );
+
+        std::unique_ptr<z_stream_s> stream;
+        read_fn read;
+        const std::string *dictionary;
+        // Offset of each block in the compressed and the uncompressed data, with the end
+        // of the data as the last element
+        std::vector<size_t> compressed_starts;
+        std::vector<size_t> block_starts;
+        size_t current = 0;
+        bool loaded = false;
+        std::vector<std::byte> input;
+        std::vector<char> block;
+};
@@ -134,6 +134,7 @@ Creature::Creature( const Creature &source )
     moves = source.moves;
     killer = source.killer;
     effects = source.effects;
+    effect_bits = source.effect_bits;
     values = source.values;
 
     num_blocks = source.num_blocks;
@@ -294,6 +295,14 @@ bool Creature::sees( const Creature &critter ) const
 
     map &here = get_map();
     const Character *ch = critter.as_character();
+    // Monsters hunting NPCs share the field of view cast from each NPC
+    const bool from_target = is_monster() && critter.is_npc();
+    const auto sees_pos = [&]( int range_mod ) {
+        if( from_target ) {
+            return sees_point( critter.pos(), false, range_mod, true );
+        }
+        return sees( critter.pos(), critter.is_avatar(), range_mod );
+    };
     const int wanted_range = rl_dist( pos(), critter.pos() );
     // Can always see adjacent monsters on the same level, unless they're through a vehicle wall.
     // We also bypass lighting for vertically adjacent monsters, but still check for floors.
@@ -315,7 +324,7 @@ bool Creature::sees( const Creature &critter ) const
         if( ch->movement_mode_is( CMM_CROUCH ) ) {
             const int coverage = here.obstacle_coverage( pos(), critter.pos() );
             if( coverage < 30 ) {
-                return sees( critter.pos(), critter.is_avatar() ) && visible( ch );
+                return sees_pos( 0 ) && visible( ch );
             }
             float size_modifier = 1.0;
             switch( ch->get_size() ) {
@@ -338,15 +347,21 @@ bool Creature::sees( const Creature &critter ) const
             }
             const int vision_modifier = 30 - 0.5 * coverage * size_modifier;
             if( vision_modifier > 1 ) {
-                return sees( critter.pos(), critter.is_avatar(), vision_modifier ) && visible( ch );
+                return sees_pos( vision_modifier ) && visible( ch );
             }
             return false;
         }
     }
-    return sees( critter.pos(), critter.is_avatar() ) && visible( ch );
+    return sees_pos( 0 ) && visible( ch );
 }
 
 bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
+{
+    return sees_point( t, is_avatar, range_mod, false );
+}
+
+bool Creature::sees_point( const tripoint &t, bool is_avatar, int range_mod,
+                           bool from_target ) const
 {
     if( !fov_3d && posz() != t.z ) {
         return false;
@@ -380,6 +395,8 @@ bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
             int adj_range = std::floor( range * player_visibility_factor );
             return adj_range >= wanted_range &&
                    here.get_cache_ref( pos().z ).seen_cache[pos().x][pos().y] > LIGHT_TRANSPARENCY_SOLID;
+        } else if( from_target ) {
+            return here.sees_target( pos(), t, range );
         } else {
             return here.sees( pos(), t, range );
         }
@@ -1387,6 +1404,7 @@ void Creature::add_effect( const efftype_id &eff_id, const time_duration &dur,
             e.set_intensity( e.get_max_intensity() );
         }
         ( *effects )[eff_id][bp] = e;
+        effect_bits.set( eff_id.id() );
         if( Character *ch = as_character() ) {
             g->events().send<event_type::character_gains_effect>( ch->getID(), eff_id );
             if( is_player() && !type.get_apply_message().empty() ) {
@@ -1481,6 +1499,10 @@ bool Creature::has_effect( const efftype_id &eff_id ) const
 }
 bool Creature::has_effect( const efftype_id &eff_id, const bodypart_str_id &bp ) const
 {
+    // Unknown ids get -1, which is never set
+    if( !effect_bits.test( eff_id.id_or( int_id<effect_type>( -1 ) ) ) ) {
+        return false;
+    }
     // null bp means anything, non-null means only that bp
     if( !bp ) {
         auto got = effects->find( eff_id );
@@ -1674,11 +1696,13 @@ void Creature::process_effects()
     for( const removed_effect &r : to_remove ) {
         if( !r.bp ) {
             effects->erase( r.type );
+            effect_bits.reset( r.type.id() );
         } else {
             ( *effects )[r.type].erase( r.bp );
             // If there are no more effects of a given type remove the type map
             if( ( *effects )[r.type].empty() ) {
                 effects->erase( r.type );
+                effect_bits.reset( r.type.id() );
             }
         }
     }
@@ -10,6 +10,7 @@
 
 #include "anatomy.h"
 #include "bodypart.h"
+#include "int_id_bitset.h"
 #include "pimpl.h"
 #include "string_formatter.h"
 #include "translations.h"
@@ -307,6 +308,11 @@ class Creature
         virtual bool sees( const Creature &critter ) const;
         virtual bool sees( const tripoint &t, bool is_avatar = false, int range_mod = 0 ) const;
         /*@}*/
+        /**
+         * Implements @ref sees for a point. With from_target, line of sight is looked up in the
+         * field of view cast from the target (@ref map::sees_target) instead of traced from here.
+         */
+        bool sees_point( const tripoint &t, bool is_avatar, int range_mod, bool from_target ) const;
 
         /**
          * How far the creature sees under the given light. Places outside this range can
@@ -953,6 +959,9 @@ class Creature
         virtual void process_one_effect( effect &e, bool is_new ) = 0;
 
         pimpl<effects_map> effects;
+        // Effect types that have an entry in effects, lets has_effect reject absent effects
+        // without a map lookup. May keep a bit set after its effect was removed.
+        int_id_bitset<effect_type> effect_bits;
         // Miscellaneous key/value pairs.
         std::unordered_map<std::string, std::string> values;
 
@@ -88,6 +88,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     monsters_list.emplace_back( critter_ptr );
     monsters_by_location[critter.pos()] = critter_ptr;
     add_to_faction_map( critter_ptr );
+    revision++;
     return true;
 }
 
@@ -140,6 +141,7 @@ size_t Creature_tracker::size() const
 
 bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_pos )
 {
+    revision++;
     if( critter.is_dead() ) {
         // find ignores dead critters anyway, changing their position in the
         // monsters_by_location map is useless.
@@ -220,6 +222,7 @@ void Creature_tracker::remove( const monster &critter )
         }
     }
     remove_from_location_map( critter );
+    revision++;
     removed_.push_back( *iter );
     monsters_list.erase( iter );
 }
@@ -230,10 +233,12 @@ void Creature_tracker::clear()
     monsters_by_location.clear();
     monster_faction_map_.clear();
     removed_.clear();
+    revision++;
 }
 
 void Creature_tracker::rebuild_cache()
 {
+    revision++;
     monsters_by_location.clear();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
@@ -266,6 +271,7 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
+    revision++;
     tripoint temp = second.pos();
     second.spawn( first.pos() );
     first.spawn( temp );
@@ -311,6 +317,7 @@ void Creature_tracker::remove_dead()
         if( critter.is_dead() ) {
             remove_from_location_map( critter );
             iter = monsters_list.erase( iter );
+            revision++;
         } else {
             ++iter;
         }
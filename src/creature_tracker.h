@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -84,6 +85,18 @@ class Creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Incremented whenever a creature in the reality bubble is added, removed or moved.
+         * Monsters are covered by the tracker itself, see @ref note_changed for the rest.
+         */
+        int64_t get_revision() const {
+            return revision;
+        }
+        /** Records that the avatar or an active npc moved, or an npc was loaded or unloaded. */
+        void note_changed() {
+            revision++;
+        }
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
@@ -94,6 +107,7 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        int64_t revision = 0;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
@@ -323,6 +323,7 @@ void grid_furn_transform_queue::apply( mapbuffer &mb, distribution_grid_tracker
         // TODO: this is copy-pasted from map.cpp
         if( old_t.active ) {
             sm->active_furniture.erase( p_within_sm );
+            sm->mark_dirty();
             // TODO: Only for g->m? Observer pattern?
             grid_tracker.on_changed( qt.p );
         }
@@ -10,6 +10,8 @@
 #include "color.h"
 #include "debug.h"
 #include "enums.h"
+#include "generic_factory.h"
+#include "int_id.h"
 #include "json.h"
 #include "messages.h"
 #include "output.h"
@@ -41,36 +43,65 @@ static const trait_id trait_VEGETARIAN( "VEGETARIAN" );
 
 namespace
 {
-std::map<efftype_id, effect_type> effect_types;
+generic_factory<effect_type> effect_types( "effect type" );
 } // namespace
 
+/** @relates int_id */
+template<>
+bool int_id<effect_type>::is_valid() const
+{
+    return effect_types.is_valid( *this );
+}
+
+/** @relates int_id */
+template<>
+const effect_type &int_id<effect_type>::obj() const
+{
+    return effect_types.obj( *this );
+}
+
+/** @relates int_id */
+template<>
+const string_id<effect_type> &int_id<effect_type>::id() const
+{
+    return effect_types.convert( *this );
+}
+
 /** @relates string_id */
 template<>
 const effect_type &string_id<effect_type>::obj() const
 {
-    const auto iter = effect_types.find( *this );
-    if( iter == effect_types.end() ) {
-        debugmsg( "invalid effect type id %s", c_str() );
-        static const effect_type dummy{};
-        return dummy;
-    }
-    return iter->second;
+    return effect_types.obj( *this );
 }
 
 /** @relates string_id */
 template<>
 bool string_id<effect_type>::is_valid() const
 {
-    return effect_types.contains( *this );
+    return effect_types.is_valid( *this );
+}
+
+/** @relates string_id */
+template<>
+int_id<effect_type> string_id<effect_type>::id() const
+{
+    return effect_types.convert( *this, int_id<effect_type>( -1 ) );
+}
+
+/** @relates string_id */
+template<>
+int_id<effect_type> string_id<effect_type>::id_or( const int_id<effect_type> &fallback ) const
+{
+    return effect_types.is_valid( *this ) ? effect_types.convert( *this, fallback ) : fallback;
 }
 
 std::vector<efftype_id> find_all_effect_types()
 {
     std::vector<efftype_id> all;
     all.reserve( effect_types.size() );
-    std::ranges::transform( effect_types, std::back_inserter( all ),
-    []( const std::pair<efftype_id, effect_type> &pr ) {
-        return pr.first;
+    std::ranges::transform( effect_types.get_all(), std::back_inserter( all ),
+    []( const effect_type & et ) {
+        return et.id;
     } );
     return all;
 }
@@ -559,8 +590,7 @@ bool effect_type::load_decay_msgs( const JsonObject &jo, const std::string &memb
 }
 void effect_type::check_consistency()
 {
-    for( const auto &pr : effect_types ) {
-        const effect_type &et = pr.second;
+    for( const effect_type &et : effect_types.get_all() ) {
         if( et.get_morale_type() && !et.get_morale_type().is_valid() ) {
             debugmsg( "Effect type %s has invalid morale type %s",
                       et.id.str(), et.get_morale_type().str() );
@@ -1433,7 +1463,7 @@ void load_effect_type( const JsonObject &jo )
         }
     }
 
-    effect_types[new_etype.id] = new_etype;
+    effect_types.insert( new_etype );
 }
 
 bool effect::has_flag( const flag_id &flag ) const
@@ -1443,7 +1473,7 @@ bool effect::has_flag( const flag_id &flag ) const
 
 void reset_effect_types()
 {
-    effect_types.clear();
+    effect_types.reset();
 }
 
 void effect_type::register_ma_buff_effect( const effect_type &eff )
@@ -1453,7 +1483,7 @@ void effect_type::register_ma_buff_effect( const effect_type &eff )
                   eff.id.c_str() );
         return;
     }
-    effect_types.insert( std::make_pair( eff.id, eff ) );
+    effect_types.insert( eff );
 }
 
 void effect::serialize( JsonOut &json ) const
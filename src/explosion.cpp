@@ -39,6 +39,7 @@
 #include "item_factory.h"
 #include "itype.h"
 #include "json.h"
+#include "lightmap.h"
 #include "line.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -304,6 +305,16 @@ class ExplosionEvent
             kind( kind ), target( std::move( target ) ), position( position ) {};
 };
 
+// Tiles on the z-level of an explosion that its center has an unobstructed view of
+struct explosion_fov {
+    float transparency[MAPSIZE_X][MAPSIZE_Y];
+    float seen[MAPSIZE_X][MAPSIZE_Y];
+};
+
+// Bumped whenever an explosion changes whether a tile is passable, which makes every
+//   explosion being processed cast its field of view again
+static int impassability_revision = 0;
+
 class ExplosionProcess
 {
     public:
@@ -339,11 +350,21 @@ class ExplosionProcess
         std::set<const Creature *> flung_set;
         std::vector<tripoint> recombination_targets;
 
+        std::unique_ptr<explosion_fov> fov;
+        int fov_revision = -1;
+        bool center_impassable = false;
+
         float cur_relative_time;
-        long long last_update_ms;
         bool request_redraw;
     public:
-        void run();
+        /**
+         * Resolves explosions that go off at the same time. Their events are processed
+         *   in one timeline and the affected tiles are cleaned up once at the end.
+         */
+        static void run( const std::vector<ExplosionProcess *> &processes );
+
+        /** Tiles within @p radius on the z-level of the center that the explosion can't reach. */
+        std::vector<tripoint> occluded_within( int radius );
 
         std::map<const Creature *, int> get_blasted() {
             return mobs_blasted;
@@ -367,10 +388,6 @@ class ExplosionProcess
             emitter( responsible ),
             player_flung( std::nullopt ),
             cur_relative_time( 0.0 ),
-            last_update_ms(
-                std::chrono::time_point_cast<std::chrono::milliseconds>
-                ( std::chrono::system_clock::now() ).time_since_epoch().count()
-            ),
             request_redraw( false ) {}
     private:
         static bool dist_comparator( dist_point_pair a, dist_point_pair b ) {
@@ -380,40 +397,24 @@ class ExplosionProcess
             return a.first < b.first;
         };
 
-        void update_timings() {
-            if( !is_animated() ) {
-                // Arbitrary large number since for null delays
-                //   we just want to scroll thru events as fast as possible
-                cur_relative_time += 1e6;
-                return;
-            }
-            const int animation_delay = get_option<int>( "ANIMATION_DELAY" );
-            const auto now = std::chrono::time_point_cast<std::chrono::milliseconds>
-                             ( std::chrono::system_clock::now() ).time_since_epoch().count();
-            const long long ms_diff = now - last_update_ms;
-            // Multiplied by 10x to calibrate it such that at 10 animation delay, an explosion
-            //   of radius 10 will take exactly 1 second to fully propagate
-            const float rel_diff = static_cast<float>( ms_diff ) / ( 10.0 * animation_delay );
-            cur_relative_time += rel_diff;
-            last_update_ms = now;
-        }
-
         void fill_maps();
         void init_event_queue();
+        void cast_fov();
         inline float generate_fling_angle( const tripoint from, const tripoint to );
-        inline bool is_occluded( const tripoint from, const tripoint to );
+        bool is_occluded( const tripoint &to );
+        bool is_occluded_by_line( const tripoint &to ) const;
         void add_event( const float delay, const ExplosionEvent &event ) {
             assert( delay >= 0 );
             event_queue.emplace( cur_relative_time + delay + std::numeric_limits<float>::epsilon(), event );
         }
-        auto is_animated() const -> bool {
+        static auto is_animated() -> bool {
             if( test_mode || get_option<int>( "ANIMATION_DELAY" ) <= 0 ) { return false; }
 
             const int skip_after = get_option<int>( "SKIP_EXPLOSION_ANIMATION_AFTER" );
             return skip_after == 0 || get_explosion_queue().get_count() <= skip_after;
         }
 
-        bool process_next();
+        void process_next_event();
         void blast_tile( const tripoint position, const int rl_distance );
         void project_shrapnel( const tripoint position );
         void add_field( const tripoint position, const field_type_id field,
@@ -461,7 +462,7 @@ void ExplosionProcess::fill_maps()
         }
 
         if( shrapnel && static_cast<int>( distance ) <= shrapnel_range && target.z == center.z &&
-            !is_occluded( center, target ) ) {
+            !is_occluded( target ) ) {
             shrapnel_map.emplace_back( distance, target );
         }
     }
@@ -493,19 +494,57 @@ void ExplosionProcess::init_event_queue()
         add_event( time_taken, ExplosionEvent::tile_blast( position, static_cast<int>( distance ) ) );
     }
 }
-inline bool ExplosionProcess::is_occluded( const tripoint from, const tripoint to )
+void ExplosionProcess::cast_fov()
 {
-    if( from == to ) {
+    map &here = get_map();
+    if( !fov ) {
+        fov = std::make_unique<explosion_fov>();
+    }
+    std::fill_n( &fov->transparency[0][0], MAPSIZE_X * MAPSIZE_Y, LIGHT_TRANSPARENCY_SOLID );
+    std::fill_n( &fov->seen[0][0], MAPSIZE_X * MAPSIZE_Y, LIGHT_TRANSPARENCY_SOLID );
+
+    const int shrapnel_range = shrapnel.has_value() ? shrapnel.value().range : 0;
+    const int aoe_radius = std::max( blast_radius, shrapnel_range );
+    for( const tripoint &p : here.points_in_radius( center, aoe_radius ) ) {
+        fov->transparency[p.x][p.y] = here.impassable( p ) ? LIGHT_TRANSPARENCY_SOLID :
+                                      LIGHT_TRANSPARENCY_OPEN_AIR;
+    }
+    center_impassable = here.impassable( center );
+
+    // Impassable tiles are reached, but nothing behind them is. An obstacle shadows
+    //   everything it covers from the center, not just the tiles on straight lines.
+    // Shadowcasting skips the origin, so the center is added manually.
+    fov->seen[center.x][center.y] = VISIBILITY_FULL;
+    castLightAllWithLookup<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
+    ( fov->seen, fov->transparency, here.access_cache( center.z ).vehicle_obstructed_cache,
+      center.xy(), 0 );
+    fov_revision = impassability_revision;
+}
+
+bool ExplosionProcess::is_occluded( const tripoint &to )
+{
+    if( to == center ) {
         return false;
     }
+    // Blasts reaching other z-levels, or from or to outside the map, check the straight line
+    if( to.z != center.z || !get_map().inbounds( center ) || !get_map().inbounds( to ) ) {
+        return is_occluded_by_line( to );
+    }
+    if( fov_revision != impassability_revision ) {
+        cast_fov();
+    }
+    return center_impassable || fov->seen[to.x][to.y] <= LIGHT_TRANSPARENCY_SOLID;
+}
 
+bool ExplosionProcess::is_occluded_by_line( const tripoint &to ) const
+{
     map &here = get_map();
-    tripoint last_position = from;
+    tripoint last_position = center;
 
-    std::vector<tripoint> line_of_movement = line_to( from, to );
+    std::vector<tripoint> line_of_movement = line_to( center, to );
     // Annoyingly, line_to does not include the origin point
     //   so it has to be added manually
-    line_of_movement.insert( line_of_movement.begin(), from );
+    line_of_movement.insert( line_of_movement.begin(), center );
     for( const auto &position : line_of_movement ) {
         // position != to necessary because we do want to strike the
         //   target obstacle
@@ -522,6 +561,17 @@ inline bool ExplosionProcess::is_occluded( const tripoint from, const tripoint t
     return false;
 }
 
+std::vector<tripoint> ExplosionProcess::occluded_within( int radius )
+{
+    std::vector<tripoint> ret;
+    for( const tripoint &p : get_map().points_in_radius( center, radius ) ) {
+        if( is_occluded( p ) ) {
+            ret.push_back( p );
+        }
+    }
+    return ret;
+}
+
 inline float ExplosionProcess::generate_fling_angle( const tripoint from, const tripoint to )
 {
     if( from != to ) {
@@ -537,62 +587,37 @@ inline float ExplosionProcess::generate_fling_angle( const tripoint from, const
     }
 }
 
-bool ExplosionProcess::process_next()
+void ExplosionProcess::process_next_event()
 {
-    if( event_queue.empty() ) {
-        return false;
-    }
-
-    // We don't need to wait in testing mode or if there is no animation delay
-    if( is_animated() ) {
-        const float next_event_time = event_queue.top().first;
-        const double relative_time_step = static_cast<double>( next_event_time - cur_relative_time );
-        const double animation_delay = static_cast<double>( get_option<int>( "ANIMATION_DELAY" ) );
-
-        // We balance the timing in such a way
-        //   that, at 10 ANIMATION_DELAY, it will take an explosion of radius 10
-        //   exactly 1 second to propagate fully
-        // NOLINTNEXTLINE(cata-no-long)
-        const long int delay_ms = static_cast<long int>( relative_time_step * 10.0 * animation_delay );
-        if( delay_ms > 0 ) {
-            const timespec delay = timespec {0, delay_ms * 1000000L};
-            nanosleep( &delay, nullptr );
-        }
-    }
-    update_timings();
-
-    while( !event_queue.empty() && cur_relative_time >= event_queue.top().first ) {
-        const auto &event = event_queue.top().second;
-
-        switch( event.kind ) {
-            case ExplosionEvent::Kind::SHRAPNEL:
-                project_shrapnel( event.position );
-                break;
-            case ExplosionEvent::Kind::BLAST:
-                blast_tile( event.position, std::get<int>( event.target ) );
-                break;
-            case ExplosionEvent::Kind::FIELD_ADDITION: {
-                const auto &[field, intensity,
-                                    hit_player] = std::get<ExplosionEvent::FieldToAdd>( event.target );
-                add_field( event.position, field, intensity, hit_player );
-                break;
-            }
-            case ExplosionEvent::Kind::FIELD_REMOVAL:
-                remove_field( event.position, std::get<field_type_id>( event.target ) );
-                break;
-            case ExplosionEvent::Kind::ITEM_MOVEMENT:
-            case ExplosionEvent::Kind::MOB_MOVEMENT:
-                move_entity(
-                    event.position,
-                    std::get<ExplosionEvent::PropelledEntity>( event.target ),
-                    event.kind == ExplosionEvent::Kind::MOB_MOVEMENT
-                );
-                break;
-        };
-        event_queue.pop();
+    // Copied, handling the event may schedule new ones
+    const ExplosionEvent event = event_queue.top().second;
+    event_queue.pop();
+
+    switch( event.kind ) {
+        case ExplosionEvent::Kind::SHRAPNEL:
+            project_shrapnel( event.position );
+            break;
+        case ExplosionEvent::Kind::BLAST:
+            blast_tile( event.position, std::get<int>( event.target ) );
+            break;
+        case ExplosionEvent::Kind::FIELD_ADDITION: {
+            const auto &[field, intensity,
+                                hit_player] = std::get<ExplosionEvent::FieldToAdd>( event.target );
+            add_field( event.position, field, intensity, hit_player );
+            break;
+        }
+        case ExplosionEvent::Kind::FIELD_REMOVAL:
+            remove_field( event.position, std::get<field_type_id>( event.target ) );
+            break;
+        case ExplosionEvent::Kind::ITEM_MOVEMENT:
+        case ExplosionEvent::Kind::MOB_MOVEMENT:
+            move_entity(
+                event.position,
+                std::get<ExplosionEvent::PropelledEntity>( event.target ),
+                event.kind == ExplosionEvent::Kind::MOB_MOVEMENT
+            );
+            break;
     }
-
-    return true;
 }
 
 void ExplosionProcess::project_shrapnel( const tripoint position )
@@ -601,7 +626,7 @@ void ExplosionProcess::project_shrapnel( const tripoint position )
 
     assert( shrapnel );
 
-    if( is_occluded( center, position ) ) {
+    if( is_occluded( position ) ) {
         return;
     }
 
@@ -645,6 +670,9 @@ void ExplosionProcess::project_shrapnel( const tripoint position )
             // Terrain should be affected by shrapnel less
             here.bash( position, damage, true );
         }
+        if( !here.impassable( position ) ) {
+            impassability_revision++;
+        }
     }
 
     if( is_animated() ) {
@@ -659,7 +687,7 @@ void ExplosionProcess::blast_tile( const tripoint position, const int rl_distanc
 {
     assert( blast_radius > 0 );
     // Verify we have view of the center
-    if( is_occluded( center, position ) ) {
+    if( is_occluded( position ) ) {
         return;
     }
 
@@ -775,6 +803,7 @@ void ExplosionProcess::blast_tile( const tripoint position, const int rl_distanc
             const float blast_force_decay = ( ExplosionConstants::VEHICLE_DAMAGE_MULT - 1.0 ) *
                                             blast_power / ExplosionConstants::MULTIBASH_COUNT;
             assert( blast_force_decay > 0 );
+            const bool was_impassable = here.impassable( position );
             while( terrain_blast_force > 0 ) {
                 bash_params bash{
                     static_cast<int>( terrain_blast_force ),
@@ -792,6 +821,9 @@ void ExplosionProcess::blast_tile( const tripoint position, const int rl_distanc
                 here.bash_ter_furn( position, bash );
                 terrain_blast_force -= blast_force_decay;
             }
+            if( here.impassable( position ) != was_impassable ) {
+                impassability_revision++;
+            }
         }
 
         {
@@ -988,42 +1020,118 @@ void ExplosionProcess::move_entity( const tripoint position,
     }
 }
 
-void ExplosionProcess::run()
+void ExplosionProcess::run( const std::vector<ExplosionProcess *> &processes )
 {
-    fill_maps();
-    init_event_queue();
+    for( ExplosionProcess *process : processes ) {
+        process->fill_maps();
+        process->init_event_queue();
+    }
 
     // We need to temporary disable it because
     //   larger explosions may end up filling
     //   the texture pool, causing a crash
-    bool disable_minimap = is_animated() && pixel_minimap_option;
+    const bool animated = is_animated();
+    bool disable_minimap = animated && pixel_minimap_option;
     if( disable_minimap ) {
         g->toggle_pixel_minimap();
     }
 
-    map &here = get_map();
-    while( process_next() ) {
+    const auto now_ms = []() {
+        return std::chrono::time_point_cast<std::chrono::milliseconds>
+               ( std::chrono::system_clock::now() ).time_since_epoch().count();
+    };
+    // All explosions share one clock, they went off at the same time
+    float shared_time = 0.0f;
+    long long last_update = now_ms();
+    const auto update_timings = [&]() {
+        if( !animated ) {
+            // Arbitrary large number since for null delays
+            //   we just want to scroll thru events as fast as possible
+            shared_time += 1e6;
+            return;
+        }
+        const int animation_delay = get_option<int>( "ANIMATION_DELAY" );
+        const long long now = now_ms();
+        const long long ms_diff = now - last_update;
+        // Multiplied by 10x to calibrate it such that at 10 animation delay, an explosion
+        //   of radius 10 will take exactly 1 second to fully propagate
+        const float rel_diff = static_cast<float>( ms_diff ) / ( 10.0 * animation_delay );
+        shared_time += rel_diff;
+        last_update = now;
+    };
+    // The explosion with the earliest event due by max_time
+    const auto next_due = [&]( float max_time ) -> ExplosionProcess * {
+        ExplosionProcess *next = nullptr;
+        for( ExplosionProcess *process : processes ) {
+            if( !process->event_queue.empty() && process->event_queue.top().first <= max_time &&
+                ( next == nullptr || process->event_queue.top().first < next->event_queue.top().first ) ) {
+                next = process;
+            }
+        }
+        return next;
+    };
+
+    while( ExplosionProcess *next = next_due( std::numeric_limits<float>::max() ) ) {
+        // We don't need to wait in testing mode or if there is no animation delay
+        if( animated ) {
+            const float next_event_time = next->event_queue.top().first;
+            const double relative_time_step = static_cast<double>( next_event_time - shared_time );
+            const double animation_delay = static_cast<double>( get_option<int>( "ANIMATION_DELAY" ) );
+
+            // We balance the timing in such a way
+            //   that, at 10 ANIMATION_DELAY, it will take an explosion of radius 10
+            //   exactly 1 second to propagate fully
+            // NOLINTNEXTLINE(cata-no-long)
+            const long int delay_ms = static_cast<long int>( relative_time_step * 10.0 * animation_delay );
+            if( delay_ms > 0 ) {
+                const timespec delay = timespec {0, delay_ms * 1000000L};
+                nanosleep( &delay, nullptr );
+            }
+        }
+        update_timings();
+
+        // Events of all explosions are resolved in the order they happen
+        bool redraw = false;
+        while( ExplosionProcess *process = next_due( shared_time ) ) {
+            process->cur_relative_time = shared_time;
+            process->process_next_event();
+            redraw |= process->request_redraw;
+            process->request_redraw = false;
+        }
+
         // No need to redraw in testing mode
-        if( request_redraw && is_animated() ) {
+        if( redraw && animated ) {
             ui_manager::redraw();
             refresh_display();
-            request_redraw = false;
         }
         update_timings();
-    };
+    }
 
     // Reenable disabled options
     if( disable_minimap ) {
         g->toggle_pixel_minimap();
     }
 
+    // Items were only flagged, split or moved on the tiles that get recombined
+    std::vector<tripoint> affected_tiles;
+    std::optional<player *> player_flung;
+    for( ExplosionProcess *process : processes ) {
+        affected_tiles.insert( affected_tiles.end(), process->recombination_targets.begin(),
+                               process->recombination_targets.end() );
+        if( process->player_flung.has_value() ) {
+            player_flung = process->player_flung;
+        }
+    }
+    std::sort( affected_tiles.begin(), affected_tiles.end() );
+    auto end = std::unique( affected_tiles.begin(), affected_tiles.end() );
+    affected_tiles.erase( end, affected_tiles.end() );
+
     // Remove temporary flags
-    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
-        for( const auto &pos : here.points_on_zlevel( z ) ) {
-            for( auto &it : here.i_at( pos ) ) {
-                it->unset_flag( flag_EXPLOSION_SMASHED );
-                it->unset_flag( flag_EXPLOSION_PROPELLED );
-            }
+    map &here = get_map();
+    for( const tripoint &pos : affected_tiles ) {
+        for( auto &it : here.i_at( pos ) ) {
+            it->unset_flag( flag_EXPLOSION_SMASHED );
+            it->unset_flag( flag_EXPLOSION_PROPELLED );
         }
     }
 
@@ -1033,11 +1141,7 @@ void ExplosionProcess::run()
     }
 
     // Finally, recombine thrown items into full stacks again
-    std::sort( recombination_targets.begin(), recombination_targets.end() );
-    auto end = std::unique( recombination_targets.begin(), recombination_targets.end() );
-    recombination_targets.erase( end, recombination_targets.end() );
-
-    for( const auto &position : recombination_targets ) {
+    for( const tripoint &position : affected_tiles ) {
         for( detached_ptr<item> &it : here.i_clear( position ) ) {
             here.add_item_or_charges( position, std::move( it ) );
         }
@@ -1427,7 +1531,7 @@ static std::map<const Creature *, int> legacy_blast( const tripoint &p, const fl
     return blasted;
 }
 
-void explosion_funcs::regular( const queued_explosion &qe )
+static void announce_explosion( const queued_explosion &qe )
 {
     const tripoint &p = qe.pos;
     const explosion_data &ex = qe.exp_data;
@@ -1455,22 +1559,11 @@ void explosion_funcs::regular( const queued_explosion &qe )
     } else if( noise > 0 ) {
         sounds::sound( p, 3, sounds::sound_t::combat, _( "a loud pop!" ), false, "explosion", "small" );
     }
+}
 
-    std::map<const Creature *, int> damaged_by_blast;
-    std::map<const Creature *, int> damaged_by_shrapnel;
-
-    if( get_option<bool>( "OLD_EXPLOSIONS" ) ) {
-        if( shr ) {
-            damaged_by_shrapnel = legacy_shrapnel( p, shr.value(), qe.source );
-        }
-        damaged_by_blast = legacy_blast( p, ex.damage, ex.radius, ex.fire, qe.source );
-    } else {
-        ExplosionProcess process( p, ex.damage, ex.radius, shr, ex.fire, std::make_optional( qe.source ) );
-        process.run();
-        damaged_by_blast = process.get_blasted();
-        damaged_by_shrapnel = process.get_shrapneled();
-    }
-
+static void report_explosion_damage( const std::map<const Creature *, int> &damaged_by_blast,
+                                     const std::map<const Creature *, int> &damaged_by_shrapnel )
+{
     // Not the cleanest way to do it
     std::map<const Creature *, int> total_damaged;
     for( const auto &pr : damaged_by_blast ) {
@@ -1525,6 +1618,45 @@ void explosion_funcs::regular( const queued_explosion &qe )
     }
 }
 
+void explosion_funcs::regular( const queued_explosion &qe )
+{
+    regular( std::vector<queued_explosion> { qe } );
+}
+
+void explosion_funcs::regular( const std::vector<queued_explosion> &simultaneous )
+{
+    for( const queued_explosion &qe : simultaneous ) {
+        announce_explosion( qe );
+    }
+
+    if( get_option<bool>( "OLD_EXPLOSIONS" ) ) {
+        for( const queued_explosion &qe : simultaneous ) {
+            const explosion_data &ex = qe.exp_data;
+            std::map<const Creature *, int> damaged_by_shrapnel;
+            if( ex.fragment ) {
+                damaged_by_shrapnel = legacy_shrapnel( qe.pos, ex.fragment.value(), qe.source );
+            }
+            const std::map<const Creature *, int> damaged_by_blast = legacy_blast( qe.pos, ex.damage,
+                    ex.radius, ex.fire, qe.source );
+            report_explosion_damage( damaged_by_blast, damaged_by_shrapnel );
+        }
+        return;
+    }
+
+    std::vector<std::unique_ptr<ExplosionProcess>> processes;
+    std::vector<ExplosionProcess *> process_ptrs;
+    for( const queued_explosion &qe : simultaneous ) {
+        const explosion_data &ex = qe.exp_data;
+        processes.push_back( std::make_unique<ExplosionProcess>( qe.pos, ex.damage, ex.radius,
+                             ex.fragment, ex.fire, std::make_optional( qe.source ) ) );
+        process_ptrs.push_back( processes.back().get() );
+    }
+    ExplosionProcess::run( process_ptrs );
+    for( const std::unique_ptr<ExplosionProcess> &process : processes ) {
+        report_explosion_damage( process->get_blasted(), process->get_shrapneled() );
+    }
+}
+
 void flashbang( const tripoint &p, bool player_immune, const std::string &exp_name )
 {
     // flashbangs cannot kill, so skip the source
@@ -1903,32 +2035,62 @@ explosion_queue &get_explosion_queue()
 void explosion_queue::execute()
 {
     explosion_count = 0;
+    std::vector<queued_explosion> simultaneous;
     while( !elems.empty() ) {
-        queued_explosion exp = std::move( elems.front() );
-        elems.pop_front();
-        explosion_count++;
-        switch( exp.type ) {
-            case ExplosionType::Regular:
-                explosion_funcs::regular( exp );
-                break;
-            case ExplosionType::Flashbang:
-                explosion_funcs::flashbang( exp );
-                break;
-            case ExplosionType::ResonanceCascade:
-                explosion_funcs::resonance_cascade( exp );
-                break;
-            case ExplosionType::Shockwave:
-                explosion_funcs::shockwave( exp );
-                break;
-            default:
-                debugmsg( "Explosion type not implemented." );
-                break;
+        std::deque<queued_explosion> wave;
+        wave.swap( elems );
+        explosion_count += static_cast<int>( wave.size() );
+        for( queued_explosion &exp : wave ) {
+            if( exp.type == ExplosionType::Regular ) {
+                simultaneous.push_back( std::move( exp ) );
+                continue;
+            }
+            // Keep the order of regular explosions relative to the others
+            if( !simultaneous.empty() ) {
+                explosion_funcs::regular( simultaneous );
+                simultaneous.clear();
+            }
+            execute_one( exp );
         }
+        if( !simultaneous.empty() ) {
+            explosion_funcs::regular( simultaneous );
+            simultaneous.clear();
+        }
+    }
+}
+
+void explosion_queue::execute_one( const queued_explosion &exp )
+{
+    switch( exp.type ) {
+        case ExplosionType::Regular:
+            explosion_funcs::regular( exp );
+            break;
+        case ExplosionType::Flashbang:
+            explosion_funcs::flashbang( exp );
+            break;
+        case ExplosionType::ResonanceCascade:
+            explosion_funcs::resonance_cascade( exp );
+            break;
+        case ExplosionType::Shockwave:
+            explosion_funcs::shockwave( exp );
+            break;
+        default:
+            debugmsg( "Explosion type not implemented." );
+            break;
     }
 }
 
 } // namespace explosion_handler
 
+namespace explosion_detail
+{
+std::vector<tripoint> occluded_points( const tripoint &center, int radius )
+{
+    explosion_handler::ExplosionProcess process( center, 0, radius );
+    return process.occluded_within( radius );
+}
+} // namespace explosion_detail
+
 float shrapnel_calc( const float &intensity, const float &last_obstacle, const int & )
 {
     return intensity - last_obstacle;
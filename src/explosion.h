@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "projectile.h"
 
@@ -62,6 +63,12 @@ projectile shrapnel_from_legacy( int power, float blast_radius );
 float blast_radius_from_legacy( int power, float distance_factor );
 } // namespace explosion_handler
 
+namespace explosion_detail
+{
+/** Tiles within radius of center, on its z-level, that a blast from center can't reach. For tests. */
+std::vector<tripoint> occluded_points( const tripoint &center, int radius );
+} // namespace explosion_detail
+
 explosion_data load_explosion_data( const JsonObject &jo );
 
 
@@ -5,6 +5,7 @@
 
 #include <string>
 #include <deque>
+#include <vector>
 
 namespace explosion_handler
 {
@@ -41,6 +42,8 @@ namespace explosion_funcs
 {
 
 void regular( const queued_explosion &qe );
+/** Resolves regular explosions that go off at the same time in one pass. */
+void regular( const std::vector<queued_explosion> &simultaneous );
 void flashbang( const queued_explosion &qe );
 void resonance_cascade( const queued_explosion &qe );
 void shockwave( const queued_explosion &qe );
@@ -53,11 +56,17 @@ class explosion_queue
         std::deque<queued_explosion> elems;
         int explosion_count = 0;
 
+        static void execute_one( const queued_explosion &exp );
+
     public:
         void add( queued_explosion &&exp ) {
             elems.push_back( std::move( exp ) );
         }
 
+        /**
+         * Sets off the queued explosions. Everything queued at that point goes off at once,
+         * explosions they set off are queued behind them and go off together afterwards.
+         */
         void execute();
 
         void clear() { elems.clear(); }
@@ -280,6 +280,17 @@ static const trap_str_id tr_unfinished_construction( "tr_unfinished_construction
 
 static const faction_id your_followers( "your_followers" );
 
+static const option_handle<bool> option_AUTOSAFEMODE( "AUTOSAFEMODE" );
+static const option_handle<int> option_AUTOSAFEMODETURNS( "AUTOSAFEMODETURNS" );
+static const option_handle<bool> option_AUTOSAVE( "AUTOSAVE" );
+static const option_handle<int> option_AUTOSAVE_TURNS( "AUTOSAVE_TURNS" );
+static const option_handle<bool> option_FORCE_REDRAW( "FORCE_REDRAW" );
+static const option_handle<int> option_SAFEMODEIGNORETURNS( "SAFEMODEIGNORETURNS" );
+static const option_handle<int> option_SAFEMODEPROXIMITY( "SAFEMODEPROXIMITY" );
+static const option_handle<bool> option_SLEEP_SKIP_MON( "SLEEP_SKIP_MON" );
+static const option_handle<bool> option_SLEEP_SKIP_SOUND( "SLEEP_SKIP_SOUND" );
+static const option_handle<bool> option_SLEEP_SKIP_VEH( "SLEEP_SKIP_VEH" );
+
 #if defined(__ANDROID__)
 extern std::map<std::string, std::list<input_event>> quick_shortcuts_map;
 extern bool add_best_key_for_action_to_quick_shortcuts( action_id action,
@@ -525,6 +536,7 @@ void game::setup( bool load_world_modfiles )
 
     get_weather().weather_id = weather_type_id::NULL_ID();
     get_weather().nextweather = calendar::before_time_starts;
+    get_weather().clear_weather_noise();
 
     turnssincelastmon = 0; //Auto safe mode init
 
@@ -532,6 +544,7 @@ void game::setup( bool load_world_modfiles )
     clear_zombies();
     coming_to_stairs.clear();
     active_npc.clear();
+    critter_tracker->note_changed();
     faction_manager_ptr->clear();
     mission::clear_all();
     Messages::clear_messages();
@@ -989,6 +1002,7 @@ void game::load_npcs()
         npc->on_load();
     }
 
+    critter_tracker->note_changed();
     npcs_dirty = false;
 }
 
@@ -999,6 +1013,7 @@ void game::unload_npcs()
     }
 
     active_npc.clear();
+    critter_tracker->note_changed();
 }
 
 void game::reload_npcs()
@@ -1493,9 +1508,9 @@ bool game::do_turn()
     }
     const bool asleep = u.in_sleep_state();
     const auto vehperf = asleep && !character_funcs::is_driving( u ) &&
-                         get_option<bool>( "SLEEP_SKIP_VEH" );
-    const auto soundperf = asleep && get_option<bool>( "SLEEP_SKIP_SOUND" );
-    const auto monperf = asleep && get_option<bool>( "SLEEP_SKIP_MON" );
+                         option_SLEEP_SKIP_VEH.get();
+    const auto soundperf = asleep && option_SLEEP_SKIP_SOUND.get();
+    const auto monperf = asleep && option_SLEEP_SKIP_MON.get();
     // Actual stuff
     if( new_game ) {
         new_game = false;
@@ -1542,8 +1557,8 @@ bool game::do_turn()
     u.update_body();
 
     // Auto-save if autosave is enabled
-    if( get_option<bool>( "AUTOSAVE" ) &&
-        calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
+    if( option_AUTOSAVE.get() &&
+        calendar::once_every( 1_turns * option_AUTOSAVE_TURNS.get() ) &&
         !u.is_dead_state() ) {
         autosave();
     }
@@ -1676,7 +1691,7 @@ bool game::do_turn()
     explosion_handler::get_explosion_queue().execute();
     cleanup_dead();
 
-    if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    if( u.moves < 0 && option_FORCE_REDRAW.get() ) {
         ui_manager::redraw();
         refresh_display();
     }
@@ -1952,55 +1967,9 @@ void game::set_critter_died()
     critter_died = true;
 }
 
-static int maptile_field_intensity( maptile &mt, field_type_id fld )
-{
-    auto field_ptr = mt.find_field( fld );
-
-    return field_ptr == nullptr ? 0 : field_ptr->get_field_intensity();
-}
-
 int get_heat_radiation( const tripoint &location, bool direct )
 {
-    // Direct heat from fire sources
-    // Cache fires to avoid scanning the map around us bp times
-    // Stored as intensity-distance pairs
-    int temp_mod = 0;
-    int best_fire = 0;
-    Character &player_character = get_avatar();
-    map &here = get_map();
-    // Convert it to an int id once, instead of 139 times per turn
-    const field_type_id fd_fire_int = fd_fire.id();
-    for( const tripoint &dest : here.points_in_radius( location, 6 ) ) {
-        int heat_intensity = 0;
-
-        maptile mt = here.maptile_at( dest );
-
-        int ffire = maptile_field_intensity( mt, fd_fire_int );
-        if( ffire > 0 ) {
-            heat_intensity = ffire;
-        } else  {
-            heat_intensity = mt.get_ter()->heat_radiation;
-        }
-        if( heat_intensity == 0 ) {
-            // No heat source here
-            continue;
-        }
-        if( player_character.pos() == location ) {
-            if( !here.pl_line_of_sight( dest, -1 ) ) {
-                continue;
-            }
-        } else if( !here.sees( location, dest, -1 ) ) {
-            continue;
-        }
-        // Ensure fire_dist >= 1 to avoid divide-by-zero errors.
-        const int fire_dist = std::max( 1, square_dist( dest, location ) );
-        temp_mod += 6 * heat_intensity * heat_intensity / fire_dist;
-        best_fire = std::max( best_fire, heat_intensity );
-    }
-    if( direct ) {
-        return best_fire;
-    }
-    return temp_mod;
+    return get_map().get_radiant_heat( location, direct );
 }
 
 int get_convection_temperature( const tripoint &location )
@@ -2734,6 +2703,7 @@ bool game::load( const save_t &name )
     u.get_avatar_diary()->load();
 
     get_weather().nextweather = calendar::turn;
+    get_weather().clear_weather_noise();
 
     get_active_world()->read_from_file( name.base_path() + SAVE_EXTENSION_LOG,
                                         std::bind( &memorial_logger::load, &memorial(), _1 ), true );
@@ -2943,7 +2913,9 @@ bool game::save( bool quitting )
             world_generator->active_world->info->add_save( save_t::from_save_id( u.get_save_id() ) );
 
             auto duration = world->commit_save_tx();
-            add_msg( m_info, _( "World Saved (took %dms)." ), duration );
+            const auto &stats = world->get_save_tx_stats();
+            add_msg( m_info, _( "World Saved (took %dms, wrote %d entries, %d KiB)." ), duration,
+                     stats.entries, static_cast<int>( ( stats.bytes + 1023 ) / 1024 ) );
             return true;
         }
     } catch( std::ios::failure &err ) {
@@ -4013,7 +3985,7 @@ void game::mon_info_update( )
     ZoneScoped;
 
     int newseen = 0;
-    const int safe_proxy_dist = get_option<int>( "SAFEMODEPROXIMITY" );
+    const int safe_proxy_dist = option_SAFEMODEPROXIMITY.get();
     const int iProxyDist = ( safe_proxy_dist <= 0 ) ? MAX_VIEW_DISTANCE :
                            safe_proxy_dist;
 
@@ -4040,11 +4012,11 @@ void game::mon_info_update( )
     // TODO: no reason to have it static here
     static time_point previous_turn = calendar::start_of_cataclysm;
     const time_duration sm_ignored_time = time_duration::from_turns(
-            get_option<int>( "SAFEMODEIGNORETURNS" ) );
+            option_SAFEMODEIGNORETURNS.get() );
 
     for( Creature *c : u.get_visible_creatures( MAPSIZE_X ) ) {
-        monster *m = dynamic_cast<monster *>( c );
-        npc *p = dynamic_cast<npc *>( c );
+        monster *m = c->as_monster();
+        npc *p = c->as_npc();
         const direction dir_to_mon = direction_from( view.xy(), point( c->posx(), c->posy() ) );
         const int mx = POSX + ( c->posx() - view.x );
         const int my = POSY + ( c->posy() - view.y );
@@ -4197,10 +4169,10 @@ void game::mon_info_update( )
         if( safe_mode == SAFE_MODE_ON ) {
             set_safe_mode( SAFE_MODE_STOP );
         }
-    } else if( calendar::turn > previous_turn && get_option<bool>( "AUTOSAFEMODE" ) &&
+    } else if( calendar::turn > previous_turn && option_AUTOSAFEMODE.get() &&
                newseen == 0 ) { // Auto-safe mode, but only if it's a new turn
         turnssincelastmon += to_turns<int>( calendar::turn - previous_turn );
-        if( turnssincelastmon >= get_option<int>( "AUTOSAFEMODETURNS" ) && safe_mode == SAFE_MODE_OFF ) {
+        if( turnssincelastmon >= option_AUTOSAFEMODETURNS.get() && safe_mode == SAFE_MODE_OFF ) {
             set_safe_mode( SAFE_MODE_ON );
             add_msg( m_info, _( "Safe mode ON!" ) );
         }
@@ -4244,6 +4216,7 @@ void game::cleanup_dead()
                 it++;
             }
         }
+        critter_tracker->note_changed();
     }
 
     critter_died = false;
@@ -4254,6 +4227,17 @@ void game::monmove()
     ZoneScoped;
     cleanup_dead();
 
+    // Line of sight checks are the bulk of monster::plan and only read the level caches,
+    // so they are done for every monster up front, in parallel. The turns below then run
+    // serially in the usual order and find the results in the map's vision cache.
+    {
+        std::vector<std::pair<tripoint, tripoint>> sight_queries;
+        for( const monster &critter : all_monsters() ) {
+            critter.collect_sight_queries( sight_queries );
+        }
+        m.precompute_sees( sight_queries );
+    }
+
     for( monster &critter : all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
         if( !critter.is_dead() && m.impassable( critter.pos() ) && !critter.can_move_to( critter.pos() ) ) {
@@ -11182,6 +11166,7 @@ point game::update_map( int &x, int &y )
             it++;
         }
     }
+    critter_tracker->note_changed();
 
     scent.shift( shift_ms );
 
@@ -27,6 +27,9 @@ void game_object<T>::destroy_in_place()
 template<typename T>
 void game_object<T>::remove_location()
 {
+    if( loc != nullptr ) {
+        static_cast<T *>( this )->on_location_changed();
+    }
     loc = nullptr;
 }
 
@@ -38,6 +41,9 @@ void game_object<T>::set_location( location<T> *own )
         detach().release();
     }
     loc = own;
+    if( loc != nullptr ) {
+        static_cast<T *>( this )->on_location_changed();
+    }
 }
 
 template<typename T>
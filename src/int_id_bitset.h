@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "int_id.h"
+
+/**
+ * Dense set of int ids of one type, one bit per loaded object.
+ * Grows on demand, so it doesn't need to know how many objects were loaded.
+ */
+template<typename T>
+class int_id_bitset
+{
+    public:
+        bool test( const int_id<T> &id ) const {
+            const size_t i = static_cast<size_t>( id.to_i() );
+            return i < bits.size() && bits[i];
+        }
+
+        void set( const int_id<T> &id ) {
+            const size_t i = static_cast<size_t>( id.to_i() );
+            if( i >= bits.size() ) {
+                bits.resize( i + 1 );
+            }
+            bits[i] = true;
+        }
+
+        void reset( const int_id<T> &id ) {
+            const size_t i = static_cast<size_t>( id.to_i() );
+            if( i < bits.size() ) {
+                bits[i] = false;
+            }
+        }
+
+        void clear() {
+            bits.clear();
+        }
+
+    private:
+        std::vector<bool> bits;
+};
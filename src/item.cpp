@@ -531,6 +531,7 @@ item &item::operator=( const item &source )
     for( item * const &it : source.components ) {
         components.push_back( item::spawn( *it ) );
     }
+    invalidate_derived_properties();
     return *this;
 }
 
@@ -544,6 +545,37 @@ void item::on_destroy()
 
 item::~item() = default;
 
+void item::on_location_changed()
+{
+    if( item *parent = parent_item() ) {
+        parent->invalidate_derived_properties();
+    }
+}
+
+void item::invalidate_derived_properties()
+{
+    for( item *it = this; it != nullptr; it = it->parent_item() ) {
+        it->derived_generation++;
+    }
+}
+
+static constexpr uint8_t derived_base_weight = 1 << 0;
+static constexpr uint8_t derived_base_volume = 1 << 2;
+static constexpr uint8_t derived_mod_flags = 1 << 4;
+
+item::derived_properties &item::get_derived_properties() const
+{
+    if( derived.generation != derived_generation || derived.type != type ||
+        derived.corpse != corpse || derived.charges != charges ) {
+        derived = derived_properties();
+        derived.generation = derived_generation;
+        derived.type = type;
+        derived.corpse = corpse;
+        derived.charges = charges;
+    }
+    return derived;
+}
+
 detached_ptr<item> item::make_corpse( const mtype_id &mt, time_point turn, const std::string &name,
                                       const int upgrade_time )
 {
@@ -575,6 +607,7 @@ void item::convert( const itype_id &new_type )
 {
     type = &*new_type;
     relic_data = type->relic_data;
+    invalidate_derived_properties();
 }
 
 void item::deactivate()
@@ -792,6 +825,7 @@ void item::set_damage( int qty )
 {
     on_damage( qty - damage_, DT_TRUE );
     damage_ = std::max( std::min( qty, max_damage() ), min_damage() );
+    invalidate_derived_properties();
 }
 
 detached_ptr<item> item::split( int qty )
@@ -1201,6 +1235,7 @@ void item::set_var( const std::string &name, const int value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    invalidate_derived_properties();
 }
 
 void item::set_var( const std::string &name, const long long value )
@@ -1209,6 +1244,7 @@ void item::set_var( const std::string &name, const long long value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    invalidate_derived_properties();
 }
 
 // NOLINTNEXTLINE(cata-no-long)
@@ -1218,11 +1254,13 @@ void item::set_var( const std::string &name, const long value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    invalidate_derived_properties();
 }
 
 void item::set_var( const std::string &name, const double value )
 {
     item_vars[name] = string_format( "%f", value );
+    invalidate_derived_properties();
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
@@ -1237,6 +1275,7 @@ double item::get_var( const std::string &name, const double default_value ) cons
 void item::set_var( const std::string &name, const tripoint &value )
 {
     item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
+    invalidate_derived_properties();
 }
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
@@ -1254,6 +1293,7 @@ tripoint item::get_var( const std::string &name, const tripoint &default_value )
 void item::set_var( const std::string &name, const std::string &value )
 {
     item_vars[name] = value;
+    invalidate_derived_properties();
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
@@ -1278,11 +1318,13 @@ bool item::has_var( const std::string &name ) const
 void item::erase_var( const std::string &name )
 {
     item_vars.erase( name );
+    invalidate_derived_properties();
 }
 
 void item::clear_vars()
 {
     item_vars.clear();
+    invalidate_derived_properties();
 }
 
 void item::add_item_with_id( const itype_id &itype, int count )
@@ -4820,6 +4862,7 @@ void item::on_contents_changed()
     }
 
     encumbrance_update_ = true;
+    invalidate_derived_properties();
 }
 
 void item::on_damage( int qty, damage_type )
@@ -5310,6 +5353,50 @@ units::mass item::weight( bool include_contents, bool integral ) const
         return ret;
     }
 
+    derived_properties &cache = get_derived_properties();
+    const uint8_t known_bit = derived_base_weight << integral;
+    if( !( cache.known & known_bit ) ) {
+        cache.base_weight[integral] = calc_base_weight( integral );
+        cache.known |= known_bit;
+    }
+    units::mass ret = cache.base_weight[integral];
+
+    if( !count_by_charges() && !is_corpse() && magazine_integral() && !is_magazine() ) {
+        if( ammo_current() == itype_plut_cell ) {
+            units::mass w = ( *ammo_types().begin() )->default_ammotype()->weight;
+            ret += ammo_remaining() * w / PLUTONIUM_CHARGES;
+        } else if( ammo_data() ) {
+            ret += ammo_remaining() * ammo_data()->weight;
+        }
+    }
+
+    // if this is an ammo belt add the weight of any implicitly contained linkages
+    if( is_magazine() ) {
+        const auto &linkage = type->magazine->linkage;
+        if( linkage ) {
+            item links( *linkage );
+            links.charges = ammo_remaining();
+            ret += links.weight();
+        }
+    }
+
+    if( is_gun() ) {
+        for( const item *elem : gunmods() ) {
+            ret += elem->weight( true, true );
+        }
+        if( !magazine_integral() && magazine_current() ) {
+            ret += std::max( magazine_current()->weight(), 0_gram );
+        }
+    } else if( include_contents ) {
+        ret += contents.item_weight_modifier();
+    }
+
+    return ret;
+}
+
+// The part of weight() that depends only on the item itself
+units::mass item::calc_base_weight( bool integral ) const
+{
     units::mass ret;
     std::string local_str_mass = integral ? get_var( "integral_weight" ) : get_var( "weight" );
     if( local_str_mass.empty() ) {
@@ -5347,24 +5434,6 @@ units::mass item::weight( bool include_contents, bool integral ) const
         if( has_flag( flag_SKINNED ) ) {
             ret *= 0.85;
         }
-
-    } else if( magazine_integral() && !is_magazine() ) {
-        if( ammo_current() == itype_plut_cell ) {
-            units::mass w = ( *ammo_types().begin() )->default_ammotype()->weight;
-            ret += ammo_remaining() * w / PLUTONIUM_CHARGES;
-        } else if( ammo_data() ) {
-            ret += ammo_remaining() * ammo_data()->weight;
-        }
-    }
-
-    // if this is an ammo belt add the weight of any implicitly contained linkages
-    if( is_magazine() ) {
-        const auto &linkage = type->magazine->linkage;
-        if( linkage ) {
-            item links( *linkage );
-            links.charges = ammo_remaining();
-            ret += links.weight();
-        }
     }
 
     // reduce weight for sawn-off weapons capped to the apportioned weight of the barrel
@@ -5376,17 +5445,6 @@ units::mass item::weight( bool include_contents, bool integral ) const
         ret -= std::min( max_barrel_weight, barrel_weight );
     }
 
-    if( is_gun() ) {
-        for( const item *elem : gunmods() ) {
-            ret += elem->weight( true, true );
-        }
-        if( !magazine_integral() && magazine_current() ) {
-            ret += std::max( magazine_current()->weight(), 0_gram );
-        }
-    } else if( include_contents ) {
-        ret += contents.item_weight_modifier();
-    }
-
     return ret;
 }
 
@@ -5458,6 +5516,36 @@ units::volume item::volume( bool integral ) const
         return ret;
     }
 
+    derived_properties &cache = get_derived_properties();
+    const uint8_t known_bit = derived_base_volume << integral;
+    if( !( cache.known & known_bit ) ) {
+        cache.base_volume[integral] = calc_base_volume( integral );
+        cache.known |= known_bit;
+    }
+    units::volume ret = cache.base_volume[integral];
+
+    // Non-rigid items add the volume of the content
+    if( !type->rigid ) {
+        ret += contents.item_size_modifier();
+    }
+
+    // Some magazines sit (partly) flush with the item so add less extra volume
+    if( magazine_current() != nullptr ) {
+        ret += std::max( magazine_current()->volume() - type->magazine_well, 0_ml );
+    }
+
+    if( is_gun() ) {
+        for( const item *elem : gunmods() ) {
+            ret += elem->volume( true );
+        }
+    }
+
+    return ret;
+}
+
+// The part of volume() that depends only on the item itself
+units::volume item::calc_base_volume( bool integral ) const
+{
     const int local_volume = get_var( "volume", -1 );
     units::volume ret;
     if( local_volume >= 0 ) {
@@ -5482,25 +5570,12 @@ units::volume item::volume( bool integral ) const
         }
     }
 
-    // Non-rigid items add the volume of the content
-    if( !type->rigid ) {
-        // Disintegrating belts should exactly match contents volume, don't enforce the 1_ml minimum
-        if( type->has_flag( flag_MAG_BELT ) && type->has_flag( flag_MAG_DESTROY ) ) {
-            ret = 0_ml;
-        }
-        ret += contents.item_size_modifier();
-    }
-
-    // Some magazines sit (partly) flush with the item so add less extra volume
-    if( magazine_current() != nullptr ) {
-        ret += std::max( magazine_current()->volume() - type->magazine_well, 0_ml );
+    // Disintegrating belts should exactly match contents volume, don't enforce the 1_ml minimum
+    if( !type->rigid && type->has_flag( flag_MAG_BELT ) && type->has_flag( flag_MAG_DESTROY ) ) {
+        ret = 0_ml;
     }
 
     if( is_gun() ) {
-        for( const item *elem : gunmods() ) {
-            ret += elem->volume( true );
-        }
-
         // TODO: implement stock_length property for guns
         if( has_flag( flag_COLLAPSIBLE_STOCK ) ) {
             // consider only the base size of the gun (without mods)
@@ -5817,6 +5892,7 @@ bool item::can_shatter() const
 void item::unset_flags()
 {
     item_tags.clear();
+    invalidate_derived_properties();
 }
 
 bool item::has_fault( const fault_id &fault ) const
@@ -5831,29 +5907,50 @@ bool item::has_own_flag( const flag_id &f ) const
 
 bool item::has_flag( const flag_id &f ) const
 {
-    // Check if we have any gun/toolmods with the flag, and if we do
-    // check if that flag should be inherited.
-    // `json_flag::get` is pretty expensive so it's faster to do it
-    // last as frequently there are no gun/toolmods with the flag f
-    auto mods = is_gun() ? gunmods() : toolmods();
-
-    const auto flag_in_mods = [&f]( const auto & mods ) -> bool {
-        return std::any_of( mods.begin(), mods.end(), [&f]( const item * e )-> bool {
-            return ( !e->is_gun() && e->has_flag( f ) );
-        } );
-    };
-
-    if( f->inherit() && flag_in_mods( mods ) ) {
+    // item type flags
+    if( type->has_flag( f ) ) {
         return true;
     }
 
-    // other item type flags
-    if( type->has_flag( f ) ) {
+    // item specific flags
+    if( has_own_flag( f ) ) {
         return true;
     }
 
-    // now check for item specific flags
-    return has_own_flag( f );
+    // flags inherited from gun/toolmods
+    return get_mod_flags().count( f );
+}
+
+const item::FlagsSetType &item::get_mod_flags() const
+{
+    derived_properties &cache = get_derived_properties();
+    if( cache.known & derived_mod_flags ) {
+        return cache.mod_flags;
+    }
+
+    // `json_flag::get` is pretty expensive, so the inheritable flags of the mods
+    // are collected once and kept until the item or one of its mods changes
+    FlagsSetType flags;
+    const auto add_inherited = [&flags]( const auto & from ) {
+        for( const flag_id &f : from ) {
+            if( f->inherit() ) {
+                flags.insert( f );
+            }
+        }
+    };
+    for( const item *mod : is_gun() ? gunmods() : toolmods() ) {
+        if( mod->is_gun() ) {
+            continue;
+        }
+        add_inherited( mod->type->get_flags() );
+        add_inherited( mod->get_flags() );
+        const FlagsSetType &nested = mod->get_mod_flags();
+        flags.insert( nested.begin(), nested.end() );
+    }
+
+    cache.mod_flags = std::move( flags );
+    cache.known |= derived_mod_flags;
+    return cache.mod_flags;
 }
 
 bool item::has_vitamin( const vitamin_id &v ) const
@@ -5881,6 +5978,7 @@ void item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
         item_tags.insert( flag );
+        invalidate_derived_properties();
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
     }
@@ -5888,7 +5986,9 @@ void item::set_flag( const flag_id &flag )
 
 void item::unset_flag( const flag_id &flag )
 {
-    item_tags.erase( flag );
+    if( item_tags.erase( flag ) ) {
+        invalidate_derived_properties();
+    }
 }
 
 void item::set_flag_recursive( const flag_id &flag )
@@ -6868,6 +6968,7 @@ bool item::mod_damage( int qty, damage_type dt )
         destroy |= damage_ + qty > max_damage();
 
         damage_ = std::max( std::min( damage_ + qty, max_damage() ), min_damage() );
+        invalidate_derived_properties();
     }
 
     return destroy;
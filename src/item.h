@@ -283,6 +283,8 @@ class item : public location_visitable<item>, public game_object<item>
 
         ~item();
         void on_destroy();
+        /** Called by @ref game_object when the item enters or leaves a location. */
+        void on_location_changed();
 
         inline static detached_ptr<item> spawn( JsonIn &jsin ) {
             detached_ptr<item> p = spawn();
@@ -1451,6 +1453,13 @@ class item : public location_visitable<item>, public game_object<item>
          */
         void on_contents_changed();
 
+        /**
+         * Marks the memoized weight, volume and mod flags of this item and of every
+         * item containing it as stale. Changes to @ref type, @ref charges and the
+         * corpse type are detected without this.
+         */
+        void invalidate_derived_properties();
+
         /**
          * Callback immediately **before** an item is damaged
          * @param qty maximum damage that will be applied (constrained by @ref max_damage)
@@ -2442,6 +2451,31 @@ class item : public location_visitable<item>, public game_object<item>
         bool encumbrance_update_ = false;
 
     private:
+        /**
+         * Properties derived from the item itself, excluding anything that depends on
+         * the charges or contents of other items. They are valid while generation,
+         * type, corpse and charges match the item.
+         */
+        struct derived_properties {
+            uint64_t generation = 0;
+            const itype *type = nullptr;
+            const mtype *corpse = nullptr;
+            int charges = 0;
+            // Bit 0/1: base_weight[integral] is set, bit 2/3: base_volume[integral], bit 4: mod_flags
+            uint8_t known = 0;
+            units::mass base_weight[2] = {};
+            units::volume base_volume[2] = {};
+            // Inheritable flags of attached gun or tool mods
+            FlagsSetType mod_flags;
+        };
+        uint64_t derived_generation = 0;
+        mutable derived_properties derived;
+
+        derived_properties &get_derived_properties() const;
+        units::mass calc_base_weight( bool integral ) const;
+        units::volume calc_base_volume( bool integral ) const;
+        const FlagsSetType &get_mod_flags() const;
+
         // generic counter to be used with item flags
         int item_counter = 0;
         /**
@@ -17,6 +17,7 @@
 #include "character.h"
 #include "cuboid_rectangle.h"
 #include "field.h"
+#include "field_type.h"
 #include "fragment_cloud.h" // IWYU pragma: keep
 #include "game.h"
 #include "int_id.h"
@@ -202,6 +203,146 @@ bool map::build_transparency_cache( const int zlev )
     return true;
 }
 
+// Heat reaches every tile a source can see, regardless of how hazy the air is
+static float radiant_heat_calc( const float &numerator, const float &, const int & )
+{
+    return numerator;
+}
+
+void map::build_radiant_heat_cache( const int zlev )
+{
+    ZoneScoped;
+    // Same as the scan radius the per-call version used
+    constexpr int radius = 6;
+
+    build_outside_cache( zlev );
+    build_transparency_cache( zlev );
+
+    level_cache &map_cache = get_cache( zlev );
+    auto &heat_cache = map_cache.radiant_heat_cache;
+    auto &fire_cache = map_cache.radiant_fire_cache;
+    std::fill_n( &heat_cache[0][0], MAPSIZE_X * MAPSIZE_Y, 0 );
+    std::fill_n( &fire_cache[0][0], MAPSIZE_X * MAPSIZE_Y, 0 );
+    map_cache.radiant_heat_cache_dirty = false;
+
+    // Local position and intensity of every heat source on the level
+    std::vector<std::pair<point, int>> sources;
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const submap *cur_submap = get_submap_at_grid( {smx, smy, zlev} );
+            if( cur_submap == nullptr ) {
+                continue;
+            }
+            const point sm_offset = sm_to_ms_copy( point( smx, smy ) );
+
+            // Uniform submaps can't have fields on them
+            if( cur_submap->is_uniform ) {
+                const int heat = cur_submap->get_ter( point_zero ).obj().heat_radiation;
+                if( heat == 0 ) {
+                    continue;
+                }
+                for( int sx = 0; sx < SEEX; ++sx ) {
+                    for( int sy = 0; sy < SEEY; ++sy ) {
+                        sources.emplace_back( sm_offset + point( sx, sy ), heat );
+                    }
+                }
+                continue;
+            }
+
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                for( int sy = 0; sy < SEEY; ++sy ) {
+                    const point sp( sx, sy );
+                    // Fire replaces the heat of the terrain it burns on
+                    int heat = 0;
+                    if( cur_submap->field_tiles.test( sx * SEEY + sy ) ) {
+                        const field_entry *fire = cur_submap->get_field( sp ).find_field( fd_fire );
+                        if( fire != nullptr ) {
+                            heat = fire->get_field_intensity();
+                        }
+                    }
+                    if( heat <= 0 ) {
+                        heat = cur_submap->get_ter( sp ).obj().heat_radiation;
+                    }
+                    if( heat != 0 ) {
+                        sources.emplace_back( sm_offset + sp, heat );
+                    }
+                }
+            }
+        }
+    }
+
+    if( sources.empty() ) {
+        return;
+    }
+
+    // A source with nothing that blocks sight within range sees the whole square around it,
+    // only sources near obstacles need a shadowcast. That keeps fields of lava or fire cheap.
+    // Summed area table of the tiles that block sight, the margin covers the diagonal
+    // vehicle checks of the shadowcast.
+    std::vector<int> blocking( ( MAPSIZE_X + 1 ) * ( MAPSIZE_Y + 1 ), 0 );
+    const auto blocking_sum = [&blocking]( int x, int y ) -> int & {
+        return blocking[x * ( MAPSIZE_Y + 1 ) + y];
+    };
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            const diagonal_blocks &obscured = map_cache.vehicle_obscured_cache[x][y];
+            const bool blocks = map_cache.transparency_cache[x][y] <= LIGHT_TRANSPARENCY_SOLID ||
+                                obscured.nw || obscured.ne;
+            blocking_sum( x + 1, y + 1 ) = blocks + blocking_sum( x, y + 1 ) + blocking_sum( x + 1, y ) -
+                                           blocking_sum( x, y );
+        }
+    }
+    const auto in_open = [&blocking_sum]( point src ) {
+        const int min_x = std::max( 0, src.x - radius - 1 );
+        const int min_y = std::max( 0, src.y - radius - 1 );
+        const int max_x = std::min( MAPSIZE_X, src.x + radius + 2 );
+        const int max_y = std::min( MAPSIZE_Y, src.y + radius + 2 );
+        return blocking_sum( max_x, max_y ) - blocking_sum( min_x, max_y ) -
+               blocking_sum( max_x, min_y ) + blocking_sum( min_x, min_y ) == 0;
+    };
+
+    // Kept zeroed between sources by clearing the window around each one after use
+    float visible[MAPSIZE_X][MAPSIZE_Y] = {};
+    for( const auto &[src, intensity] : sources ) {
+        const bool open = in_open( src );
+        if( !open ) {
+            castLightAll<float, float, radiant_heat_calc, sight_check, update_light, accumulate_transparency>(
+                visible, map_cache.transparency_cache, map_cache.vehicle_obscured_cache, src, 60 - radius );
+            // Shadowcasting skips the origin, but the source heats its own tile too
+            visible[src.x][src.y] = 1.0f;
+        }
+
+        const int heat = 6 * intensity * intensity;
+        const int max_x = std::min( MAPSIZE_X - 1, src.x + radius );
+        const int max_y = std::min( MAPSIZE_Y - 1, src.y + radius );
+        for( int x = std::max( 0, src.x - radius ); x <= max_x; x++ ) {
+            for( int y = std::max( 0, src.y - radius ); y <= max_y; y++ ) {
+                if( !open ) {
+                    if( visible[x][y] <= 0.0f ) {
+                        continue;
+                    }
+                    visible[x][y] = 0.0f;
+                }
+                // Ensure distance >= 1 to avoid divide-by-zero errors.
+                heat_cache[x][y] += heat / std::max( 1, square_dist( src, point( x, y ) ) );
+                fire_cache[x][y] = std::max( fire_cache[x][y], intensity );
+            }
+        }
+    }
+}
+
+int map::get_radiant_heat( const tripoint &p, const bool direct )
+{
+    if( !inbounds( p ) ) {
+        return 0;
+    }
+    level_cache &map_cache = get_cache( p.z );
+    if( map_cache.radiant_heat_cache_dirty ) {
+        build_radiant_heat_cache( p.z );
+    }
+    return direct ? map_cache.radiant_fire_cache[p.x][p.y] : map_cache.radiant_heat_cache[p.x][p.y];
+}
+
 bool map::build_vision_transparency_cache( const Character &player )
 {
     const tripoint &p = player.pos();
@@ -437,6 +578,7 @@ void map::build_sunlight_cache( int pzlev )
 void map::generate_lightmap( const int zlev )
 {
     ZoneScoped;
+    vision_revision++;
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -1593,6 +1735,7 @@ template void castLightAllWithLookup<float, four_quadrants, sight_calc, sight_ch
  */
 void map::build_seen_cache( const tripoint &origin, const int target_z )
 {
+    vision_revision++;
     auto &map_cache = get_cache( target_z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.transparency_cache;
     float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
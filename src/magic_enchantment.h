@@ -133,6 +133,11 @@ class enchantment
         // @active means the container for the enchantment is active, for comparison to active flag.
         bool is_active( const Character &guy, bool active ) const;
 
+        // whether the condition is ALWAYS, so only having the source matters
+        bool is_unconditional() const {
+            return active_conditions.second == condition::ALWAYS;
+        }
+
         /**
          * Whether this enchantment will be active if parent item is wielded.
          * Assumes condition is satisfied.
@@ -42,6 +42,8 @@
 #include "output.h"
 #include "path_info.h"
 #include "rng.h"
+#include "save_compression_report.h"
+#include "turn_benchmark.h"
 #include "type_id.h"
 #include "ui_manager.h"
 #include "path_display.h"
@@ -208,6 +210,9 @@ int main( int argc, char *argv[] )
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    bool run_benchmark = false;
+    turn_benchmark::options benchmark_opts;
+    std::string compression_report_world;
 
 #if defined(__ANDROID__)
     // Start the standard output logging redirector
@@ -243,7 +248,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 15> first_pass_arguments = {{
+        const std::array<arg_handler, 17> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -422,6 +427,34 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--benchmark", "<world> <turns> <report path> [wait|travel] [seed]",
+                    "Replays turns of a saved world headlessly and writes a JSON performance report",
+                    section_default,
+                    [&]( int num_args, const char **params ) -> int {
+                        const int consumed = turn_benchmark::parse_args( benchmark_opts, num_args, params );
+                        if( consumed < 0 )
+                        {
+                            return -1;
+                        }
+                        test_mode = true;
+                        run_benchmark = true;
+                        return consumed;
+                    }
+                },
+                {
+                    "--compression-report", "<world>",
+                    "Prints the size and speed of save compression on a world's save databases and exit",
+                    section_default,
+                    [&]( int num_args, const char **params ) -> int {
+                        if( num_args < 1 )
+                        {
+                            return -1;
+                        }
+                        compression_report_world = params[0];
+                        return 1;
+                    }
+                },
                 {
                     "--lua-doc", "<output path>",
                     "Generate Lua docs to given path and exit",
@@ -634,6 +667,10 @@ int main( int argc, char *argv[] )
         }
     }
 
+    if( !compression_report_world.empty() ) {
+        return save_compression_report::run( compression_report_world );
+    }
+
     std::string current_path = std::filesystem::current_path().string();
 
     if( !dir_exist( PATH_INFO::datadir() ) ) {
@@ -801,6 +838,11 @@ int main( int argc, char *argv[] )
         return 0;
     }
 
+    if( run_benchmark ) {
+        init_colors();
+        exit( turn_benchmark::run( benchmark_opts ) );
+    }
+
     prompt_select_lang_on_startup();
     replay_buffered_debugmsg_prompts();
 
@@ -6,10 +6,12 @@
 #include <climits>
 #include <cstdlib>
 #include <cstring>
+#include <future>
 #include <limits>
 #include <optional>
 #include <ostream>
 #include <queue>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <variant>
@@ -216,6 +218,21 @@ void map::set_transparency_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         get_cache( zlev ).transparency_cache_dirty.set();
+        get_cache( zlev ).radiant_heat_cache_dirty = true;
+    }
+}
+
+void map::set_radiant_heat_cache_dirty( const int zlev )
+{
+    if( inbounds_z( zlev ) ) {
+        get_cache( zlev ).radiant_heat_cache_dirty = true;
+    }
+}
+
+void map::set_radiant_heat_cache_dirty()
+{
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        get_cache( z ).radiant_heat_cache_dirty = true;
     }
 }
 
@@ -267,6 +284,7 @@ void map::set_transparency_cache_dirty( const tripoint &p )
     if( inbounds( p ) ) {
         const tripoint smp = ms_to_sm_copy( p );
         get_cache( smp.z ).transparency_cache_dirty.set( smp.x * MAPSIZE + smp.y );
+        get_cache( smp.z ).radiant_heat_cache_dirty = true;
     }
 }
 
@@ -458,6 +476,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             reset_vehicle_cache( );
             std::unique_ptr<vehicle> result = std::move( current_submap->vehicles[i] );
             current_submap->vehicles.erase( current_submap->vehicles.begin() + i );
+            current_submap->mark_dirty();
             if( veh->tracking_on ) {
                 overmap_buffer.remove_vehicle( veh );
             }
@@ -1342,7 +1361,9 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
         auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
         dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
         src_submap->vehicles.erase( src_submap_veh_it );
+        src_submap->mark_dirty();
         dst_submap->is_uniform = false;
+        dst_submap->mark_dirty();
         invalidate_max_populated_zlev( dst.z );
     }
     if( need_update ) {
@@ -1842,6 +1863,10 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
         set_seen_cache_dirty( p );
     }
 
+    if( old_t.heat_radiation != new_t.heat_radiation ) {
+        set_radiant_heat_cache_dirty( p.z );
+    }
+
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
         set_outside_cache_dirty( p.z );
     }
@@ -2893,6 +2918,7 @@ void map::decay_fields_and_scent( const time_duration &amount )
 
             if( to_proc > 0 ) {
                 cur_submap->field_count = cur_submap->field_count - to_proc;
+                cur_submap->mark_dirty();
                 dbg( DL::Warn ) << "map::decay_fields_and_scent: submap at "
                                 << abs_sub + tripoint( smx, smy, 0 )
                                 << "has " << cur_submap->field_count - to_proc << "fields, but "
@@ -4608,6 +4634,8 @@ map_stack map::i_at( const tripoint &p )
 
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    // The stack gives out references that items can be changed through in place
+    current_submap->mark_dirty();
 
     return map_stack{ &current_submap->get_items( l ), p, this };
 }
@@ -4917,6 +4945,7 @@ void map::add_item( const tripoint &p, detached_ptr<item> &&new_item )
     }
 
     current_submap->is_uniform = false;
+    current_submap->mark_dirty();
     invalidate_max_populated_zlev( p.z );
 
     current_submap->update_lum_add( l, *new_item );
@@ -5130,7 +5159,8 @@ void map::process_items()
         }
     }
     // Making a copy, in case the original variable gets modified during `process_items_in_submap`
-    const std::set<tripoint> submaps_with_active_items_copy = submaps_with_active_items;
+    const std::vector<tripoint> submaps_with_active_items_copy( submaps_with_active_items.begin(),
+            submaps_with_active_items.end() );
     for( const tripoint &abs_pos : submaps_with_active_items_copy ) {
         const tripoint local_pos = abs_pos - abs_sub.xy();
         submap *const current_submap = get_submap_at_grid( local_pos );
@@ -5161,6 +5191,9 @@ void map::process_items_in_submap( submap &current_submap, const tripoint &gridp
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
     std::vector<item *> active_items = current_submap.active_items.get_for_processing();
+    if( !active_items.empty() ) {
+        current_submap.mark_dirty();
+    }
     const point grid_offset( gridp.x * SEEX, gridp.y * SEEY );
     for( item *&active_item_ref : active_items ) {
         if( !active_item_ref || !active_item_ref->is_loaded() ) {
@@ -5502,6 +5535,10 @@ std::vector<detached_ptr<item>> map::use_charges( const tripoint &origin, const
         if( accessible_items( p ) ) {
             std::vector<detached_ptr<item>> tmp = use_charges_from_stack( i_at( p ), type, quantity, p,
                                                   filter );
+            if( !tmp.empty() ) {
+                // Charges may have been taken from an item that stays on the tile.
+                get_submap_at( p )->mark_dirty();
+            }
             ret.insert( ret.end(), std::make_move_iterator( tmp.begin() ),
                         std::make_move_iterator( tmp.end() ) );
             if( quantity <= 0 ) {
@@ -5627,6 +5664,7 @@ void map::partial_con_remove( const tripoint &p )
     point l;
     submap *const current_submap = get_submap_at( p, l );
     current_submap->partial_constructions.erase( tripoint( l, p.z ) );
+    current_submap->mark_dirty();
 }
 
 void map::partial_con_set( const tripoint &p, std::unique_ptr<partial_con> con )
@@ -5636,6 +5674,7 @@ void map::partial_con_set( const tripoint &p, std::unique_ptr<partial_con> con )
     }
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    current_submap->mark_dirty();
     if( !current_submap->partial_constructions.emplace( tripoint( l, p.z ),
             std::move( con ) ).second ) {
         debugmsg( "set partial con on top of terrain which already has a partial con" );
@@ -5889,8 +5928,10 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     point l;
     submap *const current_submap = get_submap_at( p, l );
     current_submap->is_uniform = false;
+    current_submap->mark_dirty();
     invalidate_max_populated_zlev( p.z );
 
+    current_submap->set_field_tile( l );
     if( current_submap->get_field( l ).add_field( type_id, intensity, age ) ) {
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
@@ -5907,6 +5948,10 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
         }
     }
 
+    if( type_id == fd_fire ) {
+        set_radiant_heat_cache_dirty( p.z );
+    }
+
     // Dirty the transparency cache now that field processing doesn't always do it
     if( fd_type.dirty_transparency_cache || !fd_type.is_transparent() ) {
         set_transparency_cache_dirty( p );
@@ -5935,11 +5980,15 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
     submap *const current_submap = get_submap_at( p, l );
 
     if( current_submap->get_field( l ).remove_field( field_to_remove ) ) {
+        current_submap->mark_dirty();
         // Only adjust the count if the field actually existed.
         if( !--current_submap->field_count ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
                                                   p.y / SEEX ) * MAPSIZE ) ) );
         }
+        if( field_to_remove == fd_fire ) {
+            set_radiant_heat_cache_dirty( p.z );
+        }
         const auto &fdata = field_to_remove.obj();
         if( fdata.dirty_transparency_cache || !fdata.is_transparent() ) {
             set_transparency_cache_dirty( p );
@@ -6577,6 +6626,18 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range ) const
 /**
  * This one is internal-only, we don't want to expose the slope tweaking ickiness outside the map class.
  **/
+static point sees_cache_key( const tripoint &F, const tripoint &T )
+{
+    // Cannonicalize the order of the tripoints so the cache is reflexive.
+    const tripoint &min = F < T ? F : T;
+    const tripoint &max = !( F < T ) ? F : T;
+    // A little gross, just pack the values into a point.
+    return point(
+               min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
+               max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
+           );
+}
+
 bool map::sees( const tripoint &F, const tripoint &T, const int range,
                 int &bresenham_slope ) const
 {
@@ -6585,19 +6646,107 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    // Cannonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint &min = F < T ? F : T;
-    const tripoint &max = !( F < T ) ? F : T;
-    // A little gross, just pack the values into a point.
-    const point key(
-        min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
-        max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
-    );
+    const point key = sees_cache_key( F, T );
     char cached = skew_vision_cache.get( key, -1 );
     if( cached >= 0 ) {
         return cached > 0;
     }
 
+    const bool visible = sees_uncached( F, T, bresenham_slope );
+    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    return visible;
+}
+
+void map::precompute_sees( const std::vector<std::pair<tripoint, tripoint>> &pairs ) const
+{
+    ZoneScoped;
+    // Below this the thread startup costs more than the line of sight checks themselves.
+    static constexpr size_t min_pairs_per_task = 256;
+
+    std::vector<char> visible( pairs.size(), 0 );
+    const auto compute = [this, &pairs, &visible]( size_t begin, size_t end ) {
+        for( size_t i = begin; i < end; i++ ) {
+            const auto &[from, to] = pairs[i];
+            if( inbounds( to ) ) {
+                int slope = 0;
+                visible[i] = sees_uncached( from, to, slope ) ? 1 : 0;
+            }
+        }
+    };
+
+    const size_t tasks = std::clamp<size_t>( pairs.size() / min_pairs_per_task, 1,
+                         std::max( 1u, std::thread::hardware_concurrency() ) );
+    const size_t chunk = ( pairs.size() + tasks - 1 ) / tasks;
+    std::vector<std::future<void>> workers;
+    for( size_t t = 1; t < tasks; t++ ) {
+        const size_t begin = std::min( pairs.size(), t * chunk );
+        const size_t end = std::min( pairs.size(), begin + chunk );
+        workers.push_back( std::async( std::launch::async, compute, begin, end ) );
+    }
+    compute( 0, std::min( pairs.size(), chunk ) );
+    for( std::future<void> &worker : workers ) {
+        worker.get();
+    }
+
+    for( size_t i = 0; i < pairs.size(); i++ ) {
+        const auto &[from, to] = pairs[i];
+        if( !inbounds( to ) ) {
+            continue;
+        }
+        const point key = sees_cache_key( from, to );
+        if( skew_vision_cache.get( key, -1 ) < 0 ) {
+            skew_vision_cache.insert( 100000, key, visible[i] );
+        }
+    }
+}
+
+bool map::sees_target( const tripoint &F, const tripoint &T, const int range ) const
+{
+    if( F.z != T.z ) {
+        return sees( F, T, range );
+    }
+    if( ( range >= 0 && range < rl_dist( F, T ) ) || !inbounds( T ) || !inbounds( F ) ) {
+        return false;
+    }
+    return get_target_fov( T ).seen[F.x][F.y] > LIGHT_TRANSPARENCY_SOLID;
+}
+
+const map::target_fov &map::get_target_fov( const tripoint &T ) const
+{
+    // Enough for the NPCs of a busy reality bubble, each field of view is about 70 kB
+    static constexpr size_t max_target_fovs = 32;
+    if( target_fovs_turn != calendar::turn ) {
+        target_fovs.clear();
+        target_fovs_turn = calendar::turn;
+    }
+    for( const std::unique_ptr<target_fov> &fov : target_fovs ) {
+        if( fov->pos == T ) {
+            return *fov;
+        }
+    }
+
+    ZoneScoped;
+    std::unique_ptr<target_fov> fov;
+    if( target_fovs.size() >= max_target_fovs ) {
+        fov = std::move( target_fovs.front() );
+        target_fovs.erase( target_fovs.begin() );
+    } else {
+        fov = std::make_unique<target_fov>();
+    }
+    fov->pos = T;
+    // Same cast as the avatar's seen cache, without the avatar's own vision transparencies
+    const level_cache &cache = get_cache_ref( T.z );
+    std::fill_n( &fov->seen[0][0], MAPSIZE_X * MAPSIZE_Y,
+                 static_cast<float>( LIGHT_TRANSPARENCY_SOLID ) );
+    fov->seen[T.x][T.y] = VISIBILITY_FULL;
+    castLightAllWithLookup<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
+    ( fov->seen, cache.transparency_cache, cache.vehicle_obscured_cache, T.xy(), 0 );
+    target_fovs.push_back( std::move( fov ) );
+    return *target_fovs.back();
+}
+
+bool map::sees_uncached( const tripoint &F, const tripoint &T, int &bresenham_slope ) const
+{
     bool visible = true;
 
     // Ugly `if` for now
@@ -6618,7 +6767,6 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             last_point = new_point;
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
         return visible;
     }
 
@@ -6651,7 +6799,6 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
     return visible;
 }
 
@@ -6974,7 +7121,7 @@ bool map::obscured_by_vehicle_rotation( const tripoint &from, const tripoint &to
 
     point delta = to.xy() - from.xy();
 
-    auto cache = get_cache( from.z ).vehicle_obscured_cache;
+    const auto &cache = get_cache_ref( from.z ).vehicle_obscured_cache;
 
     if( delta == point_north_west ) {
         return cache[from.x][from.y].nw;
@@ -7189,7 +7336,9 @@ void map::shift_vehicle_z( vehicle &veh, int z_shift )
     auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
     dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
     src_submap->vehicles.erase( src_submap_veh_it );
+    src_submap->mark_dirty();
     dst_submap->is_uniform = false;
+    dst_submap->mark_dirty();
     invalidate_max_populated_zlev( dst.z );
 
     update_vehicle_list( dst_submap, dst.z );
@@ -8239,7 +8388,10 @@ void map::spawn_monsters_submap( const tripoint &gp, bool ignore_sight )
             }
         }
     }
-    current_submap->spawns.clear();
+    if( !current_submap->spawns.empty() ) {
+        current_submap->mark_dirty();
+        current_submap->spawns.clear();
+    }
 }
 
 void map::spawn_monsters( bool ignore_sight )
@@ -8262,7 +8414,10 @@ void map::spawn_monsters( bool ignore_sight )
 void map::clear_spawns()
 {
     for( auto &smap : grid ) {
-        smap->spawns.clear();
+        if( !smap->spawns.empty() ) {
+            smap->mark_dirty();
+            smap->spawns.clear();
+        }
     }
 }
 
@@ -8789,6 +8944,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
 
     if( seen_cache_dirty ) {
         skew_vision_cache.clear();
+        target_fovs.clear();
     }
     // Initial value is illegal player position.
     const tripoint &p = g->u.pos();
@@ -9337,6 +9493,8 @@ level_cache::level_cache()
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
+    std::fill_n( &radiant_heat_cache[0][0], map_dimensions, 0 );
+    std::fill_n( &radiant_fire_cache[0][0], map_dimensions, 0 );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
@@ -9396,6 +9554,7 @@ void map::invalidate_map_cache( const int zlev )
         ch.seen_cache_dirty = true;
         ch.outside_cache_dirty = true;
         ch.suspension_cache_dirty = true;
+        ch.radiant_heat_cache_dirty = true;
     }
 }
 
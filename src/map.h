@@ -349,6 +349,14 @@ struct level_cache {
     std::bitset<MAPSIZE_X *MAPSIZE_Y> map_memory_seen_cache;
     std::bitset<MAPSIZE *MAPSIZE> field_cache;
 
+    // radiant heat from fires and hot terrain, rebuilt lazily once per turn
+    // see map::build_radiant_heat_cache
+    bool radiant_heat_cache_dirty = true;
+    // summed heat received by the tile, same units as get_heat_radiation( p, false )
+    int radiant_heat_cache[MAPSIZE_X][MAPSIZE_Y];
+    // intensity of the hottest source the tile can see
+    int radiant_fire_cache[MAPSIZE_X][MAPSIZE_Y];
+
     bool veh_in_active_range;
     bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
     std::map< tripoint, std::pair<vehicle *, int> > veh_cached_parts;
@@ -425,6 +433,10 @@ class map
         void set_suspension_cache_dirty( const int zlev );
 
         void set_pathfinding_cache_dirty( int zlev );
+
+        // invalidates radiant heat of the zlevel, or of every zlevel
+        void set_radiant_heat_cache_dirty( int zlev );
+        void set_radiant_heat_cache_dirty();
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p );
@@ -538,7 +550,8 @@ class map
         std::pair<tripoint, maptile> maptile_has_bounds( const tripoint &p, bool bounds_checked );
         std::array<std::pair<tripoint, maptile>, 8> get_neighbors( const tripoint &p );
         void spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
-                         const time_duration &outdoor_age_speedup, scent_block &sblk );
+                         const time_duration &outdoor_age_speedup, scent_block &sblk,
+                         const oter_id &cur_om_ter );
         void create_hot_air( const tripoint &p, int intensity );
         bool gas_can_spread_to( field_entry &cur, const tripoint &src, const tripoint &dst );
         void gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p );
@@ -619,7 +632,30 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Computes line of sight between each pair of points and stores the results in the
+         * cache consulted by @ref sees, spreading the work over worker threads.
+         * Only the level caches are read while computing, so the map must not be modified
+         * until this returns. Results are merged in input order and never replace entries
+         * that are already cached, so the outcome does not depend on thread scheduling.
+         */
+        void precompute_sees( const std::vector<std::pair<tripoint, tripoint>> &pairs ) const;
+        /**
+         * Returns whether `F` sees the target at `T` with a view range of `range`, looked up in a
+         * field of view cast from `T`. Meant for targets that many creatures look at, such as NPCs
+         * hunted by monsters: the field of view is cast once per target position and reused until
+         * the vision caches are rebuilt. Falls back to @ref sees between z-levels.
+         */
+        bool sees_target( const tripoint &F, const tripoint &T, int range ) const;
     private:
+        struct target_fov {
+            tripoint pos;
+            float seen[MAPSIZE_X][MAPSIZE_Y];
+        };
+        /** Field of view from `T`, see @ref sees_target. */
+        const target_fov &get_target_fov( const tripoint &T ) const;
+        /** Line of sight between `F` and `T` ignoring range, without touching the vision cache. */
+        bool sees_uncached( const tripoint &F, const tripoint &T, int &bresenham_slope ) const;
         /**
          * Don't expose the slope adjust outside map functions.
          *
@@ -1238,6 +1274,12 @@ class map
         // Temperature
         // Temperature for submap
         int get_temperature( const tripoint &p ) const;
+        /**
+         * Radiant heat reaching the tile from fires and hot terrain within 6 tiles.
+         * Reads the per-zlevel heat cache, building it first if needed.
+         * @param direct if true, return intensity of the hottest visible source instead of total heat
+         */
+        int get_radiant_heat( const tripoint &p, bool direct );
         // Set temperature for all four submap quadrants
         void set_temperature( const tripoint &p, int temperature );
         void set_temperature( point p, int new_temperature ) {
@@ -1851,6 +1893,7 @@ class map
         // Used to determine if seen cache should be rebuilt.
         bool build_transparency_cache( int zlev );
         bool build_vision_transparency_cache( const Character &player );
+        void build_radiant_heat_cache( int zlev );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
     public:
@@ -1862,6 +1905,13 @@ class map
         void build_floor_caches();
         // Checks all suspended tiles on a z level and adds those that are invalid to the support_dirty_cache */
         void update_suspension_cache( const int &z );
+        /**
+         * Incremented whenever the seen cache or the lightmap are rebuilt.
+         * Both decide which creatures the avatar can see.
+         */
+        int64_t get_vision_revision() const {
+            return vision_revision;
+        }
     protected:
         void generate_lightmap( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
@@ -2060,6 +2110,13 @@ class map
          * Cache of coordinate pairs recently checked for visibility.
          */
         mutable lru_cache<point, char> skew_vision_cache;
+        /**
+         * Fields of view cast by @ref sees_target this turn, oldest first.
+         * Also cleared with @ref skew_vision_cache.
+         */
+        mutable std::vector<std::unique_ptr<target_fov>> target_fovs;
+        mutable time_point target_fovs_turn = calendar::before_time_starts;
+        int64_t vision_revision = 0;
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
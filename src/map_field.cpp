@@ -254,12 +254,9 @@ void map::gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p )
 }
 
 void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
-                      const time_duration &outdoor_age_speedup, scent_block &sblk )
+                      const time_duration &outdoor_age_speedup, scent_block &sblk,
+                      const oter_id &cur_om_ter )
 {
-    map &here = get_map();
-    // TODO: fix point types
-    const oter_id &cur_om_ter =
-        overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( p ) ) ) );
     const bool sheltered = g->is_sheltered( p );
     const weather_manager &weather = get_weather();
     const int winddirection = weather.winddirection;
@@ -324,7 +321,7 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
     const maptile remove_tile3 = std::get<2>( maptiles );
     if( !spread.empty() && ( !zlevels || one_in( spread.size() ) ) ) {
         // Construct the destination from offset and p
-        if( g->is_sheltered( p ) || windpower < 5 ) {
+        if( sheltered || windpower < 5 ) {
             std::pair<tripoint, maptile> &n = neighs[ random_entry( spread ) ];
             gas_spread_to( cur, n.second, n.first );
         } else {
@@ -417,9 +414,20 @@ void map::process_fields_in_submap( submap *const current_submap,
     int &locy = map_tile.pos_.y;
     const point sm_offset( submap.x * SEEX, submap.y * SEEY );
 
-    // Loop through all tiles in this submap indicated by current_submap
+    // Overmap terrain is the same for the whole submap, look it up once for gas spreading
+    const oter_id &cur_om_ter =
+        overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( getabs( tripoint( sm_offset, submap.z ) ) ) ) );
+
+    // Loop through the tiles of this submap that may hold fields, in the same
+    // x-major order as a full scan would. Fields added ahead of the current
+    // tile mark their tile and get visited in this pass as well.
+    std::bitset<SEEX * SEEY> &field_tiles = current_submap->field_tiles;
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            const int tile = locx * SEEY + locy;
+            if( !field_tiles[tile] ) {
+                continue;
+            }
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
             field &curfield = current_submap->get_field( { locx, locy } );
@@ -427,6 +435,7 @@ void map::process_fields_in_submap( submap *const current_submap,
             // when displayed_field_type == fd_null it means that `curfield` has no fields inside
             // avoids instantiating (relatively) expensive map iterator
             if( !curfield.displayed_field_type() ) {
+                field_tiles.reset( tile );
                 continue;
             }
 
@@ -455,6 +464,7 @@ void map::process_fields_in_submap( submap *const current_submap,
                         dirty_transparency_cache = true;
                     }
                     --current_submap->field_count;
+                    current_submap->mark_dirty();
                     curfield.remove_field( it++ );
                     continue;
                 }
@@ -848,7 +858,7 @@ void map::process_fields_in_submap( submap *const current_submap,
                     const int gas_percent_spread = cur_fd_type.percent_spread;
                     if( gas_percent_spread > 0 ) {
                         const time_duration outdoor_age_speedup = cur_fd_type.outdoor_age_speedup;
-                        spread_gas( cur, p, gas_percent_spread, outdoor_age_speedup, sblk );
+                        spread_gas( cur, p, gas_percent_spread, outdoor_age_speedup, sblk, cur_om_ter );
                     }
                 }
 
@@ -1142,7 +1152,7 @@ void map::process_fields_in_submap( submap *const current_submap,
                                 }
                             }
                         } else {
-                            spread_gas( cur, p, 5, 0_turns, sblk );
+                            spread_gas( cur, p, 5, 0_turns, sblk, cur_om_ter );
                         }
                     }
                 }
@@ -1184,6 +1194,7 @@ void map::process_fields_in_submap( submap *const current_submap,
                 }
                 if( !cur.is_field_alive() ) {
                     --current_submap->field_count;
+                    current_submap->mark_dirty();
                     curfield.remove_field( it++ );
                 } else {
                     ++it;
@@ -153,16 +153,25 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
     offsets.push_back( point_east );
     offsets.push_back( point_south_east );
 
+    const world *world_ptr = g->get_active_world();
     bool all_uniform = true;
+    bool dirty = false;
     for( auto &offsets_offset : offsets ) {
         tripoint submap_addr = omt_to_sm_copy( om_addr );
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
         submap *sm = submaps[submap_addr].get();
-        if( sm != nullptr && !sm->is_uniform ) {
+        if( sm == nullptr ) {
+            continue;
+        }
+        if( !sm->is_uniform ) {
             all_uniform = false;
         }
+        // A write whose save transaction didn't commit is not in the save
+        if( sm->is_dirty() || !world_ptr->save_tx_committed( sm->get_saved_tx() ) ) {
+            dirty = true;
+        }
     }
 
     if( all_uniform ) {
@@ -182,7 +191,18 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         return;
     }
 
-    g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
+    if( !dirty ) {
+        if( delete_after_save ) {
+            for( auto &submap_addr : submap_addrs ) {
+                if( submaps[submap_addr] != nullptr ) {
+                    submaps_to_delete.push_back( submap_addr );
+                }
+            }
+        }
+        return;
+    }
+
+    world_ptr->write_map_quad( om_addr, [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
@@ -208,6 +228,7 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
             jsout.end_array();
 
             sm->store( jsout );
+            sm->mark_saved( world_ptr->current_save_tx() );
 
             jsout.end_object();
 
@@ -270,6 +291,7 @@ void mapbuffer::deserialize( JsonIn &jsin )
             }
         }
 
+        sm->mark_saved();
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
                       submap_coordinates.z );
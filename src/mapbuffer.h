@@ -21,6 +21,9 @@ class mapbuffer
         ~mapbuffer();
 
         /** Store all submaps in this instance into savefiles.
+         * Only quads with a submap that changed since it was last saved are written,
+         * see @ref submap::is_dirty, or whose last write was in a save transaction that
+         * failed to commit.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
          **/
@@ -102,6 +102,9 @@ static const mongroup_id GROUP_ZOMBIE_COP( "GROUP_ZOMBIE_COP" );
 
 static const trait_id trait_NPC_STATIC_NPC( "NPC_STATIC_NPC" );
 
+static const option_handle<float> option_SPAWN_ANIMAL_DENSITY( "SPAWN_ANIMAL_DENSITY" );
+static const option_handle<float> option_SPAWN_DENSITY( "SPAWN_DENSITY" );
+
 #define dbg(x) DebugLogFL((x),DC::MapGen)
 
 static constexpr int MON_RADIUS = 3;
@@ -167,9 +170,9 @@ void map::generate( const tripoint &p, const time_point &when )
 
     float spawn_density = 1.0f;
     if( MonsterGroupManager::is_animal( spawns.group ) ) {
-        spawn_density = get_option< float >( "SPAWN_ANIMAL_DENSITY" );
+        spawn_density = option_SPAWN_ANIMAL_DENSITY.get();
     } else {
-        spawn_density = get_option< float >( "SPAWN_DENSITY" );
+        spawn_density = option_SPAWN_DENSITY.get();
     }
 
     // Apply a multiplier to the number of monsters for really high densities.
@@ -2080,7 +2083,7 @@ class jmapgen_monster : public jmapgen_piece
             // Handle spawn density: Increase odds, but don't let the odds of absence go below half the odds at density 1.
             // Instead, apply a multipler to the number of monsters for really high densities.
             // For example, a 50% chance at spawn density 4 becomes a 75% chance of ~2.7 monsters.
-            int odds_after_density = raw_odds * get_option<float>( "SPAWN_DENSITY" );
+            int odds_after_density = raw_odds * option_SPAWN_DENSITY.get();
             int max_odds = ( 100 + raw_odds ) / 2;
             float density_multiplier = 1;
             if( odds_after_density > max_odds ) {
@@ -6156,9 +6159,9 @@ void map::place_spawns( const mongroup_id &group, const int chance,
 
     float spawn_density = 1.0f;
     if( MonsterGroupManager::is_animal( group ) ) {
-        spawn_density = get_option< float >( "SPAWN_ANIMAL_DENSITY" );
+        spawn_density = option_SPAWN_ANIMAL_DENSITY.get();
     } else {
-        spawn_density = get_option< float >( "SPAWN_DENSITY" );
+        spawn_density = option_SPAWN_DENSITY.get();
     }
 
     float multiplier = density * spawn_density;
@@ -6432,6 +6435,7 @@ void map::add_spawn( const mtype_id &type, int count, const tripoint &p,
     }
     spawn_point tmp( type, count, offset, faction_id, mission_id, disposition, name );
     place_on_submap->spawns.push_back( tmp );
+    place_on_submap->mark_dirty();
 }
 
 vehicle *map::add_vehicle( const std::variant<vgroup_id, vproto_id> &type_,
@@ -6492,6 +6496,7 @@ vehicle *map::add_vehicle( const std::variant<vgroup_id, vproto_id> &type_,
         submap *place_on_submap = get_submap_at_grid( placed_vehicle->sm_pos );
         place_on_submap->vehicles.push_back( std::move( placed_vehicle_up ) );
         place_on_submap->is_uniform = false;
+        place_on_submap->mark_dirty();
         invalidate_max_populated_zlev( p.z );
 
         auto &ch = get_cache( placed_vehicle->sm_pos.z );
@@ -54,6 +54,7 @@
 #include "vpart_position.h"
 #include "profile.h"
 
+static const efftype_id effect_ai_controlled( "ai_controlled" );
 static const efftype_id effect_ai_waiting( "ai_waiting" );
 static const efftype_id effect_bouldering( "bouldering" );
 static const efftype_id effect_countdown( "countdown" );
@@ -67,6 +68,7 @@ static const efftype_id effect_no_sight( "no_sight" );
 static const efftype_id effect_operating( "operating" );
 static const efftype_id effect_pacified( "pacified" );
 static const efftype_id effect_pushed( "pushed" );
+static const efftype_id effect_ridden( "ridden" );
 static const efftype_id effect_stunned( "stunned" );
 static const efftype_id effect_led_by_leash( "led_by_leash" );
 
@@ -334,6 +336,62 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return FLT_MAX;
 }
 
+void monster::collect_sight_queries( std::vector<std::pair<tripoint, tripoint>> &queries ) const
+{
+    if( is_dead() || moves <= 0 || has_effect( effect_ridden ) ||
+        has_effect( effect_ai_controlled ) || has_effect( effect_ai_waiting ) ) {
+        return;
+    }
+    const int max_sight_range = std::max( type->vision_day, type->vision_night );
+    // Same filters as Creature::sees applies before it asks the map for line of sight.
+    const auto add = [&]( const Creature &c ) {
+        const int d = rl_dist( pos(), c.pos() );
+        if( d > 1 && d <= max_sight_range && ( fov_3d || posz() == c.posz() ) &&
+            !c.is_hallucination() ) {
+            queries.emplace_back( pos(), c.pos() );
+        }
+    };
+    const auto add_faction = [&]( const auto & members ) {
+        for( const weak_ptr_fast<monster> &weak : members ) {
+            if( const shared_ptr_fast<monster> shared = weak.lock() ) {
+                add( *shared );
+            }
+        }
+    };
+
+    const auto &factions = g->critter_tracker->factions();
+    const bool docile = friendly != 0 && has_effect( effect_docile );
+    if( friendly != 0 && !docile ) {
+        for( const monster &tmp : g->all_monsters() ) {
+            if( tmp.friendly == 0 ) {
+                add( tmp );
+            }
+        }
+    }
+    for( const npc &who : g->all_npcs() ) {
+        const auto faction_att = faction.obj().attitude( who.get_monster_faction() );
+        // NPCs on this level are looked up in the field of view cast from them instead
+        if( faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY && who.posz() != posz() ) {
+            add( who );
+        }
+    }
+    if( friendly == 0 ) {
+        for( const auto &fac : factions ) {
+            const auto faction_att = faction.obj().attitude( fac.first );
+            if( faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY ) {
+                add_faction( fac.second );
+            }
+        }
+    }
+    const bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
+    if( group_morale || has_flag( MF_SWARMS ) ) {
+        const auto own_faction = factions.find( friendly == 0 ? faction : mfaction_str_id( "player" ) );
+        if( own_faction != factions.end() ) {
+            add_faction( own_faction->second );
+        }
+    }
+}
+
 void monster::plan()
 {
     ZoneScoped;
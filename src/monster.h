@@ -234,6 +234,12 @@ class monster : public Creature, public location_visitable<monster>
         // How good of a target is given creature (checks for visibility)
         float rate_target( Creature &c, float best, bool smart = false ) const;
         void plan();
+        /**
+         * Appends the (own position, target position) pairs whose line of sight @ref plan
+         * is going to check this turn. Does not modify any state, so it can be used to
+         * compute line of sight for all monsters ahead of their turns.
+         */
+        void collect_sight_queries( std::vector<std::pair<tripoint, tripoint>> &queries ) const;
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
         void shove_vehicle( const tripoint &remote_destination,
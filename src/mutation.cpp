@@ -103,12 +103,18 @@ std::string enum_to_string<mutagen_technique>( mutagen_technique data )
 
 bool Character::has_trait( const trait_id &b ) const
 {
+    if( !trait_bits.test( b.id_or( int_id<mutation_branch>( -1 ) ) ) ) {
+        return false;
+    }
     return my_mutations.contains( b ) || enchantment_cache->get_mutations().contains( b );
 }
 
 bool Character::has_one_of_traits( const TraitSet &trait_set ) const
 {
     for( const trait_id &trait : trait_set ) {
+        if( !trait_bits.test( trait.id_or( int_id<mutation_branch>( -1 ) ) ) ) {
+            continue;
+        }
         if( my_mutations.contains( trait ) || enchantment_cache->get_mutations().contains( trait ) ) {
             return true;
         }
@@ -164,10 +170,10 @@ void Character::set_mutation( const trait_id &trait )
         return;
     }
     my_mutations.emplace( trait, char_trait_data{} );
+    invalidate_derived( char_input::mutations );
     rebuild_mutation_cache();
     mutation_effect( trait );
     recalc_sight_limits();
-    reset_encumbrance();
 }
 
 void Character::unset_mutation( const trait_id &trait_ )
@@ -181,10 +187,10 @@ void Character::unset_mutation( const trait_id &trait_ )
         return;
     }
     my_mutations.erase( iter );
+    invalidate_derived( char_input::mutations );
     rebuild_mutation_cache();
     mutation_loss_effect( trait );
     recalc_sight_limits();
-    reset_encumbrance();
 }
 
 void Character::switch_mutations( const trait_id &switched, const trait_id &target,
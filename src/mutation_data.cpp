@@ -51,6 +51,19 @@ bool string_id<mutation_branch>::is_valid() const
     return trait_factory.is_valid( *this );
 }
 
+template<>
+int_id<mutation_branch> string_id<mutation_branch>::id() const
+{
+    return trait_factory.convert( *this, int_id<mutation_branch>( -1 ) );
+}
+
+template<>
+int_id<mutation_branch> string_id<mutation_branch>::id_or(
+    const int_id<mutation_branch> &fallback ) const
+{
+    return trait_factory.is_valid( *this ) ? trait_factory.convert( *this, fallback ) : fallback;
+}
+
 template<>
 bool string_id<Trait_group>::is_valid() const
 {
@@ -18,6 +18,7 @@
 #include "character_martial_arts.h"
 #include "clzones.h"
 #include "coordinate_conversions.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "detached_ptr.h"
@@ -715,19 +716,14 @@ void npc::set_known_to_u( bool known )
 void npc::setpos( const tripoint &pos )
 {
     position = pos;
+    g->critter_tracker->note_changed();
     const point_abs_om pos_om_old( sm_to_om_copy( submap_coords ) );
     submap_coords.x = g->get_levx() + pos.x / SEEX;
     submap_coords.y = g->get_levy() + pos.y / SEEY;
     // TODO: fix point types
     const point_abs_om pos_om_new( sm_to_om_copy( submap_coords ) );
     if( !is_fake() && pos_om_old != pos_om_new ) {
-        overmap &om_old = overmap_buffer.get( pos_om_old );
-        overmap &om_new = overmap_buffer.get( pos_om_new );
-        if( const auto ptr = om_old.erase_npc( getID() ) ) {
-            om_new.insert_npc( ptr );
-        } else {
-            // Don't move the npc pointer around to avoid having two overmaps
-            // with the same npc pointer
+        if( !overmap_buffer.move_npc( getID(), pos_om_new ) ) {
             debugmsg( "could not find npc %s on its old overmap", name );
         }
     }
@@ -736,6 +732,7 @@ void npc::setpos( const tripoint &pos )
 void npc::onswapsetpos( const tripoint &pos )
 {
     position = pos;
+    g->critter_tracker->note_changed();
     submap_coords.x = g->get_levx() + pos.x / SEEX;
     submap_coords.y = g->get_levy() + pos.y / SEEY;
 }
@@ -750,13 +747,7 @@ void npc::travel_overmap( const tripoint &pos )
         reach_omt_destination();
     }
     if( !is_fake() && pos_om_old != pos_om_new ) {
-        overmap &om_old = overmap_buffer.get( pos_om_old );
-        overmap &om_new = overmap_buffer.get( pos_om_new );
-        if( const auto ptr = om_old.erase_npc( getID() ) ) {
-            om_new.insert_npc( ptr );
-        } else {
-            // Don't move the npc pointer around to avoid having two overmaps
-            // with the same npc pointer
+        if( !overmap_buffer.move_npc( getID(), pos_om_new ) ) {
             debugmsg( "could not find npc %s on its old overmap", name );
         }
     }
@@ -775,6 +766,7 @@ void npc::spawn_at_precise( point submap_offset, const tripoint &square )
     position.x = square.x % SEEX;
     position.y = square.y % SEEY;
     position.z = square.z;
+    g->critter_tracker->note_changed();
 }
 
 tripoint npc::global_square_location() const
@@ -879,6 +879,7 @@ int options_manager::cOpt::getMaxLength() const
 //set to next item
 void options_manager::cOpt::setNext()
 {
+    options_manager::mark_changed();
     if( sType == "string_select" ) {
         int iNext = getItemPos( sSet ) + 1;
         if( iNext >= static_cast<int>( vItems.size() ) ) {
@@ -922,6 +923,7 @@ void options_manager::cOpt::setNext()
 //set to previous item
 void options_manager::cOpt::setPrev()
 {
+    options_manager::mark_changed();
     if( sType == "string_select" ) {
         int iPrev = getItemPos( sSet ) - 1;
         if( iPrev < 0 ) {
@@ -964,6 +966,7 @@ void options_manager::cOpt::setValue( float fSetIn )
         debugmsg( "tried to set a float value to a %s option", sType );
         return;
     }
+    options_manager::mark_changed();
     fSet = fSetIn;
     if( fSet < fMin || fSet > fMax ) {
         fSet = fDefault;
@@ -977,6 +980,7 @@ void options_manager::cOpt::setValue( int iSetIn )
         debugmsg( "tried to set an int value to a %s option", sType );
         return;
     }
+    options_manager::mark_changed();
     iSet = iSetIn;
     if( iSet < iMin || iSet > iMax ) {
         iSet = iDefault;
@@ -986,6 +990,7 @@ void options_manager::cOpt::setValue( int iSetIn )
 //set value
 void options_manager::cOpt::setValue( const std::string &sSetIn )
 {
+    options_manager::mark_changed();
     if( sType == "string_select" ) {
         if( getItemPos( sSetIn ) != -1 ) {
             sSet = sSetIn;
@@ -2215,6 +2220,11 @@ void options_manager::add_options_graphics()
          false, COPT_CURSES_HIDE
        );
 
+    add( "BATCHED_TEXT_RENDERING", graphics, translate_marker( "Batch text rendering" ),
+         translate_marker( "If true, draws the text of each window in a single call using a glyph atlas.  Needs a TrueType font.  Requires restart." ),
+         false, COPT_CURSES_HIDE
+       );
+
 #if !defined(__ANDROID__)
     add( "SCALING_FACTOR", graphics, translate_marker( "Display scaling factor" ),
     translate_marker( "Factor by which to scale the game display, 1x means no scaling.  Requires restart." ), {
@@ -3684,6 +3694,7 @@ std::string options_manager::show( bool ingame, const bool world_options_only,
             if( ingame && world_options_changed ) {
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
+            mark_changed();
         }
     }
 
@@ -3824,6 +3835,8 @@ void options_manager::cache_to_globals()
 #if defined(SDL_SOUND)
     sounds::sound_enabled = ::get_option<bool>( "SOUND_ENABLED" );
 #endif
+
+    notify_observers();
 }
 
 bool options_manager::save()
@@ -3868,6 +3881,34 @@ bool options_manager::has_option( const std::string &name ) const
     return options.contains( name );
 }
 
+int options_manager::add_observer( const std::string &name, const std::function<void()> &callback )
+{
+    const std::string value = has_option( name ) ? get_option( name ).getValue( true ) : "";
+    observers.push_back( { next_observer_id, name, value, callback } );
+    return next_observer_id++;
+}
+
+void options_manager::remove_observer( const int id )
+{
+    std::erase_if( observers, [id]( const observer & obs ) {
+        return obs.id == id;
+    } );
+}
+
+void options_manager::notify_observers()
+{
+    for( observer &obs : observers ) {
+        if( !has_option( obs.name ) ) {
+            continue;
+        }
+        std::string value = get_option( obs.name ).getValue( true );
+        if( value != obs.value ) {
+            obs.value = std::move( value );
+            obs.callback();
+        }
+    }
+}
+
 options_manager::cOpt &options_manager::get_option( const std::string &name )
 {
     if( !options.contains( name ) ) {
@@ -3908,4 +3949,6 @@ void options_manager::set_world_options( options_container *options )
     } else {
         world_options = options;
     }
+    mark_changed();
+    notify_observers();
 }
@@ -216,6 +216,29 @@ class options_manager
         /** Check if an option exists? */
         bool has_option( const std::string &name ) const;
 
+        /**
+         * Counter increased whenever any option may have changed value.
+         * Used by @ref option_handle to know when to look its option up again.
+         */
+        static int generation() {
+            return generation_;
+        }
+        /** Invalidates all @ref option_handle values. */
+        static void mark_changed() {
+            generation_++;
+        }
+
+        /**
+         * Calls @p callback whenever option @p name has a different value after
+         * changes are committed: options loaded or saved, world options switched.
+         * @return id to pass to @ref remove_observer.
+         */
+        int add_observer( const std::string &name, const std::function<void()> &callback );
+        /** Stops calling the callback added with id @p id. */
+        void remove_observer( int id );
+        /** Runs the callbacks of observed options that changed since the last call. */
+        void notify_observers();
+
         cOpt &get_option( const std::string &name );
 
         //add hidden external option with value
@@ -266,6 +289,18 @@ class options_manager
         options_container options;
         std::optional<options_container *> world_options;
 
+        static inline int generation_ = 0;
+
+        struct observer {
+            int id;
+            std::string name;
+            // Value of the option when the callback last ran
+            std::string value;
+            std::function<void()> callback;
+        };
+        std::vector<observer> observers;
+        int next_observer_id = 0;
+
         /** Option group. */
         class Group
         {
@@ -369,4 +404,35 @@ inline T get_option( const std::string &name )
     return get_options().get_option( name ).value_as<T>();
 }
 
+/**
+ * Typed handle to an option, for code that reads it often.
+ * The option is looked up by name on first use and again only after options
+ * changed, otherwise reading it costs a single integer comparison.
+ * Declare handles as file statics, like static ids:
+ *
+ *     static const option_handle<bool> option_AUTOSAVE( "AUTOSAVE" );
+ */
+template<typename T>
+class option_handle
+{
+    public:
+        explicit option_handle( const std::string &name ) : name_( name ) { }
 
+        const T &get() const {
+            if( generation_ != options_manager::generation() ) {
+                value_ = get_option<T>( name_ );
+                generation_ = options_manager::generation();
+            }
+            return value_;
+        }
+
+        const std::string &name() const {
+            return name_;
+        }
+
+    private:
+        std::string name_;
+        mutable T value_ = T();
+        // Never equal to a real generation, so the first get() looks the option up
+        mutable int generation_ = -1;
+};
@@ -56,6 +56,7 @@
 #include "overmap_noise.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
+#include "profile.h"
 #include "regional_settings.h"
 #include "rng.h"
 #include "rotatable_symbols.h"
@@ -79,6 +80,8 @@ static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
 
 static const oter_type_str_id oter_type_bridge( "bridge" );
 
+static const option_handle<bool> option_WANDER_SPAWNS( "WANDER_SPAWNS" );
+
 class map_extra;
 
 #define dbg(x) DebugLogFL((x),DC::MapGen)
@@ -2883,6 +2886,8 @@ void overmap::populate( overmap_special_batch &enabled_specials )
     } catch( const std::exception &err ) {
         debugmsg( "overmap %s failed to load: %s", loc.to_string(), err.what() );
     }
+    // Generation and loading write the layers directly
+    bump_terrain_revision();
 }
 
 void overmap::populate()
@@ -2959,7 +2964,12 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = id;
+    oter_id &ter = layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()];
+    if( ter != id ) {
+        ter = id;
+        bump_terrain_revision();
+        mark_dirty();
+    }
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -2978,6 +2988,7 @@ std::string *overmap::join_used_at( const om_pos_dir &p )
     if( it == joins_used.end() ) {
         return nullptr;
     }
+    mark_dirty();
     return &it->second;
 }
 
@@ -2987,50 +2998,63 @@ std::optional<mapgen_arguments> *overmap::mapgen_args( const tripoint_om_omt &p
     if( it == mapgen_args_index.end() ) {
         return nullptr;
     }
+    mark_dirty();
     return &mapgen_arg_storage[it->second];
 }
 
-bool &overmap::seen( const tripoint_om_omt &p )
+bool overmap::seen( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+        return false;
     }
     return layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
 }
 
-bool overmap::seen( const tripoint_om_omt &p ) const
+void overmap::set_seen( const tripoint_om_omt &p, bool seen )
 {
     if( !inbounds( p ) ) {
-        return false;
+        return;
+    }
+    bool &visible = layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
+    if( visible != seen ) {
+        visible = seen;
+        bump_revision();
+        mark_view_dirty();
     }
-    return layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
 }
 
-bool &overmap::explored( const tripoint_om_omt &p )
+bool overmap::is_explored( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+        return false;
     }
     return layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
 }
 
-bool overmap::is_explored( const tripoint_om_omt &p ) const
+void overmap::set_explored( const tripoint_om_omt &p, bool explored )
 {
     if( !inbounds( p ) ) {
-        return false;
+        return;
+    }
+    bool &was_explored = layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
+    if( was_explored != explored ) {
+        was_explored = explored;
+        bump_revision();
+        mark_view_dirty();
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
 }
 
-bool &overmap::path( const tripoint_om_omt &p )
+void overmap::set_path( const tripoint_om_omt &p, bool path )
 {
     if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+        return;
+    }
+    bool &is_path = layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
+    if( is_path != path ) {
+        is_path = path;
+        bump_terrain_revision();
+        mark_view_dirty();
     }
-    return layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
 }
 
 bool overmap::is_path( const tripoint_om_omt &p ) const
@@ -3071,6 +3095,7 @@ bool overmap::monster_check( const std::pair<tripoint_om_sm, monster> &candidate
 void overmap::insert_npc( const shared_ptr_fast<npc> &who )
 {
     npcs.push_back( who );
+    mark_dirty();
     g->set_npcs_dirty();
 }
 
@@ -3085,6 +3110,7 @@ shared_ptr_fast<npc> overmap::erase_npc( const character_id &id )
     }
     auto ptr = *iter;
     npcs.erase( iter );
+    mark_dirty();
     g->set_npcs_dirty();
     return ptr;
 }
@@ -3193,6 +3219,7 @@ void overmap::add_note( const tripoint_om_omt &p, std::string message )
         return n.p == p.xy();
     } );
 
+    mark_view_dirty();
     if( it == std::end( notes ) ) {
         notes.emplace_back( om_note{ std::move( message ), p.xy() } );
     } else if( !message.empty() ) {
@@ -3208,6 +3235,7 @@ void overmap::mark_note_dangerous( const tripoint_om_omt &p, int radius, bool is
         if( p.xy() == i.p ) {
             i.dangerous = is_dangerous;
             i.danger_radius = radius;
+            mark_view_dirty();
             return;
         }
     }
@@ -3274,6 +3302,7 @@ void overmap::add_extra( const tripoint_om_omt &p, const string_id<map_extra> &i
         return n.p == p.xy();
     } );
 
+    mark_view_dirty();
     if( it == std::end( extras ) ) {
         extras.emplace_back( om_map_extra{ id, p.xy() } );
     } else if( !id.is_null() ) {
@@ -3328,6 +3357,7 @@ void overmap::set_scent( const tripoint_abs_omt &loc, const scent_trace &new_sce
 {
     // TODO: increase strength of scent trace when applied repeatedly in a short timespan.
     scents[loc] = new_scent;
+    mark_dirty();
 }
 
 void overmap::generate( const overmap *north, const overmap *east,
@@ -3499,9 +3529,10 @@ void overmap::process_mongroups()
         if( mg.dying ) {
             mg.population = ( mg.population * 4 ) / 5;
             mg.radius = ( mg.radius * 9 ) / 10;
+            mark_dirty();
         }
         if( mg.empty() ) {
-            zg.erase( it++ );
+            it = erase_mon_group( it );
         } else {
             ++it;
         }
@@ -3511,19 +3542,24 @@ void overmap::process_mongroups()
 void overmap::clear_mon_groups()
 {
     zg.clear();
+    hordes.clear();
+    mark_dirty();
 }
 
 void overmap::clear_overmap_special_placements()
 {
     overmap_special_placements.clear();
+    mark_dirty();
 }
 void overmap::clear_cities()
 {
     cities.clear();
+    mark_dirty();
 }
 void overmap::clear_connections_out()
 {
     connections_out.clear();
+    mark_dirty();
 }
 
 static std::map<std::string, std::string> oter_id_migrations;
@@ -3566,6 +3602,7 @@ void overmap::migrate_oter_ids( const std::unordered_map<tripoint_om_omt, std::s
                                           << " to '" << new_id.str() << "'";
 
             ter_set( pos, new_id );
+            migrated_on_load = true;
         } else {
             debugmsg( "oter_id migration defined from '%s' to invalid ter_id '%s'", old_id, new_id.str() );
         }
@@ -3611,15 +3648,133 @@ void mongroup::wander( const overmap &om )
     }
 }
 
+int horde_grid::cell_index( const point_om_sm &p )
+{
+    const int x = std::clamp( p.x() / cell_size, 0, cells_per_side - 1 );
+    const int y = std::clamp( p.y() / cell_size, 0, cells_per_side - 1 );
+    return x * cells_per_side + y;
+}
+
+bool horde_grid::remove_from( cell &c, const mongroup &group )
+{
+    const auto found = std::ranges::find( c.groups, &group );
+    if( found == c.groups.end() ) {
+        return false;
+    }
+    const size_t i = found - c.groups.begin();
+    c.groups[i] = c.groups.back();
+    c.positions[i] = c.positions.back();
+    c.groups.pop_back();
+    c.positions.pop_back();
+    return true;
+}
+
+void horde_grid::clear()
+{
+    cells.clear();
+    count = 0;
+}
+
+void horde_grid::insert( mongroup &group )
+{
+    if( cells.empty() ) {
+        cells.resize( cells_per_side * cells_per_side );
+    }
+    cell &c = cells[cell_index( group.pos.xy() )];
+    c.positions.push_back( group.pos );
+    c.groups.push_back( &group );
+    count++;
+}
+
+void horde_grid::erase( const mongroup &group )
+{
+    if( cells.empty() ) {
+        return;
+    }
+    if( remove_from( cells[cell_index( group.pos.xy() )], group ) ) {
+        count--;
+        return;
+    }
+    // Position was changed without telling us, look everywhere
+    for( cell &c : cells ) {
+        if( remove_from( c, group ) ) {
+            count--;
+            return;
+        }
+    }
+}
+
+void horde_grid::move( mongroup &group, const tripoint_om_sm &from )
+{
+    if( cells.empty() ) {
+        return;
+    }
+    cell &old_cell = cells[cell_index( from.xy() )];
+    if( cell_index( from.xy() ) == cell_index( group.pos.xy() ) ) {
+        const auto found = std::ranges::find( old_cell.groups, &group );
+        if( found != old_cell.groups.end() ) {
+            old_cell.positions[found - old_cell.groups.begin()] = group.pos;
+            return;
+        }
+    }
+    erase( group );
+    insert( group );
+}
+
+std::vector<mongroup *> horde_grid::in_range( const tripoint_om_sm &center, const int range ) const
+{
+    std::vector<mongroup *> result;
+    if( cells.empty() || range < 0 ) {
+        return result;
+    }
+    // Groups outside the bounds sit in the edge cells, so clamping the cell range still covers them
+    const auto cell_of = [&]( int v ) {
+        return std::clamp( divide_round_to_minus_infinity( v, cell_size ), 0, cells_per_side - 1 );
+    };
+    const int min_x = cell_of( center.x() - range );
+    const int max_x = cell_of( center.x() + range );
+    const int min_y = cell_of( center.y() - range );
+    const int max_y = cell_of( center.y() + range );
+    for( int x = min_x; x <= max_x; x++ ) {
+        for( int y = min_y; y <= max_y; y++ ) {
+            const cell &c = cells[x * cells_per_side + y];
+            for( size_t i = 0; i < c.positions.size(); i++ ) {
+                if( rl_dist( center, c.positions[i] ) <= range ) {
+                    result.push_back( c.groups[i] );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+void overmap::insert_mon_group( const mongroup &group )
+{
+    mongroup &inserted = zg.emplace( group.pos, group )->second;
+    if( inserted.horde ) {
+        hordes.insert( inserted );
+    }
+    mark_dirty();
+}
+
+overmap::mongroup_iterator overmap::erase_mon_group( mongroup_iterator it )
+{
+    if( it->second.horde ) {
+        hordes.erase( it->second );
+    }
+    mark_dirty();
+    return zg.erase( it );
+}
+
 void overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
+    ZoneScoped;
+    // Moved hordes are re-keyed after the loop so they can't be moved twice.
+    std::vector<mongroup_iterator> moved;
     //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
         mongroup &mg = it->second;
         if( !mg.horde ) {
-            ++it;
             continue;
         }
 
@@ -3629,6 +3784,7 @@ void overmap::move_hordes()
 
         // Gradually decrease interest.
         mg.dec_interest( 1 );
+        mark_dirty();
 
         if( ( mg.pos.xy() == mg.target.xy() ) || mg.interest <= 15 ) {
             mg.wander( *this );
@@ -3654,6 +3810,7 @@ void overmap::move_hordes()
         // frequently. The average horde speed for regular Z's is around 100,
         // or one space per 5 minutes.
         if( one_in( movement_chance ) && rng( 0, 100 ) < mg.interest && rng( 0, 200 ) < mg.avg_speed() ) {
+            const tripoint_om_sm old_pos = mg.pos;
             // TODO: Handle moving to adjacent overmaps.
             if( mg.pos.x() > mg.target.x() ) {
                 mg.pos.x()--;
@@ -3668,17 +3825,18 @@ void overmap::move_hordes()
                 mg.pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint_om_sm, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
+            hordes.move( mg, old_pos );
+            moved.push_back( it );
         }
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    // Re-key the moved groups in place, the nodes (and pointers to them) stay valid.
+    for( const mongroup_iterator &it : moved ) {
+        auto node = zg.extract( it );
+        node.key() = node.mapped().pos;
+        zg.insert( std::move( node ) );
+    }
 
-    if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+    if( option_WANDER_SPAWNS.get() ) {
 
         // Re-absorb zombies into hordes.
         // Scan over monsters outside the player's view and place them back into hordes.
@@ -3745,6 +3903,7 @@ void overmap::move_hordes()
 
             // Delete the monster, continue iterating.
             monster_map_it = monster_map->erase( monster_map_it );
+            mark_dirty();
         }
     }
 }
@@ -3755,16 +3914,11 @@ void overmap::move_hordes()
 */
 void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 {
+    ZoneScoped;
     tripoint_om_sm p( p_rel.raw() );
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
-        if( !mg.horde ) {
-            continue;
-        }
+    for( mongroup *group : hordes.in_range( p, sig_power ) ) {
+        mongroup &mg = *group;
         const int dist = rl_dist( p, mg.pos );
-        if( sig_power < dist ) {
-            continue;
-        }
         // TODO: base this in monster attributes, foremost GOODHEARING.
         const int inter_per_sig_power = 15; //Interest per signal value
         const int min_initial_inter = 30; //Min initial interest for horde
@@ -3773,6 +3927,7 @@ void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
         // Minimum capped calculated interest. Used to give horde enough interest to really investigate the target at start.
         const int min_capped_inter = std::max( min_initial_inter, calculated_inter );
         if( roll < min_capped_inter ) { //Rolling if horde interested in new signal
+            mark_dirty();
             // TODO: Z-coordinate for mongroup targets
             const int targ_dist = rl_dist( p, mg.target );
             // TODO: Base this on targ_dist:dist ratio.
@@ -5568,6 +5723,7 @@ std::vector<tripoint_om_omt> overmap::place_special(
     if( special.has_flag( "GLOBALLY_UNIQUE" ) ) {
         overmap_buffer.add_unique_special( special.id );
     }
+    mark_dirty();
 
     const bool grid = special.has_flag( "ELECTRIC_GRID" );
 
@@ -6191,6 +6347,11 @@ void overmap::open( overmap_special_batch &enabled_specials )
             overmap::unserialize_view( fin, string_format( "overmap visibility %d.%d", loc.x(), loc.y() ) );
         };
         g->get_active_world()->read_overmap_player_visibility( loc, plr_reader );
+        // Reading goes through the setters, what was read is already in the save.
+        mark_saved();
+        if( migrated_on_load ) {
+            mark_dirty();
+        }
     } else { // No map exists!  Prepare neighbors, and generate one.
         std::vector<const overmap *> pointers;
         // Fetch south and north
@@ -6210,13 +6371,32 @@ void overmap::open( overmap_special_batch &enabled_specials )
 // Note: this may throw io errors from std::ofstream
 void overmap::save() const
 {
-    g->get_active_world()->write_overmap_player_visibility( loc, [&]( std::ostream & stream ) {
-        serialize_view( stream );
-    } );
+    world *w = g->get_active_world();
 
-    g->get_active_world()->write_overmap( loc, [&]( std::ostream & stream ) {
-        serialize( stream );
-    } );
+    // A write whose save transaction didn't commit is not in the save
+    if( view_generation != saved_view_generation || !w->save_tx_committed( saved_view_tx ) ) {
+        w->write_overmap_player_visibility( loc, [&]( std::ostream & stream ) {
+            serialize_view( stream );
+        } );
+        saved_view_generation = view_generation;
+        saved_view_tx = w->current_save_tx();
+    }
+
+    if( is_dirty() || !w->save_tx_committed( saved_tx ) ) {
+        w->write_overmap( loc, [&]( std::ostream & stream ) {
+            serialize( stream );
+        } );
+        saved_generation = generation;
+        saved_tx = w->current_save_tx();
+    }
+}
+
+void overmap::mark_saved() const
+{
+    saved_generation = generation;
+    saved_view_generation = view_generation;
+    saved_tx = 0;
+    saved_view_tx = 0;
 }
 
 void overmap::add_mon_group( const mongroup &group )
@@ -6226,7 +6406,7 @@ void overmap::add_mon_group( const mongroup &group )
     // makes the diffuse setting obsolete (as it only controls how the radius
     // is interpreted) - it's only used when adding monster groups with function.
     if( group.radius == 1 ) {
-        zg.insert( std::pair<tripoint_om_sm, mongroup>( group.pos, group ) );
+        insert_mon_group( group );
         return;
     }
     // diffuse groups use a circular area, non-diffuse groups use a rectangular area
@@ -6332,12 +6512,14 @@ void overmap::set_electric_grid_connections( const tripoint_om_omt &p,
         const std::bitset<six_cardinal_directions.size()> &connections )
 {
     electric_grid_connections[p] = connections;
+    mark_dirty();
     for( size_t i = 0; i < six_cardinal_directions.size(); i++ ) {
         tripoint_om_omt other_p = p + six_cardinal_directions[i];
         tripoint_abs_omt other_p_global = project_combine( pos(), other_p );
         overmap_with_local_coords other = overmap_buffer.get_om_global( other_p_global );
         size_t opposite_direction = i + ( ( i % 2 ) ? -1 : 1 );
         other.om->electric_grid_connections[other.local][opposite_direction] = connections[i];
+        other.om->mark_dirty();
     }
 }
 
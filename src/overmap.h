@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -260,6 +262,43 @@ struct overmap_connection_cache {
     void add( const overmap_connection_id &id, const int z, const point_om_omt &pos );
 };
 
+/**
+ * Coarse spatial index over the hordes of a single overmap.
+ * Each cell keeps the positions of its hordes in a flat array next to pointers
+ * into @ref overmap::zg, so range queries only scan the cells they overlap.
+ * Groups outside the overmap bounds are kept in the nearest edge cell.
+ */
+class horde_grid
+{
+    public:
+        /** Side of a cell, in submaps. */
+        static constexpr int cell_size = 12;
+
+        void clear();
+        void insert( mongroup &group );
+        void erase( const mongroup &group );
+        /** Updates the index after @p group moved away from @p from. */
+        void move( mongroup &group, const tripoint_om_sm &from );
+        /** Hordes within @p range (as in rl_dist) of @p center. */
+        std::vector<mongroup *> in_range( const tripoint_om_sm &center, int range ) const;
+        size_t size() const {
+            return count;
+        }
+
+    private:
+        struct cell {
+            std::vector<tripoint_om_sm> positions;
+            std::vector<mongroup *> groups;
+        };
+        static constexpr int cells_per_side = ( OMAPX * 2 + cell_size - 1 ) / cell_size;
+        static int cell_index( const point_om_sm &p );
+        static bool remove_from( cell &c, const mongroup &group );
+
+        // Allocated on first insert, overmaps without hordes don't pay for it
+        std::vector<cell> cells;
+        size_t count = 0;
+};
+
 class overmap
 {
     public:
@@ -277,7 +316,41 @@ class overmap
             return loc;
         }
 
+        /**
+         * Writes the overmap and the player's view of it. Either part is skipped when it
+         * did not change since it was last written, unless that write was in a save
+         * transaction that failed to commit.
+         */
         void save() const;
+        /**
+         * Marks the overmap as changed, for changes made to it from outside
+         * (e.g. by the overmapbuffer), so it is written on the next save.
+         */
+        void mark_dirty() {
+            generation++;
+        }
+        /**
+         * Whether the overmap changed since it was last written. NPCs are changed in
+         * place by the game, so an overmap holding any is always dirty.
+         */
+        bool is_dirty() const {
+            return generation != saved_generation || !npcs.empty();
+        }
+
+        /**
+         * Changes whenever the terrain or the seen/explored state of a tile changes.
+         * Revisions are unique among all overmaps, a reloaded overmap never repeats one.
+         */
+        int64_t get_revision() const {
+            return revision;
+        }
+        /**
+         * Changes whenever the terrain or the path flag of a tile changes.
+         * Unique among all overmaps like @ref get_revision.
+         */
+        int64_t get_terrain_revision() const {
+            return terrain_revision;
+        }
 
         /**
          * @return The (local) overmap terrain coordinates of a randomly
@@ -301,11 +374,11 @@ class overmap
         const oter_id &ter( const tripoint_om_omt &p ) const;
         std::string *join_used_at( const om_pos_dir & );
         std::optional<mapgen_arguments> *mapgen_args( const tripoint_om_omt & );
-        bool &seen( const tripoint_om_omt &p );
         bool seen( const tripoint_om_omt &p ) const;
-        bool &explored( const tripoint_om_omt &p );
+        void set_seen( const tripoint_om_omt &p, bool seen );
         bool is_explored( const tripoint_om_omt &p ) const;
-        bool &path( const tripoint_om_omt &p );
+        void set_explored( const tripoint_om_omt &p, bool explored );
+        void set_path( const tripoint_om_omt &p, bool path );
         bool is_path( const tripoint_om_omt &p ) const;
 
         bool has_note( const tripoint_om_omt &p ) const;
@@ -374,6 +447,12 @@ class overmap
             return *settings;
         }
 
+        /**
+         * Adds a monster group. Groups with a radius other than 1 are split into groups
+         * of radius 1 spread over the area, which may lie outside this overmap; the
+         * overmapbuffer moves those when loading. Hordes are added to the horde index.
+         */
+        void add_mon_group( const mongroup &group );
         void clear_mon_groups();
         void clear_overmap_special_placements();
         void clear_cities();
@@ -382,6 +461,12 @@ class overmap
                                    om_direction::type dir );
     private:
         std::multimap<tripoint_om_sm, mongroup> zg;
+        // Index of the hordes in zg, must be updated whenever zg is
+        horde_grid hordes;
+
+        using mongroup_iterator = std::multimap<tripoint_om_sm, mongroup>::iterator;
+        void insert_mon_group( const mongroup &group );
+        mongroup_iterator erase_mon_group( mongroup_iterator it );
     public:
         /** Unit test enablers to check if a given mongroup is present. */
         bool mongroup_check( const mongroup &candidate ) const;
@@ -402,6 +487,8 @@ class overmap
         std::map<overmap_connection_id, std::vector<tripoint_om_omt>> connections_out;
         std::optional<overmap_connection_cache> connection_cache;
         /// Adds the npc to the contained list of npcs ( @ref npcs ).
+        /// Overmaps in the overmapbuffer must go through its insert_npc / move_npc / remove_npc,
+        /// which keep its NPC index up to date.
         void insert_npc( const shared_ptr_fast<npc> &who );
         /// Removes the npc and returns it ( or returns nullptr if not found ).
         shared_ptr_fast<npc> erase_npc( const character_id &id );
@@ -423,9 +510,36 @@ class overmap
 
         std::vector<shared_ptr_fast<npc>> npcs;
 
-        bool nullbool = false;
+        // Bumped whenever the data written by serialize() / serialize_view() changes.
+        uint32_t generation = 1;
+        uint32_t view_generation = 1;
+        // Generations as of the last write, and the save transaction it was made in.
+        mutable uint32_t saved_generation = 0;
+        mutable uint32_t saved_view_generation = 0;
+        mutable uint64_t saved_tx = 0;
+        mutable uint64_t saved_view_tx = 0;
+        // Set when terrain ids were migrated while reading, the stored data is outdated.
+        bool migrated_on_load = false;
+
+        void mark_view_dirty() {
+            view_generation++;
+        }
+        void mark_saved() const;
+
         point_abs_om loc;
 
+        // Overmaps are generated in parallel, see overmapbuffer::generate
+        static inline std::atomic<int64_t> last_revision = 0;
+        int64_t revision = last_revision.fetch_add( 1 ) + 1;
+        void bump_revision() {
+            revision = last_revision.fetch_add( 1 ) + 1;
+        }
+        int64_t terrain_revision = revision;
+        void bump_terrain_revision() {
+            bump_revision();
+            terrain_revision = revision;
+        }
+
         std::array<map_layer, OVERMAP_LAYERS> layer;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
 
@@ -571,8 +685,6 @@ class overmap
         void place_mongroups();
         void place_radios();
 
-        void add_mon_group( const mongroup &group );
-
         void load_monster_groups( JsonIn &jsin );
         void load_legacy_monstergroups( JsonIn &jsin );
         void save_monster_groups( JsonOut &jo ) const;
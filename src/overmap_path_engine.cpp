@@ -0,0 +1,773 @@
+#include "overmap_path_engine.h"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "int_id.h"
+#include "line.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "point.h"
+
+namespace
+{
+
+// Cells at the overmap border where the road graph starts and ends
+constexpr int road_graph_min_z = 0;
+constexpr int road_graph_max_z = 1;
+constexpr int road_graph_levels = road_graph_max_z - road_graph_min_z + 1;
+
+// Maximal number of cells scored by a single search
+constexpr size_t max_search_count = 200000;
+
+omt_travel_class classify( const oter_id &oter )
+{
+    if( is_ot_match( "road", oter, ot_match_type::type ) ||
+        is_ot_match( "bridge", oter, ot_match_type::type ) ||
+        is_ot_match( "bridge_road", oter, ot_match_type::type ) ||
+        is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
+        is_ot_match( "bridgehead_ramp", oter, ot_match_type::type ) ||
+        is_ot_match( "road_nesw_manhole", oter, ot_match_type::type ) ) {
+        return omt_travel_class::road;
+    } else if( is_ot_match( "field", oter, ot_match_type::type ) ) {
+        return omt_travel_class::field;
+    } else if( is_ot_match( "rural_road", oter, ot_match_type::prefix ) ||
+               is_ot_match( "dirt_road", oter, ot_match_type::prefix ) ||
+               is_ot_match( "subway", oter, ot_match_type::type ) ||
+               is_ot_match( "lab_subway", oter, ot_match_type::type ) ) {
+        return omt_travel_class::dirt_road;
+    } else if( is_ot_match( "forest_trail", oter, ot_match_type::type ) ) {
+        return omt_travel_class::trail;
+    } else if( is_ot_match( "forest_water", oter, ot_match_type::type ) ) {
+        return omt_travel_class::swamp;
+    } else if( is_ot_match( "river", oter, ot_match_type::prefix ) ||
+               is_ot_match( "lake", oter, ot_match_type::prefix ) ) {
+        if( is_ot_match( "river_center", oter, ot_match_type::type ) ||
+            is_ot_match( "lake_surface", oter, ot_match_type::type ) ) {
+            return omt_travel_class::water;
+        } else {
+            return omt_travel_class::shore;
+        }
+    } else if( is_ot_match( "bridge_under", oter, ot_match_type::type ) ) {
+        return omt_travel_class::water;
+    } else if( is_ot_match( "open_air", oter, ot_match_type::type ) ) {
+        return omt_travel_class::air;
+    } else if( is_ot_match( "forest", oter, ot_match_type::type ) ) {
+        return omt_travel_class::forest;
+    } else if( is_ot_match( "empty_rock", oter, ot_match_type::type ) ||
+               is_ot_match( "deep_rock", oter, ot_match_type::type ) ||
+               is_ot_match( "solid_earth", oter, ot_match_type::type ) ||
+               is_ot_match( "microlab_rock_border", oter, ot_match_type::type ) ) {
+        return omt_travel_class::impassable;
+    } else {
+        return omt_travel_class::other;
+    }
+}
+
+bool is_ramp( const oter_id &oter )
+{
+    return is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
+           is_ot_match( "bridgehead_ramp", oter, ot_match_type::type );
+}
+
+int class_cost( omt_travel_class travel_class, const overmap_path_params &params )
+{
+    switch( travel_class ) {
+        case omt_travel_class::road:
+            return params.road_cost;
+        case omt_travel_class::field:
+            return params.field_cost;
+        case omt_travel_class::dirt_road:
+            return params.dirt_road_cost;
+        case omt_travel_class::trail:
+            return params.trail_cost;
+        case omt_travel_class::swamp:
+            return params.swamp_cost;
+        case omt_travel_class::water:
+            return params.water_cost;
+        case omt_travel_class::shore:
+            return params.shore_cost;
+        case omt_travel_class::air:
+            return params.air_cost;
+        case omt_travel_class::forest:
+            return params.forest_cost;
+        case omt_travel_class::other:
+            return params.other_cost;
+        case omt_travel_class::impassable:
+        case omt_travel_class::num_classes:
+            break;
+    }
+    return -1;
+}
+
+// Steps between cells, the first four are horizontal
+constexpr std::array<tripoint, 6> steps = {
+    tripoint_east, tripoint_south, tripoint_west, tripoint_north, tripoint_above, tripoint_below
+};
+constexpr std::array<int8_t, 6> reverse_steps = { 2, 3, 0, 1, 5, 4 };
+constexpr int8_t no_step = -1;
+
+int num_steps( bool allow_z_change )
+{
+    return allow_z_change ? 6 : 4;
+}
+
+bool is_horizontal( int8_t step )
+{
+    return step >= 0 && step < 4;
+}
+
+// Same cost model as pf::find_overmap_path: cutting a corner costs less than going straight
+int adjust_omt_cost( int base_cost, int8_t step_in, int8_t step_out )
+{
+    if( step_in != step_out && is_horizontal( step_in ) && is_horizontal( step_out ) ) {
+        return base_cost * 99 / 140;
+    }
+    return base_cost;
+}
+
+// Step that leads from one cell to an adjacent one, no_step if they aren't adjacent
+int8_t step_between( const tripoint_abs_omt &from, const tripoint_abs_omt &to )
+{
+    const tripoint d = ( to - from ).raw();
+    for( int8_t step = 0; step < static_cast<int8_t>( steps.size() ); step++ ) {
+        if( steps[step] == d ) {
+            return step;
+        }
+    }
+    return no_step;
+}
+
+// Lowest cost any path from src to dest can have if no cell costs less than min_cost.
+// A path turns at most twice per step along its shorter axis, and turning makes a cell
+// cheaper, see adjust_omt_cost. Detours add more turns, but when a turn costs at least
+// half a cell they still add more than they save.
+int min_path_cost( const tripoint_abs_omt &src, const tripoint_abs_omt &dest, int min_cost )
+{
+    const int dx = std::abs( dest.x() - src.x() );
+    const int dy = std::abs( dest.y() - src.y() );
+    const int dz = std::abs( dest.z() - src.z() );
+    // Neither the source nor the destination are paid for
+    const int charged = std::max( dx + dy + dz - 1, 0 );
+    const int turn_cost = adjust_omt_cost( min_cost, 0, 1 );
+    if( turn_cost * 2 < min_cost ) {
+        return charged * turn_cost;
+    }
+    const int turns = std::min( 2 * std::min( dx, dy ), charged );
+    return turns * turn_cost + ( charged - turns ) * min_cost;
+}
+
+bool valid_z( int z )
+{
+    return z >= -OVERMAP_DEPTH && z <= OVERMAP_HEIGHT;
+}
+
+tripoint_abs_omt to_global( const point_abs_om &om, const tripoint_om_omt &local )
+{
+    return tripoint_abs_omt( project_combine( om, local.xy() ), local.z() );
+}
+
+} // namespace
+
+/**
+ * A single search over the travel grids. Nodes live in dense arrays, one per
+ * overmap z-level, which are allocated when the search first reaches them.
+ */
+class overmap_path_engine::search
+{
+    public:
+        struct node {
+            int32_t cost = INT32_MAX;
+            int16_t node_cost = 0;
+            // Step towards the previous node of the path
+            int8_t prev_step = no_step;
+            bool allow_z_change = false;
+            bool scored = false;
+            bool rejected = false;
+            bool closed = false;
+        };
+
+        search( overmap_path_engine &engine, overmapbuffer &buffer, const overmap_path_params &params )
+            : engine( engine ), buffer( buffer ), params( params ) {
+            for( size_t i = 0; i < costs.size(); i++ ) {
+                costs[i] = class_cost( static_cast<omt_travel_class>( i ), params );
+            }
+        }
+
+        /**
+         * Scores the cell at p, returns false if it can't be traversed.
+         */
+        bool score( const tripoint_abs_omt &p, int &cost, bool &ramp ) {
+            point_om_omt local;
+            page &pg = get_page( p, local );
+            const uint8_t cell = ( *pg.cells )[local.y() * OMAPX + local.x()];
+            cost = costs[cell & ~ramp_bit];
+            ramp = ( cell & ramp_bit ) != 0;
+            if( cost < 0 ) {
+                return false;
+            }
+            const tripoint_om_omt local_z( local, p.z() );
+            if( params.only_known_by_player && ( pg.om == nullptr || !pg.om->seen( local_z ) ) ) {
+                return false;
+            }
+            if( params.avoid_danger && pg.om != nullptr && pg.om->is_marked_dangerous( local_z ) ) {
+                return false;
+            }
+            return true;
+        }
+
+        node &at( const tripoint_abs_omt &p ) {
+            point_om_omt local;
+            page &pg = get_page( p, local );
+            if( pg.nodes.empty() ) {
+                pg.nodes.resize( cells_per_level );
+            }
+            return pg.nodes[local.y() * OMAPX + local.x()];
+        }
+
+        /**
+         * Expands nodes from start. With a destination this is A* that stops once the
+         * destination is reached, limited to radius OMTs around start. Without one it's
+         * Dijkstra that visits every reachable cell of the overmap containing start.
+         * Returns whether dest was reached.
+         */
+        bool expand( const tripoint_abs_omt &start, const tripoint_abs_omt *dest, int radius ) {
+            using scored_address = std::pair<int, tripoint_abs_omt>;
+            std::priority_queue<scored_address, std::vector<scored_address>, std::greater<>> open_set;
+            const point_abs_om start_om = project_to<coords::om>( start.xy() );
+
+            int start_cost = 0;
+            bool start_ramp = false;
+            score( start, start_cost, start_ramp );
+            node &first = at( start );
+            first.cost = 0;
+            first.scored = true;
+            first.allow_z_change = start_ramp;
+            open_set.emplace( 0, start );
+            size_t search_count = 0;
+
+            while( !open_set.empty() ) {
+                const tripoint_abs_omt cur_addr = open_set.top().second;
+                open_set.pop();
+                node &cur = at( cur_addr );
+                if( cur.closed ) {
+                    continue;
+                }
+                cur.closed = true;
+                if( dest != nullptr && cur_addr == *dest ) {
+                    return true;
+                }
+                for( int8_t step = 0; step < num_steps( cur.allow_z_change ); step++ ) {
+                    if( step == cur.prev_step ) {
+                        continue; // don't go back the way we just came
+                    }
+                    const tripoint_abs_omt next_addr = cur_addr + steps[step];
+                    if( !valid_z( next_addr.z() ) ) {
+                        continue;
+                    }
+                    if( dest != nullptr ) {
+                        if( octile_dist( start.xy(), next_addr.xy() ) > radius ) {
+                            continue;
+                        }
+                    } else if( project_to<coords::om>( next_addr.xy() ) != start_om ) {
+                        continue;
+                    }
+                    node &next = at( next_addr );
+                    if( next.closed || next.rejected ) {
+                        continue;
+                    }
+                    if( !next.scored ) {
+                        if( search_count >= max_search_count ) {
+                            continue;
+                        }
+                        search_count++;
+                        int next_cost = 0;
+                        bool next_ramp = false;
+                        next.scored = true;
+                        if( !score( next_addr, next_cost, next_ramp ) ) {
+                            next.rejected = true;
+                            continue;
+                        }
+                        next.node_cost = static_cast<int16_t>( next_cost );
+                        next.allow_z_change = next_ramp;
+                    }
+                    const int8_t rev_step = reverse_steps[step];
+                    const int cumulative_cost = cur.cost + adjust_omt_cost( cur.node_cost, rev_step,
+                                                cur.prev_step );
+                    if( next.cost <= cumulative_cost ) {
+                        continue;
+                    }
+                    next.cost = cumulative_cost;
+                    next.prev_step = rev_step;
+                    int estimate = cumulative_cost + next.node_cost;
+                    if( dest != nullptr ) {
+                        estimate += octile_dist( next_addr.xy(), dest->xy(), 10 ) +
+                                    std::abs( next_addr.z() - dest->z() ) * 10;
+                    }
+                    open_set.emplace( estimate, next_addr );
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Cost @ref expand would give the path, which runs from the start to the end
+         * of the vector. Returns -1 if a cell of it can't be traversed.
+         */
+        int path_cost( const std::vector<tripoint_abs_omt> &path ) {
+            int total = 0;
+            for( size_t i = 1; i < path.size(); i++ ) {
+                int cell_cost = 0;
+                bool ramp = false;
+                if( !score( path[i], cell_cost, ramp ) ) {
+                    return -1;
+                }
+                if( i + 1 < path.size() ) {
+                    total += adjust_omt_cost( cell_cost, step_between( path[i + 1], path[i] ),
+                                              step_between( path[i], path[i - 1] ) );
+                }
+            }
+            return total;
+        }
+
+        /** Lowest cost of a cell that can be traversed, -1 if there is none. */
+        int min_cell_cost() const {
+            int result = -1;
+            for( const int cost : costs ) {
+                if( cost >= 0 && ( result < 0 || cost < result ) ) {
+                    result = cost;
+                }
+            }
+            return result;
+        }
+
+        /** Returns whether the expansion reached p. */
+        bool reached( const tripoint_abs_omt &p ) {
+            return at( p ).closed;
+        }
+
+        /** Path from p back to the start of the expansion, both inclusive. */
+        std::vector<tripoint_abs_omt> path_to( const tripoint_abs_omt &p ) {
+            std::vector<tripoint_abs_omt> ret;
+            tripoint_abs_omt addr = p;
+            ret.push_back( addr );
+            while( at( addr ).prev_step != no_step ) {
+                addr += steps[at( addr ).prev_step];
+                ret.push_back( addr );
+            }
+            return ret;
+        }
+
+    private:
+        struct page {
+            const overmap *om = nullptr;
+            const std::vector<uint8_t> *cells = nullptr;
+            std::vector<node> nodes;
+        };
+
+        page &get_page( const tripoint_abs_omt &p, point_om_omt &local ) {
+            point_abs_om om_pos;
+            std::tie( om_pos, local ) = project_remain<coords::om>( p.xy() );
+            const tripoint key( om_pos.raw(), p.z() );
+            if( last_page != nullptr && key == last_key ) {
+                return *last_page;
+            }
+            auto iter = pages.find( key );
+            if( iter == pages.end() ) {
+                iter = pages.emplace( key, page() ).first;
+                page &pg = iter->second;
+                pg.om = buffer.get_existing( om_pos );
+                pg.cells = &engine.get_cells( om_pos, pg.om, p.z() );
+            }
+            last_key = key;
+            last_page = &iter->second;
+            return *last_page;
+        }
+
+        overmap_path_engine &engine;
+        overmapbuffer &buffer;
+        const overmap_path_params &params;
+        std::array<int, static_cast<size_t>( omt_travel_class::num_classes )> costs;
+        std::unordered_map<tripoint, page> pages;
+        tripoint last_key;
+        page *last_page = nullptr;
+};
+
+uint8_t overmap_path_engine::get_cell( const oter_id &oter )
+{
+    static constexpr uint8_t unknown = 0xff;
+    const size_t count = overmap_terrains::get_all().size();
+    if( oter_cells.size() != count ) {
+        oter_cells.assign( count, unknown );
+    }
+    const size_t i = static_cast<size_t>( oter.to_i() );
+    if( i >= count ) {
+        return static_cast<uint8_t>( classify( oter ) );
+    }
+    if( oter_cells[i] == unknown ) {
+        oter_cells[i] = static_cast<uint8_t>( classify( oter ) ) | ( is_ramp( oter ) ? ramp_bit : 0 );
+    }
+    return oter_cells[i];
+}
+
+overmap_path_engine::overmap_travel_data &overmap_path_engine::get_data( const point_abs_om &p )
+{
+    return overmaps[p];
+}
+
+const std::vector<uint8_t> &overmap_path_engine::get_cells( const point_abs_om &p,
+        const overmap *om, int z )
+{
+    travel_layer &layer = get_data( p ).layers[z + OVERMAP_DEPTH];
+    const int64_t revision = om != nullptr ? om->get_terrain_revision() : 0;
+    if( !layer.cells.empty() && layer.revision == revision ) {
+        return layer.cells;
+    }
+    layer.revision = revision;
+    layer.cells.resize( cells_per_level );
+    if( om == nullptr ) {
+        static const oter_id ot_null;
+        std::fill( layer.cells.begin(), layer.cells.end(), get_cell( ot_null ) );
+        return layer.cells;
+    }
+    for( int y = 0; y < OMAPY; y++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            const tripoint_om_omt local( x, y, z );
+            uint8_t cell = get_cell( om->ter( local ) );
+            if( om->is_path( local ) ) {
+                cell = static_cast<uint8_t>( omt_travel_class::road ) | ( cell & ramp_bit );
+            }
+            layer.cells[y * OMAPX + x] = cell;
+        }
+    }
+    return layer.cells;
+}
+
+int overmap_path_engine::portal_key( const tripoint_om_omt &p )
+{
+    return ( p.z() * OMAPY + p.y() ) * OMAPX + p.x();
+}
+
+const overmap_path_engine::road_graph &overmap_path_engine::get_road_graph(
+    const point_abs_om &p, const overmap &om )
+{
+    road_graph &graph = get_data( p ).roads;
+    if( graph.revision == om.get_terrain_revision() ) {
+        return graph;
+    }
+    graph.revision = om.get_terrain_revision();
+    graph.portals.clear();
+    graph.by_pos.clear();
+
+    std::array<const std::vector<uint8_t> *, road_graph_levels> levels;
+    for( int z = road_graph_min_z; z <= road_graph_max_z; z++ ) {
+        levels[z - road_graph_min_z] = &get_cells( p, &om, z );
+    }
+    const auto cell_at = [&]( const tripoint_om_omt & c ) {
+        return ( *levels[c.z() - road_graph_min_z] )[c.y() * OMAPX + c.x()];
+    };
+    const auto is_road = [&]( const tripoint_om_omt & c ) {
+        return ( cell_at( c ) & ~ramp_bit ) == static_cast<uint8_t>( omt_travel_class::road );
+    };
+    const auto is_border = []( point_om_omt c ) {
+        return c.x() == 0 || c.y() == 0 || c.x() == OMAPX - 1 || c.y() == OMAPY - 1;
+    };
+
+    for( int z = road_graph_min_z; z <= road_graph_max_z; z++ ) {
+        for( int y = 0; y < OMAPY; y++ ) {
+            for( int x = 0; x < OMAPX; x++ ) {
+                const tripoint_om_omt c( x, y, z );
+                if( is_border( c.xy() ) && is_road( c ) ) {
+                    graph.by_pos.emplace( portal_key( c ), static_cast<int>( graph.portals.size() ) );
+                    graph.portals.push_back( road_portal{ c, {} } );
+                }
+            }
+        }
+    }
+
+    // Breadth first search along the roads from every portal to the others
+    const auto index_of = [&]( const tripoint_om_omt & c ) {
+        return ( c.z() - road_graph_min_z ) * cells_per_level + c.y() * OMAPX + c.x();
+    };
+    std::vector<int> prev( cells_per_level * road_graph_levels );
+    for( road_portal &portal : graph.portals ) {
+        std::fill( prev.begin(), prev.end(), -1 );
+        std::queue<tripoint_om_omt> open;
+        open.push( portal.pos );
+        prev[index_of( portal.pos )] = index_of( portal.pos );
+        while( !open.empty() ) {
+            const tripoint_om_omt cur = open.front();
+            open.pop();
+            if( cur != portal.pos && is_border( cur.xy() ) ) {
+                const auto iter = graph.by_pos.find( portal_key( cur ) );
+                if( iter != graph.by_pos.end() ) {
+                    road_edge edge{ iter->second, {} };
+                    for( tripoint_om_omt c = cur; c != portal.pos; ) {
+                        edge.path.push_back( c );
+                        const int i = prev[index_of( c )];
+                        c = tripoint_om_omt( i % OMAPX, i / OMAPX % OMAPY,
+                                             i / cells_per_level + road_graph_min_z );
+                    }
+                    std::reverse( edge.path.begin(), edge.path.end() );
+                    portal.edges.push_back( std::move( edge ) );
+                }
+            }
+            for( int step = 0; step < num_steps( ( cell_at( cur ) & ramp_bit ) != 0 ); step++ ) {
+                const tripoint_om_omt next = cur + steps[step];
+                if( next.x() < 0 || next.y() < 0 || next.x() >= OMAPX || next.y() >= OMAPY ||
+                    next.z() < road_graph_min_z || next.z() > road_graph_max_z ) {
+                    continue;
+                }
+                if( prev[index_of( next )] >= 0 || !is_road( next ) ) {
+                    continue;
+                }
+                prev[index_of( next )] = index_of( cur );
+                open.push( next );
+            }
+        }
+    }
+    return graph;
+}
+
+std::vector<tripoint_abs_omt> overmap_path_engine::find_dense_path( overmapbuffer &buffer,
+        const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params,
+        int radius )
+{
+    search s( *this, buffer, params );
+    int dest_cost = 0;
+    bool dest_ramp = false;
+    if( !s.score( dest, dest_cost, dest_ramp ) ) {
+        return {};
+    }
+    if( !s.expand( src, &dest, radius ) ) {
+        return {};
+    }
+    return s.path_to( dest );
+}
+
+std::vector<tripoint_abs_omt> overmap_path_engine::find_road_graph_path( overmapbuffer &buffer,
+        const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params,
+        int radius )
+{
+    const point_abs_om src_om = project_to<coords::om>( src.xy() );
+    const point_abs_om dest_om = project_to<coords::om>( dest.xy() );
+    overmap *const src_overmap = buffer.get_existing( src_om );
+    overmap *const dest_overmap = buffer.get_existing( dest_om );
+    if( src_overmap == nullptr || dest_overmap == nullptr ) {
+        return {};
+    }
+
+    // Costs from the source to the portals of its overmap and from the portals of
+    // the destination overmap to the destination
+    search from_src( *this, buffer, params );
+    search to_dest( *this, buffer, params );
+    search edges( *this, buffer, params );
+    int dest_cost = 0;
+    bool dest_ramp = false;
+    if( !to_dest.score( dest, dest_cost, dest_ramp ) ) {
+        return {};
+    }
+    from_src.expand( src, nullptr, 0 );
+    to_dest.expand( dest, nullptr, 0 );
+
+    // Graph nodes are keyed by the overmap and the portal index
+    struct graph_node {
+        int cost = INT_MAX;
+        tripoint prev;
+        // Index of the edge of the previous portal that leads here, -1 when crossing
+        // the overmap border, -2 for portals of the source overmap
+        int via = -2;
+        bool closed = false;
+    };
+    std::unordered_map<tripoint, graph_node> nodes;
+    using scored_node = std::pair<int, tripoint>;
+    std::priority_queue<scored_node, std::vector<scored_node>, std::greater<>> open_set;
+    const int om_radius = radius / OMAPX + 1;
+
+    const auto portals_of = [&]( const point_abs_om & om_pos ) -> const road_graph * {
+        if( std::max( std::abs( om_pos.x() - src_om.x() ), std::abs( om_pos.y() - src_om.y() ) ) >
+            om_radius ) {
+            return nullptr;
+        }
+        const overmap *om = buffer.get_existing( om_pos );
+        return om != nullptr ? &get_road_graph( om_pos, *om ) : nullptr;
+    };
+    const auto relax = [&]( const tripoint & key, int cost, const tripoint & prev, int via ) {
+        graph_node &node = nodes[key];
+        if( !node.closed && cost < node.cost ) {
+            node.cost = cost;
+            node.prev = prev;
+            node.via = via;
+            open_set.emplace( cost, key );
+        }
+    };
+
+    const road_graph *src_graph = portals_of( src_om );
+    if( src_graph == nullptr ) {
+        return {};
+    }
+    for( size_t i = 0; i < src_graph->portals.size(); i++ ) {
+        const tripoint_abs_omt pos = to_global( src_om, src_graph->portals[i].pos );
+        if( from_src.reached( pos ) ) {
+            relax( tripoint( src_om.raw(), static_cast<int>( i ) ), from_src.at( pos ).cost, tripoint_zero,
+                   -2 );
+        }
+    }
+
+    int best_cost = INT_MAX;
+    tripoint best_key;
+    while( !open_set.empty() ) {
+        const auto [cost, key] = open_set.top();
+        open_set.pop();
+        graph_node &node = nodes[key];
+        if( node.closed ) {
+            continue;
+        }
+        node.closed = true;
+        if( cost >= best_cost ) {
+            break;
+        }
+        const point_abs_om om_pos( key.xy() );
+        const road_graph &graph = *portals_of( om_pos );
+        const road_portal &portal = graph.portals[key.z];
+        if( om_pos == dest_om ) {
+            const tripoint_abs_omt pos = to_global( om_pos, portal.pos );
+            if( to_dest.reached( pos ) && cost + to_dest.at( pos ).cost < best_cost ) {
+                best_cost = cost + to_dest.at( pos ).cost;
+                best_key = key;
+            }
+        }
+        // Cells are paid for when they are left, like in search::expand. The direction
+        // a portal was entered from isn't known here, so leaving it never counts as a turn.
+        const tripoint_abs_omt portal_global = to_global( om_pos, portal.pos );
+        int portal_cost = 0;
+        bool portal_ramp = false;
+        if( !edges.score( portal_global, portal_cost, portal_ramp ) ) {
+            continue;
+        }
+        // Along the roads inside this overmap
+        for( size_t e = 0; e < portal.edges.size(); e++ ) {
+            const road_edge &edge = portal.edges[e];
+            int edge_cost = 0;
+            int8_t prev_step = no_step;
+            tripoint_abs_omt cur = portal_global;
+            int cur_cost = portal_cost;
+            bool valid = true;
+            for( const tripoint_om_omt &c : edge.path ) {
+                const tripoint_abs_omt next = to_global( om_pos, c );
+                edge_cost += adjust_omt_cost( cur_cost, step_between( next, cur ), prev_step );
+                bool ramp = false;
+                if( !edges.score( next, cur_cost, ramp ) ) {
+                    valid = false;
+                    break;
+                }
+                prev_step = step_between( next, cur );
+                cur = next;
+            }
+            if( valid ) {
+                relax( tripoint( om_pos.raw(), edge.to ), cost + edge_cost, key, static_cast<int>( e ) );
+            }
+        }
+        // Across the border into the neighbouring overmaps
+        for( int step = 0; step < num_steps( false ); step++ ) {
+            const point d = steps[step].xy();
+            const point_om_omt next_local = portal.pos.xy() + d;
+            if( next_local.x() >= 0 && next_local.y() >= 0 && next_local.x() < OMAPX &&
+                next_local.y() < OMAPY ) {
+                continue;
+            }
+            const point_abs_om next_om = om_pos + d;
+            const road_graph *next_graph = portals_of( next_om );
+            if( next_graph == nullptr ) {
+                continue;
+            }
+            const tripoint_om_omt next_pos( ( next_local.x() + OMAPX ) % OMAPX,
+                                            ( next_local.y() + OMAPY ) % OMAPY, portal.pos.z() );
+            const auto iter = next_graph->by_pos.find( portal_key( next_pos ) );
+            if( iter == next_graph->by_pos.end() ) {
+                continue;
+            }
+            int cell_cost = 0;
+            bool ramp = false;
+            if( edges.score( to_global( next_om, next_pos ), cell_cost, ramp ) ) {
+                relax( tripoint( next_om.raw(), iter->second ), cost + portal_cost, key, -1 );
+            }
+        }
+    }
+    if( best_cost == INT_MAX ) {
+        return {};
+    }
+
+    // Collect the portals from the destination back to the source
+    std::vector<tripoint> hops;
+    for( tripoint key = best_key; ; key = nodes[key].prev ) {
+        hops.push_back( key );
+        if( nodes[key].via == -2 ) {
+            break;
+        }
+    }
+    std::reverse( hops.begin(), hops.end() );
+
+    std::vector<tripoint_abs_omt> forward;
+    const auto portal_pos = [&]( const tripoint & key ) {
+        const point_abs_om om_pos( key.xy() );
+        return to_global( om_pos, portals_of( om_pos )->portals[key.z].pos );
+    };
+    std::vector<tripoint_abs_omt> start = from_src.path_to( portal_pos( hops.front() ) );
+    forward.insert( forward.end(), start.rbegin(), start.rend() );
+    for( size_t i = 1; i < hops.size(); i++ ) {
+        const graph_node &node = nodes[hops[i]];
+        if( node.via < 0 ) {
+            forward.push_back( portal_pos( hops[i] ) );
+            continue;
+        }
+        const point_abs_om om_pos( node.prev.xy() );
+        const road_edge &edge = portals_of( om_pos )->portals[node.prev.z].edges[node.via];
+        for( const tripoint_om_omt &c : edge.path ) {
+            forward.push_back( to_global( om_pos, c ) );
+        }
+    }
+    const std::vector<tripoint_abs_omt> end = to_dest.path_to( portal_pos( hops.back() ) );
+    forward.insert( forward.end(), std::next( end.begin() ), end.end() );
+
+    // The graph only approximates the costs along the legs and at the portals, and its
+    // edges don't detour around cells that can't be traversed. Leave routes that may be
+    // much worse than the best one to the dense search.
+    const int cost = edges.path_cost( forward );
+    const int min_cell_cost = edges.min_cell_cost();
+    if( cost < 0 || min_cell_cost < 0 || static_cast<int64_t>( cost ) * 100 >
+        static_cast<int64_t>( min_path_cost( src, dest, min_cell_cost ) ) * road_graph_max_cost_percent ) {
+        return {};
+    }
+
+    std::reverse( forward.begin(), forward.end() );
+    return forward;
+}
+
+std::vector<tripoint_abs_omt> overmap_path_engine::find_path( overmapbuffer &buffer,
+        const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params,
+        int radius )
+{
+    // Routes across whole overmaps are planned on the road graph, shorter ones and
+    // those the roads can't serve are searched cell by cell
+    if( use_road_graph && params.road_cost >= 0 && octile_dist( src.xy(), dest.xy() ) > OMAPX ) {
+        std::vector<tripoint_abs_omt> path = find_road_graph_path( buffer, src, dest, params, radius );
+        if( !path.empty() ) {
+            road_graph_routes++;
+            return path;
+        }
+    }
+    return find_dense_path( buffer, src, dest, params, radius );
+}
+
+void overmap_path_engine::clear()
+{
+    overmaps.clear();
+    oter_cells.clear();
+}
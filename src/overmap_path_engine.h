@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "coordinates.h"
+#include "game_constants.h"
+#include "type_id.h"
+
+class overmap;
+class overmapbuffer;
+struct overmap_path_params;
+
+/** Kinds of overmap terrain that overmap_path_params give separate travel costs. */
+enum class omt_travel_class : uint8_t {
+    road,
+    field,
+    dirt_road,
+    trail,
+    swamp,
+    water,
+    shore,
+    air,
+    forest,
+    impassable,
+    other,
+    num_classes
+};
+
+/**
+ * Finds overmap travel paths for @ref overmapbuffer::get_travel_path.
+ *
+ * Terrain is classified once per overmap z-level into dense grids of travel classes,
+ * which are rebuilt when @ref overmap::get_terrain_revision changes. Searches store their
+ * nodes in dense per-overmap pages instead of hash maps.
+ *
+ * For long routes the engine also keeps, per overmap, a graph of the roads connecting the
+ * points where roads cross the overmap border. Those routes are planned on the graph and
+ * only the parts from the source and to the destination are searched cell by cell. Routes
+ * from the graph that cost too much compared to the best possible route are dropped for
+ * the dense search.
+ */
+class overmap_path_engine
+{
+    public:
+        /**
+         * Returns the path from src to dest (inclusive) in reverse order, or an empty
+         * vector if there is none within radius OMTs of src.
+         */
+        std::vector<tripoint_abs_omt> find_path( overmapbuffer &buffer, const tripoint_abs_omt &src,
+                const tripoint_abs_omt &dest, const overmap_path_params &params, int radius );
+        /** Drops all cached grids and road graphs. */
+        void clear();
+
+        /** Whether long routes may be planned on the road graph. */
+        bool use_road_graph = true;
+        /**
+         * Road graph routes are only used if they cost at most this percentage of a lower
+         * bound of the best route's cost, otherwise the dense search plans the route.
+         */
+        int road_graph_max_cost_percent = 150;
+        /** Number of paths that were planned on the road graph. */
+        int road_graph_routes = 0;
+
+    private:
+        static constexpr int cells_per_level = OMAPX * OMAPY;
+        // Set in a cell of a travel grid if the terrain permits z-level changes.
+        static constexpr uint8_t ramp_bit = 0x80;
+
+        struct travel_layer {
+            int64_t revision = 0;
+            std::vector<uint8_t> cells;
+        };
+
+        struct road_edge {
+            int to;
+            // Cells after the start portal, up to and including the portal at `to`
+            std::vector<tripoint_om_omt> path;
+        };
+
+        struct road_portal {
+            tripoint_om_omt pos;
+            std::vector<road_edge> edges;
+        };
+
+        struct road_graph {
+            int64_t revision = 0;
+            std::vector<road_portal> portals;
+            // Portal index by position, see portal_key
+            std::unordered_map<int, int> by_pos;
+        };
+
+        struct overmap_travel_data {
+            std::array<travel_layer, OVERMAP_LAYERS> layers;
+            road_graph roads;
+        };
+
+        class search;
+
+        uint8_t get_cell( const oter_id &oter );
+        overmap_travel_data &get_data( const point_abs_om &p );
+        const std::vector<uint8_t> &get_cells( const point_abs_om &p, const overmap *om, int z );
+        const road_graph &get_road_graph( const point_abs_om &p, const overmap &om );
+
+        std::vector<tripoint_abs_omt> find_dense_path( overmapbuffer &buffer,
+                const tripoint_abs_omt &src, const tripoint_abs_omt &dest,
+                const overmap_path_params &params, int radius );
+        std::vector<tripoint_abs_omt> find_road_graph_path( overmapbuffer &buffer,
+                const tripoint_abs_omt &src, const tripoint_abs_omt &dest,
+                const overmap_path_params &params, int radius );
+
+        static int portal_key( const tripoint_om_omt &p );
+
+        std::unordered_map<point_abs_om, overmap_travel_data> overmaps;
+        // Travel grid cell of each overmap terrain, by oter_id
+        std::vector<uint8_t> oter_cells;
+};
@@ -322,11 +322,12 @@ weather_type_id get_weather_at_point( const point_abs_omt &pos )
     }
     auto iter = weather_cache.find( pos );
     if( iter == weather_cache.end() ) {
-        // TODO: fix point types
-        tripoint_abs_omt pos_z( pos, OVERMAP_HEIGHT );
-        const tripoint abs_ms_pos = project_to<coords::ms>( pos_z ).raw();
+        const tripoint_abs_omt pos_z( pos, OVERMAP_HEIGHT );
         const auto &wgen = overmap_buffer.get_settings( pos_z ).weather;
-        auto weather = wgen.get_weather_conditions( abs_ms_pos, calendar::turn, g->get_seed() );
+        // The noise is shared by a whole block of OMTs, only the wind is rolled per OMT
+        const weather_noise noise = get_weather().get_weather_noise( wgen, pos );
+        auto weather = wgen.get_weather_conditions( wgen.get_weather( noise, calendar::turn,
+                       calendar::config ) );
         iter = weather_cache.insert( std::make_pair( pos, weather ) ).first;
     }
     return iter->second;
@@ -101,6 +101,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
     // necessarily the overmap at (x,y)
     new_om->populate();
     fix_mongroups( *new_om );
+    index_npcs( *new_om );
     fix_npcs( *new_om );
 
     return *new_om;
@@ -115,6 +116,7 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
         new_om = overmaps[p].get();
     }
     new_om->populate( specials );
+    index_npcs( *new_om );
 }
 
 void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
@@ -131,6 +133,7 @@ void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
             auto map = std::make_unique<overmap>( loc );
             map->populate();
             fix_mongroups( *map );
+            index_npcs( *map );
             fix_npcs( *map );
             return std::make_pair( loc, std::move( map ) );
         };
@@ -160,7 +163,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         // spawn related code simply sets population to 0 when they have been
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
-            new_overmap.zg.erase( it++ );
+            it = new_overmap.erase_mon_group( it );
             continue;
         }
         // Inside the bounds of the overmap?
@@ -180,9 +183,10 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
             continue;
         }
         overmap &om = get( omp );
-        mg.pos = tripoint_om_sm( sm_rem, mg.pos.z() );
-        om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
+        mongroup moved = mg;
+        moved.pos = tripoint_om_sm( sm_rem, mg.pos.z() );
+        om.add_mon_group( moved );
+        it = new_overmap.erase_mon_group( it );
     }
 }
 
@@ -204,6 +208,7 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
         }
         to_relocate.push_back( *it );
         it = new_overmap.npcs.erase( it );
+        new_overmap.mark_dirty();
     }
     // Second step: put them back where they belong. This step involves loading
     // new overmaps (via `get`), which does in turn call this function for the
@@ -234,10 +239,25 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
         }
 
         // Simplest case: just move the pointer
-        get( npc_om_pos ).insert_npc( ptr );
+        insert_npc( get( npc_om_pos ), ptr );
     }
 }
 
+void overmapbuffer::index_npcs( overmap &om )
+{
+    write_lock<std::mutex> _l( npc_index_mutex );
+    for( const shared_ptr_fast<npc> &guy : om.npcs ) {
+        npc_index[guy->getID()] = npc_location{ &om, guy };
+    }
+}
+
+void overmapbuffer::insert_npc( overmap &om, const shared_ptr_fast<npc> &who )
+{
+    om.insert_npc( who );
+    write_lock<std::mutex> _l( npc_index_mutex );
+    npc_index[who->getID()] = npc_location{ &om, who };
+}
+
 void overmapbuffer::save()
 {
     read_lock<std::shared_mutex> _l( mutex );
@@ -255,6 +275,8 @@ void overmapbuffer::clear()
     overmaps.clear();
     known_non_existing.clear();
     placed_unique_specials.clear();
+    path_engine.clear();
+    npc_index.clear();
 }
 
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
@@ -445,7 +467,7 @@ bool overmapbuffer::is_explored( const tripoint_abs_omt &p )
 void overmapbuffer::toggle_explored( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->explored( om_loc.local ) = !om_loc.om->explored( om_loc.local );
+    om_loc.om->set_explored( om_loc.local, !om_loc.om->is_explored( om_loc.local ) );
 }
 
 bool overmapbuffer::is_path( const tripoint_abs_omt &p )
@@ -459,7 +481,7 @@ bool overmapbuffer::is_path( const tripoint_abs_omt &p )
 void overmapbuffer::toggle_path( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->path( om_loc.local ) = !om_loc.om->path( om_loc.local );
+    om_loc.om->set_path( om_loc.local, !om_loc.om->is_path( om_loc.local ) );
 }
 
 bool overmapbuffer::has_horde( const tripoint_abs_omt &p )
@@ -599,6 +621,10 @@ std::vector<mongroup *> overmapbuffer::groups_at( const tripoint_abs_sm &p )
         }
         result.push_back( &mg );
     }
+    if( !result.empty() ) {
+        // The groups are handed out for changing
+        om.mark_dirty();
+    }
     return result;
 }
 
@@ -641,8 +667,10 @@ void overmapbuffer::move_vehicle( vehicle *veh, const point_abs_ms &old_msp )
     const overmap_with_local_coords new_om_loc = get_om_global( new_omt );
     if( old_om_loc.om == new_om_loc.om ) {
         new_om_loc.om->vehicles[veh->om_id].p = new_om_loc.local.xy();
+        new_om_loc.om->mark_dirty();
     } else {
         old_om_loc.om->vehicles.erase( veh->om_id );
+        old_om_loc.om->mark_dirty();
         add_vehicle( veh );
     }
 }
@@ -656,6 +684,7 @@ void overmapbuffer::remove_vehicle( const vehicle *veh )
         return;
     }
     om_loc.om->vehicles.erase( veh->om_id );
+    om_loc.om->mark_dirty();
 }
 
 void overmapbuffer::add_vehicle( vehicle *veh )
@@ -675,6 +704,7 @@ void overmapbuffer::add_vehicle( vehicle *veh )
     tracked_veh.p = om_loc.local.xy();
     tracked_veh.name = veh->name;
     veh->om_id = id;
+    om_loc.om->mark_dirty();
 }
 
 bool overmapbuffer::seen( const tripoint_abs_omt &p )
@@ -692,7 +722,7 @@ void overmapbuffer::set_seen( const tripoint_abs_omt &p, bool seen )
         !( om_loc.om->seen( om_loc.local ) ) ) {
         om_loc.om->spawn_ores( p );
     }
-    om_loc.om->seen( om_loc.local ) = seen;
+    om_loc.om->set_seen( om_loc.local, seen );
 }
 
 const oter_id &overmapbuffer::ter( const tripoint_abs_omt &p )
@@ -823,65 +853,6 @@ overmap_path_params overmap_path_params::for_aircraft()
     return ret;
 }
 
-static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path_params &params )
-{
-    if( params.only_known_by_player && !overmap_buffer.seen( omt_pos ) ) {
-        return -1;
-    }
-    if( params.avoid_danger && overmap_buffer.is_marked_dangerous( omt_pos ) ) {
-        return -1;
-    }
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
-    if( is_ot_match( "road", oter, ot_match_type::type ) ||
-        is_ot_match( "bridge", oter, ot_match_type::type ) ||
-        is_ot_match( "bridge_road", oter, ot_match_type::type ) ||
-        is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
-        is_ot_match( "bridgehead_ramp", oter, ot_match_type::type ) ||
-        is_ot_match( "road_nesw_manhole", oter, ot_match_type::type ) ||
-        overmap_buffer.is_path( omt_pos ) ) {
-        return params.road_cost;
-    } else if( is_ot_match( "field", oter, ot_match_type::type ) ) {
-        return params.field_cost;
-    } else if( is_ot_match( "rural_road", oter, ot_match_type::prefix ) ||
-               is_ot_match( "dirt_road", oter, ot_match_type::prefix ) ||
-               is_ot_match( "subway", oter, ot_match_type::type ) ||
-               is_ot_match( "lab_subway", oter, ot_match_type::type ) ) {
-        return params.dirt_road_cost;
-    } else if( is_ot_match( "forest_trail", oter, ot_match_type::type ) ) {
-        return params.trail_cost;
-    } else if( is_ot_match( "forest_water", oter, ot_match_type::type ) ) {
-        return params.swamp_cost;
-    } else if( is_ot_match( "river", oter, ot_match_type::prefix ) ||
-               is_ot_match( "lake", oter, ot_match_type::prefix ) ) {
-        if( is_ot_match( "river_center", oter, ot_match_type::type ) ||
-            is_ot_match( "lake_surface", oter, ot_match_type::type ) ) {
-            return params.water_cost;
-        } else {
-            return params.shore_cost;
-        }
-    } else if( is_ot_match( "bridge_under", oter, ot_match_type::type ) ) {
-        return params.water_cost;
-    } else if( is_ot_match( "open_air", oter, ot_match_type::type ) ) {
-        return params.air_cost;
-    } else if( is_ot_match( "forest", oter, ot_match_type::type ) ) {
-        return params.forest_cost;
-    } else if( is_ot_match( "empty_rock", oter, ot_match_type::type ) ||
-               is_ot_match( "deep_rock", oter, ot_match_type::type ) ||
-               is_ot_match( "solid_earth", oter, ot_match_type::type ) ||
-               is_ot_match( "microlab_rock_border", oter, ot_match_type::type ) ) {
-        return -1;
-    } else {
-        return params.other_cost;
-    }
-}
-
-static bool is_ramp( const tripoint_abs_omt &omt_pos )
-{
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
-    return is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
-           is_ot_match( "bridgehead_ramp", oter, ot_match_type::type );
-}
-
 std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
     const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params )
 {
@@ -889,17 +860,8 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
         return {};
     }
 
-    const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
-        const int cur_cost = pos == src ? 0 : get_terrain_cost( pos, params );
-        if( cur_cost < 0 ) {
-            return pf::omt_score::rejected;
-        }
-        return pf::omt_score( cur_cost, is_ramp( pos ) );
-    };
-
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
-    const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate );
-    return path.points;
+    return path_engine.find_path( *this, src, dest, params, radius );
 }
 
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
@@ -1039,7 +1001,7 @@ bool overmapbuffer::is_findable_location( const overmap_with_local_coords &om_lo
         return false;
     }
 
-    const auto is_explored = om_loc.om->explored( om_loc.local );
+    const auto is_explored = om_loc.om->is_explored( om_loc.local );
     if( params.explored.has_value() && params.explored.value() != is_explored ) {
         return false;
     }
@@ -1400,12 +1362,9 @@ tripoint_abs_omt overmapbuffer::find_random( const tripoint_abs_omt &origin,
 
 shared_ptr_fast<npc> overmapbuffer::find_npc( character_id id )
 {
-    for( auto &it : overmaps ) {
-        if( auto p = it.second->find_npc( id ) ) {
-            return p;
-        }
-    }
-    return nullptr;
+    write_lock<std::mutex> _l( npc_index_mutex );
+    const auto it = npc_index.find( id );
+    return it == npc_index.end() ? nullptr : it->second.who;
 }
 
 void overmapbuffer::insert_npc( const shared_ptr_fast<npc> &who )
@@ -1413,18 +1372,38 @@ void overmapbuffer::insert_npc( const shared_ptr_fast<npc> &who )
     assert( who );
     const tripoint_abs_omt npc_omt_pos = who->global_omt_location();
     const point_abs_om npc_om_pos = project_to<coords::om>( npc_omt_pos.xy() );
-    get( npc_om_pos ).insert_npc( who );
+    insert_npc( get( npc_om_pos ), who );
 }
 
 shared_ptr_fast<npc> overmapbuffer::remove_npc( const character_id &id )
 {
-    for( auto &it : overmaps ) {
-        if( const auto p = it.second->erase_npc( id ) ) {
-            return p;
-        }
+    write_lock<std::mutex> _l( npc_index_mutex );
+    const auto it = npc_index.find( id );
+    if( it == npc_index.end() ) {
+        debugmsg( "overmapbuffer::remove_npc: NPC (%d) not found.", id.get_value() );
+        return nullptr;
     }
-    debugmsg( "overmapbuffer::remove_npc: NPC (%d) not found.", id.get_value() );
-    return nullptr;
+    shared_ptr_fast<npc> p = it->second.om->erase_npc( id );
+    npc_index.erase( it );
+    return p;
+}
+
+bool overmapbuffer::move_npc( const character_id &id, const point_abs_om &p )
+{
+    // Loading the new overmap may index NPCs, so it has to happen before the lookup
+    overmap &om_new = get( p );
+    write_lock<std::mutex> _l( npc_index_mutex );
+    const auto it = npc_index.find( id );
+    if( it == npc_index.end() ) {
+        return false;
+    }
+    npc_location &loc = it->second;
+    if( loc.om != &om_new ) {
+        loc.om->erase_npc( id );
+        om_new.insert_npc( loc.who );
+        loc.om = &om_new;
+    }
+    return true;
 }
 
 std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near_player( int radius )
@@ -1722,7 +1701,9 @@ void overmapbuffer::spawn_monster( const tripoint_abs_sm &p )
             placed->on_load();
         }
     } );
-    om.monster_map->erase( current_submap_loc );
+    if( om.monster_map->erase( current_submap_loc ) > 0 ) {
+        om.mark_dirty();
+    }
 }
 
 void overmapbuffer::despawn_monster( const monster &critter )
@@ -1737,6 +1718,7 @@ void overmapbuffer::despawn_monster( const monster &critter )
     overmap &om = get( omp );
     // Store the monster using coordinates local to the overmap.
     om.monster_map->insert( std::make_pair( sm, critter ) );
+    om.mark_dirty();
 }
 
 overmapbuffer::t_notes_vector overmapbuffer::get_notes( int z, const std::string *pattern )
@@ -1947,6 +1929,8 @@ bool overmapbuffer::add_grid_connection( const tripoint_abs_omt &lhs, const trip
 
     lhs_bitset[lhs_i] = true;
     rhs_bitset[rhs_i] = true;
+    lhs_omc.om->mark_dirty();
+    rhs_omc.om->mark_dirty();
     distribution_grid_tracker &tracker = get_distribution_grid_tracker();
     tracker.on_changed( project_to<coords::ms>( lhs ) );
     tracker.on_changed( project_to<coords::ms>( rhs ) );
@@ -1988,6 +1972,8 @@ bool overmapbuffer::remove_grid_connection( const tripoint_abs_omt &lhs,
 
     lhs_bitset[lhs_i] = false;
     rhs_bitset[rhs_i] = false;
+    lhs_omc.om->mark_dirty();
+    rhs_omc.om->mark_dirty();
     distribution_grid_tracker &tracker = get_distribution_grid_tracker();
     tracker.on_changed( project_to<coords::ms>( lhs ) );
     tracker.on_changed( project_to<coords::ms>( rhs ) );
@@ -10,18 +10,20 @@
 #include <unordered_set>
 #include <utility>
 #include <vector>
+#include <mutex>
 #include <shared_mutex>
 
+#include "character_id.h"
 #include "coordinates.h"
 #include "enums.h"
 #include "json.h"
 #include "memory_fast.h"
+#include "overmap_path_engine.h"
 #include "overmap_types.h"
 #include "point.h"
 #include "string_id.h"
 #include "type_id.h"
 
-class character_id;
 enum class cube_direction : int;
 class map_extra;
 class monster;
@@ -296,7 +298,7 @@ class overmapbuffer
         /**
          * Find the npc with the given ID.
          * Returns NULL if the npc could not be found.
-         * Searches all loaded overmaps.
+         * Only NPCs on loaded overmaps are found, see @ref npc_index.
          */
         shared_ptr_fast<npc> find_npc( character_id id );
         /**
@@ -313,6 +315,11 @@ class overmapbuffer
          * and stores it there. The overmap takes ownership of the pointer.
          */
         void insert_npc( const shared_ptr_fast<npc> &who );
+        /**
+         * Moves the npc to the overmap at the given position, after it has
+         * travelled there. Returns false if the npc is not on any loaded overmap.
+         */
+        bool move_npc( const character_id &id, const point_abs_om &p );
 
         /**
          * Find all places with the specific overmap terrain type.
@@ -364,6 +371,9 @@ class overmapbuffer
                      const std::function<bool( const oter_id & )> &filter );
         std::vector<tripoint_abs_omt> get_travel_path(
             const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params );
+        overmap_path_engine &get_path_engine() {
+            return path_engine;
+        }
         bool reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                            const omt_route_params &params );
 
@@ -520,6 +530,23 @@ class overmapbuffer
                                    const omt_find_params &params );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
+        overmap_path_engine path_engine;
+
+        struct npc_location {
+            overmap *om;
+            shared_ptr_fast<npc> who;
+        };
+        /**
+         * The overmap of every NPC on a loaded overmap, by NPC id.
+         * Updated whenever an NPC is added to, removed from or moved between overmaps.
+         * Guarded by @ref npc_index_mutex, overmaps can be generated on several threads.
+         */
+        std::unordered_map<character_id, npc_location> npc_index;
+        std::mutex npc_index_mutex;
+        /** Adds all NPCs of a newly loaded overmap to @ref npc_index. */
+        void index_npcs( overmap &om );
+        /** Inserts the npc into the overmap and indexes it there. */
+        void insert_npc( overmap &om, const shared_ptr_fast<npc> &who );
         /**
          * Set of overmap coordinates of overmaps that are known
          * to not exist on disk. See @ref get_existing for usage.
@@ -0,0 +1,244 @@
+#include "profile.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#if defined(_WIN32)
+#   include <malloc.h>
+#endif
+
+// Only built on request, for benchmarks and tests. Tracy and the sanitizers install
+// their own allocation hooks, so the counting replacements are left out with those.
+#if defined(CATA_COUNT_ALLOCATIONS) && !defined(USE_TRACY) && !defined(__SANITIZE_ADDRESS__)
+#   define CATA_PROFILE_COUNT_ALLOCATIONS
+#endif
+
+namespace cata::profile
+{
+
+std::atomic<bool> collecting{ false };
+
+static std::mutex sites_mutex;
+static std::vector<zone_site *> sites;
+
+static std::atomic<uint64_t> allocations{ 0 };
+static std::atomic<uint64_t> largest{ 0 };
+
+void register_site( zone_site &site )
+{
+    std::lock_guard<std::mutex> lock( sites_mutex );
+    if( !site.registered.load( std::memory_order_relaxed ) ) {
+        sites.push_back( &site );
+        site.registered.store( true, std::memory_order_release );
+    }
+}
+
+std::vector<zone_site *> zone_sites()
+{
+    std::lock_guard<std::mutex> lock( sites_mutex );
+    return sites;
+}
+
+void reset()
+{
+    std::lock_guard<std::mutex> lock( sites_mutex );
+    for( zone_site *site : sites ) {
+        site->calls.store( 0, std::memory_order_relaxed );
+        site->total_ns.store( 0, std::memory_order_relaxed );
+    }
+    allocations.store( 0, std::memory_order_relaxed );
+    largest.store( 0, std::memory_order_relaxed );
+}
+
+bool counts_allocations()
+{
+#if defined(CATA_PROFILE_COUNT_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t allocation_count()
+{
+    return allocations.load( std::memory_order_relaxed );
+}
+
+uint64_t largest_allocation()
+{
+    return largest.load( std::memory_order_relaxed );
+}
+
+} // namespace cata::profile
+
+#if defined(CATA_PROFILE_COUNT_ALLOCATIONS)
+
+static void count_allocation( std::size_t size )
+{
+    if( cata::profile::collecting.load( std::memory_order_relaxed ) ) {
+        cata::profile::allocations.fetch_add( 1, std::memory_order_relaxed );
+        uint64_t seen = cata::profile::largest.load( std::memory_order_relaxed );
+        while( size > seen && !cata::profile::largest.compare_exchange_weak( seen, size,
+                std::memory_order_relaxed ) ) {
+        }
+    }
+}
+
+static void *aligned_malloc( std::size_t size, std::size_t alignment )
+{
+#if defined(_WIN32)
+    return _aligned_malloc( size, alignment );
+#else
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc( alignment, ( size + alignment - 1 ) / alignment * alignment );
+#endif
+}
+
+static void aligned_free( void *p )
+{
+#if defined(_WIN32)
+    _aligned_free( p );
+#else
+    std::free( p );
+#endif
+}
+
+static void *counted_alloc( std::size_t size, std::size_t alignment = 0 )
+{
+    count_allocation( size );
+    if( size == 0 ) {
+        size = 1;
+    }
+    while( true ) {
+        if( void *p = alignment == 0 ? std::malloc( size ) : aligned_malloc( size, alignment ) ) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if( handler == nullptr ) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *operator new( std::size_t size )
+{
+    return counted_alloc( size );
+}
+
+void *operator new[]( std::size_t size )
+{
+    return counted_alloc( size );
+}
+
+void *operator new( std::size_t size, const std::nothrow_t & ) noexcept
+{
+    try {
+        return counted_alloc( size );
+    } catch( const std::bad_alloc & ) {
+        return nullptr;
+    }
+}
+
+void *operator new[]( std::size_t size, const std::nothrow_t & ) noexcept
+{
+    try {
+        return counted_alloc( size );
+    } catch( const std::bad_alloc & ) {
+        return nullptr;
+    }
+}
+
+void *operator new( std::size_t size, std::align_val_t alignment )
+{
+    return counted_alloc( size, static_cast<std::size_t>( alignment ) );
+}
+
+void *operator new[]( std::size_t size, std::align_val_t alignment )
+{
+    return counted_alloc( size, static_cast<std::size_t>( alignment ) );
+}
+
+void *operator new( std::size_t size, std::align_val_t alignment,
+                    const std::nothrow_t & ) noexcept
+{
+    try {
+        return counted_alloc( size, static_cast<std::size_t>( alignment ) );
+    } catch( const std::bad_alloc & ) {
+        return nullptr;
+    }
+}
+
+void *operator new[]( std::size_t size, std::align_val_t alignment,
+                      const std::nothrow_t & ) noexcept
+{
+    try {
+        return counted_alloc( size, static_cast<std::size_t>( alignment ) );
+    } catch( const std::bad_alloc & ) {
+        return nullptr;
+    }
+}
+
+void operator delete( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p, const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, std::align_val_t ) noexcept
+{
+    aligned_free( p );
+}
+
+void operator delete[]( void *p, std::align_val_t ) noexcept
+{
+    aligned_free( p );
+}
+
+void operator delete( void *p, std::size_t, std::align_val_t ) noexcept
+{
+    aligned_free( p );
+}
+
+void operator delete[]( void *p, std::size_t, std::align_val_t ) noexcept
+{
+    aligned_free( p );
+}
+
+void operator delete( void *p, std::align_val_t, const std::nothrow_t & ) noexcept
+{
+    aligned_free( p );
+}
+
+void operator delete[]( void *p, std::align_val_t, const std::nothrow_t & ) noexcept
+{
+    aligned_free( p );
+}
+
+#endif
@@ -1,5 +1,95 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <source_location>
+#include <vector>
+
+/**
+ * Built-in zone timing, used when the game is not built with Tracy.
+ *
+ * Every ZoneScoped / ZoneScopedN site owns a constant-initialized
+ * @ref cata::profile::zone_site that accumulates call count and inclusive wall time
+ * while @ref cata::profile::collecting is set. Zones may run on worker threads, so
+ * the statistics are atomic. Collection is off by default and costs a branch per zone
+ * when off.
+ */
+namespace cata::profile
+{
+
+extern std::atomic<bool> collecting;
+
+struct zone_site {
+    constexpr explicit zone_site( const char *name,
+                                  const std::source_location &location = std::source_location::current() )
+        : name( name ), location( location ) {}
+
+    const char *name;
+    // Where the zone is, since names of ZoneScoped sites in lambdas can repeat
+    std::source_location location;
+    std::atomic<uint64_t> calls{ 0 };
+    std::atomic<int64_t> total_ns{ 0 };
+    // Whether the site is in the list returned by zone_sites()
+    std::atomic<bool> registered{ false };
+
+    std::chrono::nanoseconds total() const {
+        return std::chrono::nanoseconds( total_ns.load( std::memory_order_relaxed ) );
+    }
+};
+
+void register_site( zone_site &site );
+
+class scoped_zone
+{
+    public:
+        explicit scoped_zone( zone_site &site ) : site( site ),
+            active( collecting.load( std::memory_order_relaxed ) ) {
+            if( active ) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        ~scoped_zone() {
+            if( active ) {
+                const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+                if( !site.registered.load( std::memory_order_acquire ) ) {
+                    register_site( site );
+                }
+                site.calls.fetch_add( 1, std::memory_order_relaxed );
+                site.total_ns.fetch_add( elapsed.count(), std::memory_order_relaxed );
+            }
+        }
+        scoped_zone( const scoped_zone & ) = delete;
+        scoped_zone &operator=( const scoped_zone & ) = delete;
+
+    private:
+        zone_site &site;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+};
+
+/** All zone sites reached while collecting. */
+std::vector<zone_site *> zone_sites();
+/** Zeroes the statistics of all zone sites and the allocation counters. */
+void reset();
+/** Whether this build counts allocations, see CATA_COUNT_ALLOCATIONS. */
+bool counts_allocations();
+/**
+ * Number of calls to the global operator new since the last @ref reset. Always 0
+ * unless @ref counts_allocations.
+ */
+uint64_t allocation_count();
+/** Largest size requested from the global operator new since the last @ref reset. */
+uint64_t largest_allocation();
+
+} // namespace cata::profile
+
+#define CATA_PROFILE_CONCAT_IMPL(a,b) a##b
+#define CATA_PROFILE_CONCAT(a,b) CATA_PROFILE_CONCAT_IMPL(a,b)
+#define CATA_PROFILE_ZONE(name) \
+    static constinit cata::profile::zone_site CATA_PROFILE_CONCAT(cata_zone_site_, __LINE__)( name ); \
+    const cata::profile::scoped_zone CATA_PROFILE_CONCAT(cata_zone_, __LINE__)( CATA_PROFILE_CONCAT(cata_zone_site_, __LINE__) )
+
 #if defined(USE_TRACY)
 #   include "tracy/Tracy.hpp"
 #else
@@ -16,8 +106,8 @@
 #define ZoneTransient(x,y)
 #define ZoneTransientN(x,y,z)
 
-#define ZoneScoped
-#define ZoneScopedN(x)
+#define ZoneScoped CATA_PROFILE_ZONE( std::source_location::current().function_name() )
+#define ZoneScopedN(x) CATA_PROFILE_ZONE( x )
 #define ZoneScopedC(x)
 #define ZoneScopedNC(x,y)
 
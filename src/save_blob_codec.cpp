@@ -0,0 +1,224 @@
+#include "save_blob_codec.h"
+
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "compress.h"
+#include "debug.h"
+#include "sqlite3.h"
+
+#define dbg(x) DebugLogFL((x),DC::Main)
+
+static const std::string dictionary_codec_prefix = "zlib_dict:";
+static const std::string block_codec = "deflate_blocks";
+
+save_blob_category save_blob_category_of( const std::string &path )
+{
+    if( path.starts_with( "maps/" ) && path.ends_with( ".map" ) ) {
+        return save_blob_category::submap;
+    }
+    if( path.starts_with( "o." ) ) {
+        return save_blob_category::overmap;
+    }
+    if( path.ends_with( ".mmr" ) ) {
+        return save_blob_category::map_memory;
+    }
+    if( path.find( ".seen." ) != std::string::npos ) {
+        return save_blob_category::overmap_visibility;
+    }
+    return save_blob_category::other;
+}
+
+const char *save_blob_category_name( save_blob_category cat )
+{
+    switch( cat ) {
+        case save_blob_category::submap:
+            return "submap";
+        case save_blob_category::overmap:
+            return "overmap";
+        case save_blob_category::map_memory:
+            return "map_memory";
+        case save_blob_category::overmap_visibility:
+            return "overmap_visibility";
+        case save_blob_category::other:
+        case save_blob_category::num_categories:
+            break;
+    }
+    return "other";
+}
+
+save_blob_codec::save_blob_codec( sqlite3 *db ) : db( db )
+{
+    // Databases written by older versions and opened read-only have no dictionaries yet
+    const char *sql = "SELECT category, MAX(id) FROM dictionaries GROUP BY category";
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        return;
+    }
+    while( sqlite3_step( stmt ) == SQLITE_ROW ) {
+        const auto category_raw = sqlite3_column_text( stmt, 0 );
+        const std::string category = category_raw ? reinterpret_cast<const char *>( category_raw ) : "";
+        for( int i = 0; i < static_cast<int>( save_blob_category::other ); i++ ) {
+            if( category == save_blob_category_name( static_cast<save_blob_category>( i ) ) ) {
+                categories[i].dictionary_id = sqlite3_column_int( stmt, 1 );
+            }
+        }
+    }
+    sqlite3_finalize( stmt );
+}
+
+std::string save_blob_codec::compress( save_blob_category cat, const std::string &data,
+                                       std::vector<std::byte> &output )
+{
+    if( cat == save_blob_category::other ) {
+        zlib_compress( data, output );
+        return "zlib";
+    }
+
+    if( wants_sample( cat ) ) {
+        add_sample( cat, std::string( data, 0, sample_prefix ) );
+    }
+    const category_state &state = categories[static_cast<size_t>( cat )];
+    if( state.dictionary_id <= 0 ) {
+        zlib_compress( data, output );
+        return "zlib";
+    }
+    zlib_compress( data, get_dictionary( state.dictionary_id ), output );
+    return dictionary_codec_prefix + std::to_string( state.dictionary_id );
+}
+
+void save_blob_codec::decompress( const std::string &codec, const void *data, int size,
+                                  std::string &output )
+{
+    if( codec.empty() ) {
+        output = std::string( static_cast<const char *>( data ), size );
+    } else if( codec == "zlib" ) {
+        zlib_decompress( data, size, output );
+    } else if( codec.starts_with( dictionary_codec_prefix ) ) {
+        const int id = std::stoi( codec.substr( dictionary_codec_prefix.size() ) );
+        zlib_decompress( data, size, get_dictionary( id ), output );
+    } else if( codec.starts_with( block_codec ) ) {
+        const std::unique_ptr<std::streambuf> buf = open_stream( codec, size,
+        [data]( size_t offset, size_t n, std::byte * out ) {
+            std::memcpy( out, static_cast<const std::byte *>( data ) + offset, n );
+        } );
+        output.clear();
+        std::array<char, 4096> chunk;
+        std::streamsize got;
+        while( ( got = buf->sgetn( chunk.data(), chunk.size() ) ) > 0 ) {
+            output.append( chunk.data(), got );
+        }
+    } else {
+        throw std::runtime_error( "Unknown compression format: " + codec );
+    }
+}
+
+std::string save_blob_codec::stream_codec( save_blob_category cat,
+        const std::string *&dictionary )
+{
+    dictionary = nullptr;
+    if( cat == save_blob_category::other ) {
+        return block_codec;
+    }
+    const category_state &state = categories[static_cast<size_t>( cat )];
+    if( state.dictionary_id <= 0 ) {
+        return block_codec;
+    }
+    dictionary = &get_dictionary( state.dictionary_id );
+    return block_codec + ":" + std::to_string( state.dictionary_id );
+}
+
+bool save_blob_codec::wants_sample( save_blob_category cat ) const
+{
+    return cat != save_blob_category::other &&
+           categories[static_cast<size_t>( cat )].dictionary_id == 0;
+}
+
+void save_blob_codec::add_sample( save_blob_category cat, std::string &&sample )
+{
+    category_state &state = categories[static_cast<size_t>( cat )];
+    state.samples.push_back( std::move( sample ) );
+    if( state.samples.size() >= static_cast<size_t>( samples_per_dictionary ) ) {
+        train_dictionary( cat );
+    }
+}
+
+std::unique_ptr<std::streambuf> save_blob_codec::open_stream( const std::string &codec,
+        size_t size, inflate_block_streambuf::read_fn read )
+{
+    if( codec == block_codec ) {
+        return std::make_unique<inflate_block_streambuf>( size, std::move( read ), nullptr );
+    }
+    if( codec.starts_with( block_codec + ":" ) ) {
+        const int id = std::stoi( codec.substr( block_codec.size() + 1 ) );
+        return std::make_unique<inflate_block_streambuf>( size, std::move( read ),
+                &get_dictionary( id ) );
+    }
+
+    std::vector<std::byte> data( size );
+    read( 0, size, data.data() );
+    std::string output;
+    decompress( codec, data.data(), static_cast<int>( size ), output );
+    return std::make_unique<std::stringbuf>( std::move( output ) );
+}
+
+const std::string &save_blob_codec::get_dictionary( int id )
+{
+    const auto it = dictionaries.find( id );
+    if( it != dictionaries.end() ) {
+        return it->second;
+    }
+
+    const char *sql = "SELECT data FROM dictionaries WHERE id = :id";
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    if( sqlite3_bind_int( stmt, sqlite3_bind_parameter_index( stmt, ":id" ), id ) != SQLITE_OK ||
+        sqlite3_step( stmt ) != SQLITE_ROW ) {
+        sqlite3_finalize( stmt );
+        throw std::runtime_error( "Missing compression dictionary " + std::to_string( id ) );
+    }
+    const void *blobData = sqlite3_column_blob( stmt, 0 );
+    const int blobSize = sqlite3_column_bytes( stmt, 0 );
+    std::string dictionary = blobData ? std::string( static_cast<const char *>( blobData ),
+                             blobSize ) : std::string();
+    sqlite3_finalize( stmt );
+    return dictionaries.emplace( id, std::move( dictionary ) ).first->second;
+}
+
+void save_blob_codec::train_dictionary( save_blob_category cat )
+{
+    category_state &state = categories[static_cast<size_t>( cat )];
+    std::string dictionary = train_compression_dictionary( state.samples );
+    state.samples.clear();
+    state.samples.shrink_to_fit();
+    // Without a dictionary, the category stays on plain zlib and stops collecting samples
+    state.dictionary_id = -1;
+    if( dictionary.empty() ) {
+        return;
+    }
+
+    const char *sql = "INSERT INTO dictionaries(category, data) VALUES (:category, :data)";
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        return;
+    }
+    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":category" ),
+                           save_blob_category_name( cat ), -1, SQLITE_STATIC ) != SQLITE_OK ||
+        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), dictionary.data(),
+                           dictionary.size(), SQLITE_STATIC ) != SQLITE_OK ||
+        sqlite3_step( stmt ) != SQLITE_DONE ) {
+        dbg( DL::Error ) << "Failed to store compression dictionary: " << sqlite3_errmsg( db ) << '\n';
+        sqlite3_finalize( stmt );
+        return;
+    }
+    sqlite3_finalize( stmt );
+
+    state.dictionary_id = static_cast<int>( sqlite3_last_insert_rowid( db ) );
+    dictionaries.emplace( state.dictionary_id, std::move( dictionary ) );
+}
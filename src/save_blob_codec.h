@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "compress.h"
+
+class sqlite3;
+
+/** Kinds of save blobs that get their own compression dictionary. */
+enum class save_blob_category : int {
+    submap,
+    overmap,
+    map_memory,
+    // Which overmap tiles a player has seen or explored
+    overmap_visibility,
+    // Anything else, compressed without a dictionary
+    other,
+    num_categories
+};
+
+/** Category of the blob stored at path in a save database. */
+save_blob_category save_blob_category_of( const std::string &path );
+const char *save_blob_category_name( save_blob_category cat );
+
+/**
+ * Compresses and decompresses the blobs of one save database.
+ *
+ * Blobs are compressed with zlib. After @ref samples_per_dictionary blobs of a category
+ * were written, a dictionary is trained from them and stored in the `dictionaries` table.
+ * Later blobs of that category are compressed with the dictionary. The `compression`
+ * column of a row names its codec: "zlib", or "zlib_dict:<id>" for zlib with the
+ * dictionary of that id. Rows written before dictionaries existed read as plain zlib.
+ *
+ * Streamed blobs use "deflate_blocks" or "deflate_blocks:<id>", the format of
+ * @ref deflate_block_streambuf, so they can be written and read in bounded memory.
+ */
+class save_blob_codec
+{
+    public:
+        explicit save_blob_codec( sqlite3 *db );
+
+        sqlite3 *get_db() const {
+            return db;
+        }
+
+        /** Compresses a blob of the category. @returns The codec to record for the row. */
+        std::string compress( save_blob_category cat, const std::string &data,
+                              std::vector<std::byte> &output );
+        /** Decompresses a blob stored with the given codec. Throws if the codec is unknown. */
+        void decompress( const std::string &codec, const void *data, int size, std::string &output );
+
+        /**
+         * Codec to record for a new streamed blob of the category. Sets dictionary to the
+         * dictionary to compress it with, or nullptr.
+         */
+        std::string stream_codec( save_blob_category cat, const std::string *&dictionary );
+        /** Whether the start of the next blob of the category should go to @ref add_sample. */
+        bool wants_sample( save_blob_category cat ) const;
+        void add_sample( save_blob_category cat, std::string &&sample );
+        /**
+         * Opens a stream over a stored blob of size bytes, read through read. Blobs of
+         * whole-buffer codecs are decompressed up front. Throws if the codec is unknown.
+         */
+        std::unique_ptr<std::streambuf> open_stream( const std::string &codec, size_t size,
+                inflate_block_streambuf::read_fn read );
+
+        /** Number of blobs of a category collected before a dictionary is trained. */
+        static constexpr int samples_per_dictionary = 32;
+        /**
+         * Bytes taken from the start of each sample. The dictionary only precedes the start
+         * of a blob in the zlib window, so that is what it should resemble.
+         */
+        static constexpr size_t sample_prefix = 64 * 1024;
+
+    private:
+        struct category_state {
+            // Dictionary for new blobs, 0 if there is none yet
+            int dictionary_id = 0;
+            std::vector<std::string> samples;
+        };
+
+        const std::string &get_dictionary( int id );
+        void train_dictionary( save_blob_category cat );
+
+        sqlite3 *db;
+        std::array<category_state, static_cast<size_t>( save_blob_category::num_categories )>
+        categories;
+        std::unordered_map<int, std::string> dictionaries;
+};
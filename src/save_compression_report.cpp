@@ -0,0 +1,218 @@
+#include "save_compression_report.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <random>
+#include <vector>
+
+#include "compress.h"
+#include "filesystem.h"
+#include "path_info.h"
+#include "save_blob_codec.h"
+#include "save_database.h"
+#include "sqlite3.h"
+#include "string_formatter.h"
+
+namespace save_compression_report
+{
+
+namespace
+{
+
+using duration = std::chrono::duration<double>;
+
+// Compression is measured on at most this many blobs of each category
+constexpr size_t max_sampled_blobs = 1000;
+
+struct blob_set {
+    size_t count = 0;
+    size_t raw_bytes = 0;
+    size_t stored_bytes = 0;
+    // Uniform random sample of the blobs read so far
+    std::vector<std::string> sampled;
+    size_t sampled_bytes = 0;
+};
+
+using category_blobs = std::array<blob_set,
+      static_cast<size_t>( save_blob_category::num_categories )>;
+
+// Blobs are decompressed one at a time and only the sampled ones are kept
+bool read_database( const std::string &path, category_blobs &out, std::minstd_rand &rng )
+{
+    sqlite3 *db = nullptr;
+    if( sqlite3_open_v2( path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr ) != SQLITE_OK ) {
+        cata_printf( "Failed to open %s\n", path );
+        sqlite3_close( db );
+        return false;
+    }
+
+    save_blob_codec codec( db );
+    const auto add_blob = [&]( save_blob_category cat, sqlite3_stmt * stmt, int column ) {
+        const auto compression_raw = sqlite3_column_text( stmt, column );
+        const void *blobData = sqlite3_column_blob( stmt, column + 1 );
+        const int blobSize = sqlite3_column_bytes( stmt, column + 1 );
+        if( blobData == nullptr ) {
+            return;
+        }
+        const std::string compression = compression_raw ?
+                                        reinterpret_cast<const char *>( compression_raw ) : "";
+        blob_set &set = out[static_cast<size_t>( cat )];
+        std::string data;
+        codec.decompress( compression, blobData, blobSize, data );
+        set.count++;
+        set.raw_bytes += data.size();
+        set.stored_bytes += blobSize;
+        if( set.sampled.size() < max_sampled_blobs ) {
+            set.sampled_bytes += data.size();
+            set.sampled.push_back( std::move( data ) );
+            return;
+        }
+        const size_t replaced = std::uniform_int_distribution<size_t>( 0, set.count - 1 )( rng );
+        if( replaced < max_sampled_blobs ) {
+            set.sampled_bytes += data.size();
+            set.sampled_bytes -= set.sampled[replaced].size();
+            set.sampled[replaced] = std::move( data );
+        }
+    };
+
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, "SELECT path, compression, data FROM files", -1, &stmt,
+                            nullptr ) != SQLITE_OK ) {
+        cata_printf( "Failed to read %s: %s\n", path, sqlite3_errmsg( db ) );
+        sqlite3_close( db );
+        return false;
+    }
+    while( sqlite3_step( stmt ) == SQLITE_ROW ) {
+        const auto path_raw = sqlite3_column_text( stmt, 0 );
+        if( path_raw != nullptr ) {
+            add_blob( save_blob_category_of( reinterpret_cast<const char *>( path_raw ) ), stmt, 1 );
+        }
+    }
+    sqlite3_finalize( stmt );
+
+    // Databases that were not opened since schema version 3 have no typed tables
+    for( int i = 0; i < static_cast<int>( save_table::num_tables ); i++ ) {
+        const save_table table = static_cast<save_table>( i );
+        const std::string sql = string_format( "SELECT compression, data FROM %s",
+                                               save_table_name( table ) );
+        if( sqlite3_prepare_v2( db, sql.c_str(), -1, &stmt, nullptr ) != SQLITE_OK ) {
+            continue;
+        }
+        while( sqlite3_step( stmt ) == SQLITE_ROW ) {
+            add_blob( save_table_category( table ), stmt, 0 );
+        }
+        sqlite3_finalize( stmt );
+    }
+    sqlite3_close( db );
+    return true;
+}
+
+template<typename Fn>
+double seconds( Fn &&fn )
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return duration( std::chrono::steady_clock::now() - start ).count();
+}
+
+double mib( size_t bytes )
+{
+    return bytes / ( 1024.0 * 1024.0 );
+}
+
+void report_category( save_blob_category cat, const blob_set &set )
+{
+    std::vector<std::vector<std::byte>> compressed( set.sampled.size() );
+    std::string decompressed;
+    size_t plain_bytes = 0;
+    const double plain_compress = seconds( [&]() {
+        for( size_t i = 0; i < set.sampled.size(); i++ ) {
+            zlib_compress( set.sampled[i], compressed[i] );
+            plain_bytes += compressed[i].size();
+        }
+    } );
+    const double plain_decompress = seconds( [&]() {
+        for( const std::vector<std::byte> &blob : compressed ) {
+            zlib_decompress( blob.data(), blob.size(), decompressed );
+        }
+    } );
+
+    std::string dictionary;
+    size_t dict_bytes = 0;
+    double train = 0.0;
+    double dict_compress = 0.0;
+    double dict_decompress = 0.0;
+    if( cat != save_blob_category::other ) {
+        std::vector<std::string> samples;
+        for( size_t i = 0; i < set.sampled.size() &&
+             i < static_cast<size_t>( save_blob_codec::samples_per_dictionary ); i++ ) {
+            samples.emplace_back( set.sampled[i], 0, save_blob_codec::sample_prefix );
+        }
+        train = seconds( [&]() {
+            dictionary = train_compression_dictionary( samples );
+        } );
+        dict_compress = seconds( [&]() {
+            for( size_t i = 0; i < set.sampled.size(); i++ ) {
+                zlib_compress( set.sampled[i], dictionary, compressed[i] );
+                dict_bytes += compressed[i].size();
+            }
+        } );
+        dict_decompress = seconds( [&]() {
+            for( const std::vector<std::byte> &blob : compressed ) {
+                zlib_decompress( blob.data(), blob.size(), dictionary, decompressed );
+            }
+        } );
+    }
+
+    const double raw = mib( set.sampled_bytes );
+    cata_printf( "%s: %d blobs, %.2f MiB raw, %.2f MiB stored\n", save_blob_category_name( cat ),
+                 set.count, mib( set.raw_bytes ), mib( set.stored_bytes ) );
+    if( set.sampled.size() < set.count ) {
+        cata_printf( "  measured on %d sampled blobs, %.2f MiB raw\n", set.sampled.size(), raw );
+    }
+    cata_printf( "  zlib:       %8.2f MiB (%5.1f%%), compress %7.1f MiB/s, decompress %7.1f MiB/s\n",
+                 mib( plain_bytes ), 100.0 * plain_bytes / set.sampled_bytes, raw / plain_compress,
+                 raw / plain_decompress );
+    if( cat != save_blob_category::other ) {
+        cata_printf( "  zlib+dict:  %8.2f MiB (%5.1f%%), compress %7.1f MiB/s, decompress %7.1f MiB/s\n",
+                     mib( dict_bytes ), 100.0 * dict_bytes / set.sampled_bytes, raw / dict_compress,
+                     raw / dict_decompress );
+        cata_printf( "  dictionary: %d bytes trained in %.1f ms\n", dictionary.size(), train * 1000.0 );
+    }
+}
+
+} // namespace
+
+int run( const std::string &world )
+{
+    const std::string world_path = dir_exist( world ) ? world : PATH_INFO::savedir() + world;
+    const std::vector<std::string> databases = get_files_from_path( ".sqlite3", world_path, false,
+            true );
+    if( databases.empty() ) {
+        cata_printf( "No save databases found in %s\n", world_path );
+        return 1;
+    }
+
+    category_blobs blobs;
+    std::minstd_rand rng;
+    for( const std::string &db_path : databases ) {
+        try {
+            if( !read_database( db_path, blobs, rng ) ) {
+                return 1;
+            }
+        } catch( const std::exception &err ) {
+            cata_printf( "Failed to read %s: %s\n", db_path, err.what() );
+            return 1;
+        }
+    }
+    for( size_t i = 0; i < blobs.size(); i++ ) {
+        if( !blobs[i].sampled.empty() && blobs[i].sampled_bytes > 0 ) {
+            report_category( static_cast<save_blob_category>( i ), blobs[i] );
+        }
+    }
+    return 0;
+}
+
+} // namespace save_compression_report
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+/**
+ * Measures save blob compression on an existing world.
+ *
+ * Reads every blob of the world's save databases and prints, per blob category, the
+ * raw and stored size. The size and speed of plain zlib and of zlib with a dictionary
+ * trained the way @ref save_blob_codec trains it are measured on a random sample of
+ * the category's blobs, so memory use does not grow with the size of the world.
+ */
+namespace save_compression_report
+{
+
+/**
+ * Runs the report for a world, given as a directory or as a world name in the save
+ * directory. The world is opened read-only. @return Process exit code.
+ */
+int run( const std::string &world );
+
+} // namespace save_compression_report
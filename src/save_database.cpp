@@ -0,0 +1,593 @@
+#include "save_database.h"
+
+#include <charconv>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "debug.h"
+#include "sqlite3.h"
+#include "string_formatter.h"
+
+#define dbg(x) DebugLogFL((x),DC::Main)
+
+namespace
+{
+
+struct table_def {
+    const char *name;
+    bool has_z;
+    save_blob_category category;
+};
+
+constexpr std::array<table_def, static_cast<size_t>( save_table::num_tables )> table_defs = {{
+        { "map_quads", true, save_blob_category::submap },
+        { "overmaps", false, save_blob_category::overmap },
+        { "map_memory", true, save_blob_category::map_memory },
+        { "overmap_visibility", false, save_blob_category::overmap_visibility },
+    }
+};
+
+const table_def &def_of( save_table table )
+{
+    return table_defs[static_cast<size_t>( table )];
+}
+
+// Resets a cached statement when leaving scope, which also ends the read it was doing.
+struct statement_reset {
+    sqlite3_stmt *stmt;
+    ~statement_reset() {
+        sqlite3_reset( stmt );
+    }
+};
+
+struct statement_finalize {
+    sqlite3_stmt *stmt;
+    ~statement_finalize() {
+        sqlite3_finalize( stmt );
+    }
+};
+
+struct blob_close {
+    sqlite3_blob *blob;
+    ~blob_close() {
+        sqlite3_blob_close( blob );
+    }
+};
+
+// Parses exactly count integers separated by dots.
+bool parse_coords( std::string_view text, int count, tripoint &out )
+{
+    std::array<int, 3> values = { 0, 0, 0 };
+    for( int i = 0; i < count; i++ ) {
+        const auto [end, error] = std::from_chars( text.data(), text.data() + text.size(), values[i] );
+        if( error != std::errc() ) {
+            return false;
+        }
+        text.remove_prefix( end - text.data() );
+        if( i + 1 < count ) {
+            if( text.empty() || text.front() != '.' ) {
+                return false;
+            }
+            text.remove_prefix( 1 );
+        }
+    }
+    out = tripoint( values[0], values[1], values[2] );
+    return text.empty();
+}
+
+// Finds the typed table and key of a path of the V1 directory layout.
+bool typed_key_of( std::string_view path, save_table &table, tripoint &key )
+{
+    if( path.starts_with( "maps/" ) && path.ends_with( ".map" ) ) {
+        path.remove_prefix( path.find_last_of( '/' ) + 1 );
+        path.remove_suffix( 4 );
+        table = save_table::map_quads;
+        return parse_coords( path, 3, key );
+    }
+    if( path.starts_with( "o." ) ) {
+        table = save_table::overmaps;
+        return parse_coords( path.substr( 2 ), 2, key );
+    }
+    if( path.starts_with( ".seen." ) ) {
+        table = save_table::overmap_visibility;
+        return parse_coords( path.substr( 6 ), 2, key );
+    }
+    if( path.ends_with( ".mmr" ) ) {
+        path.remove_suffix( 4 );
+        table = save_table::map_memory;
+        return parse_coords( path, 3, key );
+    }
+    return false;
+}
+
+void exec_or_throw( sqlite3 *db, const std::string &sql )
+{
+    char *sqlErrMsg = nullptr;
+    if( sqlite3_exec( db, sql.c_str(), nullptr, nullptr, &sqlErrMsg ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to execute query: " << ( sqlErrMsg ? sqlErrMsg : "" ) << '\n';
+        sqlite3_free( sqlErrMsg );
+        throw std::runtime_error( "DB query failed" );
+    }
+}
+
+sqlite3 *open_db( const std::string &path )
+{
+    sqlite3 *db = nullptr;
+    int ret;
+
+    ret = sqlite3_initialize();
+    if( ret != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to initialize sqlite3 (Error " << ret << ")";
+        throw std::runtime_error( "Failed to initialize sqlite3" );
+    }
+
+    ret = sqlite3_open_v2( path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL );
+    if( ret != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to open db" << path << " (Error " << ret << ")";
+        sqlite3_close( db );
+        throw std::runtime_error( "Failed to open db" );
+    }
+
+    // The page size only applies to new databases. Map quads are a few KiB compressed,
+    // larger pages keep most of them out of overflow chains.
+    std::string sql = R"sql(
+        PRAGMA page_size = 16384;
+        PRAGMA journal_mode = WAL;
+        PRAGMA synchronous = NORMAL;
+        CREATE TABLE IF NOT EXISTS files (
+            path           TEXT PRIMARY KEY NOT NULL,
+            parent         TEXT NOT NULL,
+            compression    TEXT DEFAULT NULL,
+            data           BLOB NOT NULL
+        );
+        CREATE TABLE IF NOT EXISTS dictionaries (
+            id             INTEGER PRIMARY KEY,
+            category       TEXT NOT NULL,
+            data           BLOB NOT NULL
+        );
+    )sql";
+    for( const table_def &def : table_defs ) {
+        sql += string_format( R"sql(
+        CREATE TABLE IF NOT EXISTS %s (
+            x              INTEGER NOT NULL,
+            y              INTEGER NOT NULL,%s
+            compression    TEXT DEFAULT NULL,
+            data           BLOB NOT NULL,
+            PRIMARY KEY (x, y%s)
+        );
+        )sql", def.name, def.has_z ? "\n            z              INTEGER NOT NULL," : "",
+                              def.has_z ? ", z" : "" );
+    }
+
+    char *sqlErrMsg = 0;
+    ret = sqlite3_exec( db, sql.c_str(), NULL, NULL, &sqlErrMsg );
+    if( ret != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to init db" << path << " (" << ( sqlErrMsg ? sqlErrMsg : "" ) << ")";
+        sqlite3_free( sqlErrMsg );
+        sqlite3_close( db );
+        throw std::runtime_error( "Failed to open db" );
+    }
+
+    return db;
+}
+
+} // namespace
+
+const char *save_table_name( save_table table )
+{
+    return def_of( table ).name;
+}
+
+save_blob_category save_table_category( save_table table )
+{
+    return def_of( table ).category;
+}
+
+save_database::save_database( const std::string &path )
+    : db( open_db( path ) )
+    , codec( db )
+{
+    // The destructor doesn't run if the constructor throws
+    try {
+        migrate_files_table();
+    } catch( ... ) {
+        close();
+        throw;
+    }
+}
+
+save_database::~save_database()
+{
+    close();
+}
+
+void save_database::close()
+{
+    for( auto &table_statements : statements ) {
+        for( sqlite3_stmt *&stmt : table_statements ) {
+            sqlite3_finalize( stmt );
+            stmt = nullptr;
+        }
+    }
+    sqlite3_close( db );
+    db = nullptr;
+}
+
+sqlite3_stmt *save_database::get_statement( save_table table, statement_kind kind )
+{
+    sqlite3_stmt *&stmt = statements[static_cast<size_t>( table )][static_cast<size_t>( kind )];
+    if( stmt != nullptr ) {
+        sqlite3_clear_bindings( stmt );
+        return stmt;
+    }
+
+    // Parameters are ?1 x, ?2 y, ?3 z, ?4 compression and ?5 data
+    const table_def &def = def_of( table );
+    const char *key_where = def.has_z ? "x = ?1 AND y = ?2 AND z = ?3" : "x = ?1 AND y = ?2";
+    std::string sql;
+    switch( kind ) {
+        case statement_kind::exists:
+            sql = string_format( "SELECT 1 FROM %s WHERE %s LIMIT 1", def.name, key_where );
+            break;
+        case statement_kind::select:
+            // Blobs that fit on a page come with the row, larger ones are streamed by rowid
+            sql = string_format( R"sql(
+                SELECT compression, rowid, CASE WHEN length(data) <= %d THEN data END
+                FROM %s WHERE %s
+            )sql", inline_read_size, def.name, key_where );
+            break;
+        case statement_kind::upsert:
+            sql = string_format( R"sql(
+                INSERT INTO %s(x, y%s, compression, data)
+                VALUES (?1, ?2%s, ?4, ?5)
+                ON CONFLICT(x, y%s) DO UPDATE
+                    SET compression = excluded.compression,
+                        data = excluded.data;
+            )sql", def.name, def.has_z ? ", z" : "", def.has_z ? ", ?3" : "", def.has_z ? ", z" : "" );
+            break;
+        case statement_kind::rowid:
+            // An upsert that updates doesn't set sqlite3_last_insert_rowid
+            sql = string_format( "SELECT rowid FROM %s WHERE %s", def.name, key_where );
+            break;
+        case statement_kind::num_kinds:
+            break;
+    }
+
+    if( sqlite3_prepare_v3( db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt,
+                            nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        stmt = nullptr;
+        throw std::runtime_error( "DB query failed" );
+    }
+    return stmt;
+}
+
+void save_database::bind_key( sqlite3_stmt *stmt, save_table table, const tripoint &key )
+{
+    if( sqlite3_bind_int( stmt, 1, key.x ) != SQLITE_OK ||
+        sqlite3_bind_int( stmt, 2, key.y ) != SQLITE_OK ||
+        ( def_of( table ).has_z && sqlite3_bind_int( stmt, 3, key.z ) != SQLITE_OK ) ) {
+        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+}
+
+bool save_database::exists( save_table table, const tripoint &key )
+{
+    sqlite3_stmt *stmt = get_statement( table, statement_kind::exists );
+    statement_reset reset{ stmt };
+    bind_key( stmt, table, key );
+
+    const int ret = sqlite3_step( stmt );
+    if( ret != SQLITE_ROW && ret != SQLITE_DONE ) {
+        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    return ret == SQLITE_ROW;
+}
+
+bool save_database::read( save_table table, const tripoint &key, file_read_fn reader,
+                          bool optional )
+{
+    sqlite3_stmt *stmt = get_statement( table, statement_kind::select );
+    std::string compression;
+    sqlite3_int64 rowid;
+    std::string inline_data;
+    bool is_inline = false;
+    {
+        statement_reset reset{ stmt };
+        bind_key( stmt, table, key );
+
+        if( sqlite3_step( stmt ) != SQLITE_ROW ) {
+            if( !optional ) {
+                dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+                throw std::runtime_error( "DB query failed" );
+            }
+            return false;
+        }
+
+        const auto compression_raw = sqlite3_column_text( stmt, 0 );
+        compression = compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "";
+        rowid = sqlite3_column_int64( stmt, 1 );
+        const void *blob_data = sqlite3_column_blob( stmt, 2 );
+        if( blob_data != nullptr ) {
+            codec.decompress( compression, blob_data, sqlite3_column_bytes( stmt, 2 ), inline_data );
+            is_inline = true;
+        }
+    }
+
+    if( is_inline ) {
+        std::istringstream stream( inline_data );
+        stream.exceptions( std::ios::badbit );
+        reader( stream );
+        return true;
+    }
+
+    sqlite3_blob *blob = nullptr;
+    if( sqlite3_blob_open( db, "main", save_table_name( table ), "data", rowid, 0,
+                           &blob ) != SQLITE_OK ) {
+        sqlite3_blob_close( blob );
+        dbg( DL::Error ) << "Failed to open blob: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    blob_close close{ blob };
+
+    const std::unique_ptr<std::streambuf> buf = codec.open_stream( compression,
+            sqlite3_blob_bytes( blob ), [this, blob]( size_t offset, size_t size, std::byte * out ) {
+        if( sqlite3_blob_read( blob, out, size, offset ) != SQLITE_OK ) {
+            dbg( DL::Error ) << "Failed to read blob: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+    } );
+    std::istream stream( buf.get() );
+    // Otherwise read errors thrown by the buffer only set badbit and look like bad JSON
+    stream.exceptions( std::ios::badbit );
+    reader( stream );
+    return true;
+}
+
+size_t save_database::write( save_table table, const tripoint &key, file_write_fn writer )
+{
+    const save_blob_category cat = save_table_category( table );
+    const std::string *dictionary = nullptr;
+    const std::string compression = codec.stream_codec( cat, dictionary );
+    const bool sampled = codec.wants_sample( cat );
+    std::string sample;
+
+    deflate_block_streambuf buf( dictionary, sampled ? &sample : nullptr,
+                                 save_blob_codec::sample_prefix );
+    {
+        std::ostream stream( &buf );
+        writer( stream );
+    }
+    buf.finish();
+    if( sampled ) {
+        codec.add_sample( cat, std::move( sample ) );
+    }
+    return store( table, key, compression, buf );
+}
+
+size_t save_database::store( save_table table, const tripoint &key,
+                             const std::string &compression, const void *data, size_t size )
+{
+    upsert( table, key, compression, data, size );
+    return size;
+}
+
+size_t save_database::store( save_table table, const tripoint &key,
+                             const std::string &compression, const deflate_block_streambuf &buf )
+{
+    // A failed write would otherwise leave the old row replaced by zeroes
+    exec_or_throw( db, "SAVEPOINT store_blob" );
+    size_t stored;
+    try {
+        stored = store_chunks( table, key, compression, buf );
+    } catch( ... ) {
+        sqlite3_exec( db, "ROLLBACK TO store_blob; RELEASE store_blob", nullptr, nullptr, nullptr );
+        throw;
+    }
+    exec_or_throw( db, "RELEASE store_blob" );
+    return stored;
+}
+
+size_t save_database::store_chunks( save_table table, const tripoint &key,
+                                    const std::string &compression, const deflate_block_streambuf &buf )
+{
+    // Blobs can't grow through incremental I/O, so the row gets a zeroblob of the final
+    // size that the chunks are then written into
+    upsert( table, key, compression, nullptr, buf.compressed_size() );
+
+    sqlite3_stmt *stmt = get_statement( table, statement_kind::rowid );
+    sqlite3_int64 rowid;
+    {
+        statement_reset reset{ stmt };
+        bind_key( stmt, table, key );
+        if( sqlite3_step( stmt ) != SQLITE_ROW ) {
+            dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+        rowid = sqlite3_column_int64( stmt, 0 );
+    }
+
+    sqlite3_blob *blob = nullptr;
+    if( sqlite3_blob_open( db, "main", save_table_name( table ), "data", rowid, 1,
+                           &blob ) != SQLITE_OK ) {
+        sqlite3_blob_close( blob );
+        dbg( DL::Error ) << "Failed to open blob: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    blob_close close{ blob };
+    size_t offset = 0;
+    for( const std::vector<std::byte> &chunk : buf.get_chunks() ) {
+        if( sqlite3_blob_write( blob, chunk.data(), chunk.size(), offset ) != SQLITE_OK ) {
+            dbg( DL::Error ) << "Failed to write blob: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+        offset += chunk.size();
+    }
+    return offset;
+}
+
+void save_database::upsert( save_table table, const tripoint &key,
+                            const std::string &compression, const void *data, size_t size )
+{
+    sqlite3_stmt *stmt = get_statement( table, statement_kind::upsert );
+    statement_reset reset{ stmt };
+    bind_key( stmt, table, key );
+    const int bound_data = data != nullptr ?
+                           sqlite3_bind_blob( stmt, 5, data, size, SQLITE_STATIC ) :
+                           sqlite3_bind_zeroblob64( stmt, 5, size );
+    if( sqlite3_bind_text( stmt, 4, compression.c_str(), -1, SQLITE_STATIC ) != SQLITE_OK ||
+        bound_data != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+
+    if( sqlite3_step( stmt ) != SQLITE_DONE ) {
+        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+}
+
+size_t save_database::write_file( const std::string &path, file_write_fn writer )
+{
+    save_table table;
+    tripoint key;
+    if( typed_key_of( path, table, key ) ) {
+        return write( table, key, writer );
+    }
+
+    std::ostringstream oss;
+    writer( oss );
+    const std::string data = oss.str();
+    std::vector<std::byte> compressedData;
+    const std::string compression = codec.compress( save_blob_category::other, data,
+                                    compressedData );
+
+    size_t basePos = path.find_last_of( "/\\" );
+    auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
+
+    auto sql = R"sql(
+        INSERT INTO files(path, parent, data, compression)
+        VALUES (:path, :parent, :data, :compression)
+        ON CONFLICT(path) DO UPDATE
+            SET data = excluded.data,
+                parent = excluded.parent,
+                compression = excluded.compression;
+    )sql";
+
+    sqlite3_stmt *stmt = nullptr;
+
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+
+    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
+                           SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), parent.c_str(), -1,
+                           SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), compressedData.data(),
+                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":compression" ),
+                           compression.c_str(), -1, SQLITE_TRANSIENT ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
+        sqlite3_finalize( stmt );
+        throw std::runtime_error( "DB query failed" );
+    }
+
+    if( sqlite3_step( stmt ) != SQLITE_DONE ) {
+        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+    }
+    sqlite3_finalize( stmt );
+    return compressedData.size();
+}
+
+void save_database::checkpoint()
+{
+    if( sqlite3_wal_checkpoint_v2( db, nullptr, SQLITE_CHECKPOINT_TRUNCATE, nullptr,
+                                   nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to checkpoint db: " << sqlite3_errmsg( db ) << '\n';
+    }
+}
+
+void save_database::migrate_files_table()
+{
+    sqlite3_stmt *stmt = nullptr;
+    int version = 0;
+    if( sqlite3_prepare_v2( db, "PRAGMA user_version", -1, &stmt, nullptr ) == SQLITE_OK &&
+        sqlite3_step( stmt ) == SQLITE_ROW ) {
+        version = sqlite3_column_int( stmt, 0 );
+    }
+    sqlite3_finalize( stmt );
+    if( version >= schema_version ) {
+        return;
+    }
+
+    dbg( DL::Info ) << "Migrating save database to schema version " << schema_version;
+    exec_or_throw( db, "BEGIN TRANSACTION" );
+    try {
+        migrate_files_rows();
+        exec_or_throw( db, string_format( "PRAGMA user_version = %d", schema_version ) );
+        exec_or_throw( db, "COMMIT" );
+    } catch( ... ) {
+        // Leaves the database at the old version, with the files table intact
+        sqlite3_exec( db, "ROLLBACK", nullptr, nullptr, nullptr );
+        throw;
+    }
+}
+
+void save_database::migrate_files_rows()
+{
+    // Blobs move as they are, their codecs and dictionaries stay valid
+    sqlite3_stmt *stmt = nullptr;
+    const char *sql = "SELECT path, compression, data FROM files";
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    // Only rows whose copy was stored are deleted, store() throws otherwise
+    std::vector<std::string> migrated;
+    {
+        statement_finalize finalize{ stmt };
+        int ret;
+        while( ( ret = sqlite3_step( stmt ) ) == SQLITE_ROW ) {
+            const auto path_raw = sqlite3_column_text( stmt, 0 );
+            const auto compression_raw = sqlite3_column_text( stmt, 1 );
+            const void *blob_data = sqlite3_column_blob( stmt, 2 );
+            const int blob_size = sqlite3_column_bytes( stmt, 2 );
+            save_table table;
+            tripoint key;
+            if( path_raw == nullptr || blob_data == nullptr ||
+                !typed_key_of( reinterpret_cast<const char *>( path_raw ), table, key ) ) {
+                continue;
+            }
+            store( table, key, compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "",
+                   blob_data, blob_size );
+            migrated.emplace_back( reinterpret_cast<const char *>( path_raw ) );
+        }
+        if( ret != SQLITE_DONE ) {
+            dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+    }
+
+    if( sqlite3_prepare_v2( db, "DELETE FROM files WHERE path = ?1", -1, &stmt,
+                            nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    statement_finalize finalize{ stmt };
+    for( const std::string &path : migrated ) {
+        if( sqlite3_bind_text( stmt, 1, path.c_str(), -1, SQLITE_STATIC ) != SQLITE_OK ||
+            sqlite3_step( stmt ) != SQLITE_DONE ) {
+            dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+        sqlite3_reset( stmt );
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "fstream_utils.h"
+#include "point.h"
+#include "save_blob_codec.h"
+
+class sqlite3;
+struct sqlite3_stmt;
+
+/** Typed tables of a save database, each keyed by integer coordinates. */
+enum class save_table : int {
+    // Map quads, by overmap terrain (x, y, z)
+    map_quads,
+    // Overmaps, by overmap (x, y)
+    overmaps,
+    // Map memory regions, by region (x, y, z)
+    map_memory,
+    // Overmap visibility of a player, by overmap (x, y)
+    overmap_visibility,
+    num_tables
+};
+
+const char *save_table_name( save_table table );
+save_blob_category save_table_category( save_table table );
+
+/**
+ * One sqlite3 save database of a V2 world: the map database, or the database of a player.
+ *
+ * Schema version 3 stores blobs in typed tables keyed by coordinates. The path-keyed
+ * `files` table of version 2 remains for anything else, and its rows are moved into
+ * the typed tables when a version 2 database is opened. Databases use WAL journaling,
+ * and the statements of the typed tables are prepared once and reused.
+ *
+ * Blobs of the typed tables are streamed: writers compress into blocks as they go and
+ * the result goes into the row through incremental blob I/O, readers decompress one
+ * block at a time. Neither holds the uncompressed data in memory, except for blobs of
+ * at most @ref inline_read_size bytes, which are read with their row.
+ */
+class save_database
+{
+    public:
+        /** Opens or creates the database at path, migrating it to the current schema. */
+        explicit save_database( const std::string &path );
+        ~save_database();
+
+        save_database( const save_database & ) = delete;
+        save_database &operator=( const save_database & ) = delete;
+
+        sqlite3 *get_db() const {
+            return db;
+        }
+        save_blob_codec &get_codec() {
+            return codec;
+        }
+
+        /** For tables keyed by (x, y), key.z is ignored. */
+        /**@{*/
+        bool exists( save_table table, const tripoint &key );
+        bool read( save_table table, const tripoint &key, file_read_fn reader, bool optional = true );
+        /** @return Number of bytes stored. */
+        size_t write( save_table table, const tripoint &key, file_write_fn writer );
+        /**@}*/
+
+        /**
+         * Writes a file of the V1 directory layout, into its typed table if it has one.
+         * @return Number of bytes stored.
+         */
+        size_t write_file( const std::string &path, file_write_fn writer );
+
+        /** Moves the contents of the write-ahead log into the database file. */
+        void checkpoint();
+
+        /** Current schema version, stored as the database's user_version. */
+        static constexpr int schema_version = 3;
+        /** Blobs up to this size are read in one piece instead of through incremental blob I/O. */
+        static constexpr int inline_read_size = 16 * 1024;
+
+    private:
+        enum class statement_kind : int {
+            exists,
+            select,
+            upsert,
+            rowid,
+            num_kinds
+        };
+
+        sqlite3_stmt *get_statement( save_table table, statement_kind kind );
+        void bind_key( sqlite3_stmt *stmt, save_table table, const tripoint &key );
+        size_t store( save_table table, const tripoint &key, const std::string &compression,
+                      const void *data, size_t size );
+        size_t store( save_table table, const tripoint &key, const std::string &compression,
+                      const deflate_block_streambuf &buf );
+        size_t store_chunks( save_table table, const tripoint &key, const std::string &compression,
+                             const deflate_block_streambuf &buf );
+        void upsert( save_table table, const tripoint &key, const std::string &compression,
+                     const void *data, size_t size );
+        void migrate_files_table();
+        void migrate_files_rows();
+        void close();
+
+        sqlite3 *db;
+        save_blob_codec codec;
+        std::array < std::array < sqlite3_stmt *, static_cast<size_t>( statement_kind::num_kinds ) >,
+            static_cast<size_t>( save_table::num_tables ) > statements = {};
+};
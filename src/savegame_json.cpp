@@ -585,11 +585,15 @@ void Character::load( const JsonObject &data )
     }
 
     data.read( "mutations", my_mutations );
+    // Rebuilt from the loaded mutations, like my_traits is replaced above
+    cached_mutations.clear();
+    trait_bits.clear();
     for( auto it = my_mutations.begin(); it != my_mutations.end(); ) {
         const trait_id &mid = it->first;
         if( mid.is_valid() ) {
             on_mutation_gain( mid );
             cached_mutations.push_back( &mid.obj() );
+            trait_bits.set( mid.id() );
             ++it;
         } else {
             debugmsg( "character %s has invalid mutation %s, it will be ignored", name, mid.c_str() );
@@ -599,6 +603,12 @@ void Character::load( const JsonObject &data )
     recalculate_size();
 
     data.read( "my_bionics", *my_bionics );
+    bionic_bits.clear();
+    for( const bionic &bio : *my_bionics ) {
+        if( bio.id.is_valid() ) {
+            bionic_bits.set( bio.id.id() );
+        }
+    }
 
     for( auto &w : worn ) {
         w->on_takeoff( *this );
@@ -712,6 +722,9 @@ void Character::load( const JsonObject &data )
         const std::string t = pmap.get_string( "trap" );
         known_traps.insert( trap_map::value_type( p, t ) );
     }
+
+    encumbrance_stale_inputs.set();
+    trait_enchantment_stale_inputs.set();
 }
 
 /**
@@ -2448,6 +2461,7 @@ void item::deserialize( JsonIn &jsin )
     if( contents.empty() && is_non_resealable_container() ) {
         convert( type->container->unseals_into );
     }
+    invalidate_derived_properties();
 }
 
 void item::serialize( JsonOut &json ) const
@@ -2599,7 +2613,7 @@ void vehicle_part::deserialize( JsonIn &jsin )
         if( ammo_capacity() > 0 ) {
             ammo_set( legacy_fuel, data.get_int( "amount" ) );
         }
-        base->item_tags.insert( flag_id( "VEHICLE" ) );
+        base->set_flag( flag_id( "VEHICLE" ) );
     }
 
     if( data.has_int( "hp" ) && id.obj().durability > 0 ) {
@@ -3188,6 +3202,7 @@ void Creature::load( const JsonObject &jsin )
                 const effect &e = i.second;
 
                 ( *effects )[id][bp] = e;
+                effect_bits.set( id.id() );
                 on_effect_int_change( id, e.get_intensity(), bp );
             }
         }
@@ -3705,7 +3720,10 @@ void event_multiset::deserialize( JsonIn &jsin )
     jo.allow_omitted_members();
     std::vector<std::pair<cata::event::data_type, int>> copy;
     jo.read( "event_counts", copy );
-    counts_ = { copy.begin(), copy.end() };
+    *this = event_multiset( type_ );
+    for( const std::pair<cata::event::data_type, int> &entry : copy ) {
+        add( entry.first, entry.second );
+    }
 }
 
 void stats_tracker::serialize( JsonOut &jsout ) const
@@ -4081,6 +4099,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                     field_count++;
                 }
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                set_field_tile( point( i, j ) );
             }
         }
     } else if( member_name == "graffiti" ) {
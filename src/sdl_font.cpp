@@ -315,12 +315,10 @@ CachedTTFFont::CachedTTFFont(
     TTF_SetFontStyle( font.get(), TTF_STYLE_NORMAL );
 }
 
-SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
-        const std::string &ch,
-        const int color )
+SDL_Surface_Ptr CachedTTFFont::render_glyph( const std::string &ch, const SDL_Color &color ) const
 {
     const auto function = fontblending ? TTF_RenderUTF8_Blended : TTF_RenderUTF8_Solid;
-    SDL_Surface_Ptr sglyph( function( font.get(), ch.c_str(), windowsPalette[color] ) );
+    SDL_Surface_Ptr sglyph( function( font.get(), ch.c_str(), color ) );
     if( !sglyph ) {
         dbg( DL::Error ) << "Failed to create glyph for " << ch << ": " << TTF_GetError();
         return nullptr;
@@ -364,10 +362,26 @@ SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
                        "SDL_BlitSurface failed" ) ) {
         sglyph = std::move( surface );
     }
+    return sglyph;
+}
 
+SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
+        const std::string &ch,
+        const int color )
+{
+    const SDL_Surface_Ptr sglyph = render_glyph( ch, windowsPalette[color] );
+    if( !sglyph ) {
+        return nullptr;
+    }
     return CreateTextureFromSurface( renderer, sglyph );
 }
 
+SDL_Surface_Ptr CachedTTFFont::render_glyph_mask( const std::string &ch )
+{
+    static const SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+    return render_glyph( ch, white );
+}
+
 bool CachedTTFFont::isGlyphProvided( const std::string &ch ) const
 {
     return TTF_GlyphIsProvided( font.get(), UTF8_getch( ch ) );
@@ -624,10 +638,7 @@ bool FontFallbackList::isGlyphProvided( const std::string & ) const
     return true;
 }
 
-void FontFallbackList::OutputChar( const SDL_Renderer_Ptr &renderer,
-                                   const GeometryRenderer_Ptr &geometry,
-                                   const std::string &ch, point p,
-                                   unsigned char color, const float opacity )
+Font &FontFallbackList::font_for( const std::string &ch )
 {
     auto cached = glyph_font.find( ch );
     if( cached == glyph_font.end() ) {
@@ -637,7 +648,20 @@ void FontFallbackList::OutputChar( const SDL_Renderer_Ptr &renderer,
             }
         }
     }
-    ( *cached->second )->OutputChar( renderer, geometry, ch, p, color, opacity );
+    return **cached->second;
+}
+
+void FontFallbackList::OutputChar( const SDL_Renderer_Ptr &renderer,
+                                   const GeometryRenderer_Ptr &geometry,
+                                   const std::string &ch, point p,
+                                   unsigned char color, const float opacity )
+{
+    font_for( ch ).OutputChar( renderer, geometry, ch, p, color, opacity );
+}
+
+SDL_Surface_Ptr FontFallbackList::render_glyph_mask( const std::string &ch )
+{
+    return font_for( ch ).render_glyph_mask( ch );
 }
 
 #endif // TILES
@@ -50,6 +50,13 @@ class Font
                                        const GeometryRenderer_Ptr &geometry,
                                        unsigned char line_id, point p, unsigned char color ) const;
 
+        /// Render @p ch in white on a transparent cell sized surface, for tinting
+        /// through vertex or texture color modulation.
+        /// @return `nullptr` if the font can't provide such a mask.
+        virtual SDL_Surface_Ptr render_glyph_mask( const std::string & ) {
+            return nullptr;
+        }
+
         /// Try to load a font by typeface (Bitmap or Truetype).
         static std::unique_ptr<Font> load_font(
             SDL_Renderer_Ptr &renderer, SDL_PixelFormat_Ptr &format,
@@ -82,7 +89,9 @@ class CachedTTFFont : public Font
                          const std::string &ch,
                          point p,
                          unsigned char color, float opacity = 1.0f ) override;
+        SDL_Surface_Ptr render_glyph_mask( const std::string &ch ) override;
     protected:
+        SDL_Surface_Ptr render_glyph( const std::string &ch, const SDL_Color &color ) const;
         SDL_Texture_Ptr create_glyph( const SDL_Renderer_Ptr &renderer, const std::string &ch, int color );
 
         TTF_Font_Ptr font;
@@ -162,7 +171,11 @@ class FontFallbackList : public Font
                          const std::string &ch,
                          point p,
                          unsigned char color, float opacity = 1.0f ) override;
+        SDL_Surface_Ptr render_glyph_mask( const std::string &ch ) override;
     protected:
+        /// Font which renders @p ch, the last one if no font provides it.
+        Font &font_for( const std::string &ch );
+
         std::vector<std::unique_ptr<Font>> fonts;
         std::map<std::string, std::vector<std::unique_ptr<Font>>::iterator> glyph_font;
 };
@@ -5,21 +5,21 @@
 #define dbg(x) DebugLogFL((x),DC::SDL)
 
 void GeometryRenderer::horizontal_line( const SDL_Renderer_Ptr &renderer, point pos, int x2,
-                                        int thickness, const SDL_Color &color ) const
+                                        int thickness, const SDL_Color &color )
 {
     SDL_Rect rect { pos.x, pos.y, x2 - pos.x, thickness };
     this->rect( renderer, rect, color );
 }
 
 void GeometryRenderer::vertical_line( const SDL_Renderer_Ptr &renderer, point pos, int y2,
-                                      int thickness, const SDL_Color &color ) const
+                                      int thickness, const SDL_Color &color )
 {
     SDL_Rect rect { pos.x, pos.y, thickness, y2 - pos.y };
     this->rect( renderer, rect, color );
 }
 
 void GeometryRenderer::rect( const SDL_Renderer_Ptr &renderer, point pos, int width,
-                             int height, const SDL_Color &color ) const
+                             int height, const SDL_Color &color )
 {
     SDL_Rect rect { pos.x, pos.y, width, height };
     this->rect( renderer, rect, color );
@@ -27,7 +27,7 @@ void GeometryRenderer::rect( const SDL_Renderer_Ptr &renderer, point pos, int wi
 
 
 void DefaultGeometryRenderer::rect( const SDL_Renderer_Ptr &renderer, const SDL_Rect &rect,
-                                    const SDL_Color &color ) const
+                                    const SDL_Color &color )
 {
     SetRenderDrawColor( renderer, color.r, color.g, color.b, color.a );
     RenderFillRect( renderer, &rect );
@@ -66,7 +66,7 @@ ColorModulatedGeometryRenderer::ColorModulatedGeometryRenderer( const SDL_Render
 }
 
 void ColorModulatedGeometryRenderer::rect( const SDL_Renderer_Ptr &renderer, const SDL_Rect &rect,
-        const SDL_Color &color ) const
+        const SDL_Color &color )
 {
     if( tex ) {
         SetTextureColorMod( tex, color.r, color.g, color.b );
@@ -14,19 +14,19 @@ class GeometryRenderer
 
         /// Renders a SDL rectangle with given color.
         virtual void rect( const SDL_Renderer_Ptr &renderer, const SDL_Rect &rect,
-                           const SDL_Color &color ) const = 0;
+                           const SDL_Color &color ) = 0;
 
         /// Renders a point+width+height defined rectangle with given color.
         void rect( const SDL_Renderer_Ptr &renderer, point pos, int width, int height,
-                   const SDL_Color &color ) const;
+                   const SDL_Color &color );
 
         /// Renders a straight horizontal line with given thickness and color.
         void horizontal_line( const SDL_Renderer_Ptr &renderer, point pos, int x2, int thickness,
-                              const SDL_Color &color ) const;
+                              const SDL_Color &color );
 
         /// Renders a straight vertical line with given thickness and color.
         void vertical_line( const SDL_Renderer_Ptr &renderer, point pos, int y2, int thickness,
-                            const SDL_Color &color ) const;
+                            const SDL_Color &color );
 };
 using GeometryRenderer_Ptr = std::unique_ptr<GeometryRenderer>;
 
@@ -35,7 +35,7 @@ class DefaultGeometryRenderer : public GeometryRenderer
 {
     public:
         void rect( const SDL_Renderer_Ptr &renderer, const SDL_Rect &rect,
-                   const SDL_Color &color ) const override;
+                   const SDL_Color &color ) override;
 };
 
 /// Implementation of a GeometryRenderer using color modulated textures if
@@ -46,7 +46,7 @@ class ColorModulatedGeometryRenderer: public DefaultGeometryRenderer
         ColorModulatedGeometryRenderer( const SDL_Renderer_Ptr &renderer );
 
         void rect( const SDL_Renderer_Ptr &renderer, const SDL_Rect &rect,
-                   const SDL_Color &color ) const override;
+                   const SDL_Color &color ) override;
     private:
         SDL_Texture_Ptr tex;
 };
@@ -0,0 +1,186 @@
+#if defined(TILES)
+#include "sdl_text_batch.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "debug.h"
+#include "sdl_font.h"
+
+#define dbg(x) DebugLogFL((x),DC::SDL)
+
+// Atlas textures are square, this is their size unless the renderer allows less
+static constexpr int max_atlas_size = 2048;
+
+TextBatchRenderer::atlas TextBatchRenderer::create_atlas( const SDL_Renderer_Ptr &renderer,
+        Font &font )
+{
+    atlas result;
+    // Leave room for double width glyphs
+    result.slot_size = point( font.width * 2, font.height );
+    result.size = max_atlas_size;
+    SDL_RendererInfo info;
+    if( SDL_GetRendererInfo( renderer.get(), &info ) == 0 && info.max_texture_width > 0 &&
+        info.max_texture_height > 0 ) {
+        result.size = std::min( { result.size, info.max_texture_width, info.max_texture_height } );
+    }
+    // Bitmap fonts can't provide glyph masks, there is nothing to batch then
+    if( result.slot_size.x <= 0 || result.slot_size.y <= 0 || !font.render_glyph_mask( "#" ) ) {
+        return result;
+    }
+    result.columns = result.size / result.slot_size.x;
+    result.capacity = result.columns * ( result.size / result.slot_size.y );
+    if( result.capacity < 2 ) {
+        return result;
+    }
+
+    result.texture = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                    result.size, result.size );
+    if( !result.texture ) {
+        return result;
+    }
+    SetTextureBlendMode( result.texture, SDL_BLENDMODE_BLEND );
+
+    const std::vector<Uint32> white( static_cast<size_t>( result.slot_size.x ) * result.slot_size.y,
+                                     0xFFFFFFFF );
+    const SDL_Rect white_slot{ 0, 0, result.slot_size.x, result.slot_size.y };
+    if( printErrorIf( SDL_UpdateTexture( result.texture.get(), &white_slot, white.data(),
+                                         result.slot_size.x * sizeof( Uint32 ) ) != 0, "SDL_UpdateTexture failed" ) ) {
+        result.texture.reset();
+    }
+    dbg( DL::Info ) << "Created " << result.size << "x" << result.size << " glyph atlas with room for "
+                    << result.capacity - 1 << " glyphs";
+    return result;
+}
+
+TextBatchRenderer::glyph_slot TextBatchRenderer::add_glyph( atlas &target, const std::string &ch )
+{
+    glyph_slot result;
+    if( target.next_slot >= target.capacity ) {
+        return result;
+    }
+    const SDL_Surface_Ptr mask = current_font->render_glyph_mask( ch );
+    if( !mask ) {
+        return result;
+    }
+    const SDL_Surface_Ptr converted( SDL_ConvertSurfaceFormat( mask.get(), SDL_PIXELFORMAT_ARGB8888,
+                                     0 ) );
+    if( !converted || converted->w > target.slot_size.x || converted->h > target.slot_size.y ) {
+        return result;
+    }
+    const int index = target.next_slot;
+    const SDL_Rect dst{ index % target.columns * target.slot_size.x,
+                        index / target.columns * target.slot_size.y,
+                        converted->w, converted->h };
+    if( printErrorIf( SDL_UpdateTexture( target.texture.get(), &dst, converted->pixels,
+                                         converted->pitch ) != 0, "SDL_UpdateTexture failed" ) ) {
+        return result;
+    }
+    target.next_slot++;
+    result.index = index;
+    result.width = converted->w;
+    return result;
+}
+
+bool TextBatchRenderer::begin( const SDL_Renderer_Ptr &renderer, Font &font )
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    vertices.clear();
+    indices.clear();
+    auto it = atlases.find( &font );
+    if( it == atlases.end() ) {
+        it = atlases.emplace( &font, create_atlas( renderer, font ) ).first;
+    }
+    current_font = &font;
+    current = &it->second;
+    return current->texture != nullptr;
+#else
+    static_cast<void>( renderer );
+    static_cast<void>( font );
+    return false;
+#endif
+}
+
+void TextBatchRenderer::quad( const SDL_Rect &dst, const SDL_Rect &src,
+                              const SDL_Color &color )
+{
+    const float scale = 1.0f / current->size;
+    const float x0 = dst.x;
+    const float y0 = dst.y;
+    const float x1 = dst.x + dst.w;
+    const float y1 = dst.y + dst.h;
+    const float u0 = src.x * scale;
+    const float v0 = src.y * scale;
+    const float u1 = ( src.x + src.w ) * scale;
+    const float v1 = ( src.y + src.h ) * scale;
+
+    const int first = vertices.size();
+    vertices.push_back( { x0, y0, color, u0, v0 } );
+    vertices.push_back( { x1, y0, color, u1, v0 } );
+    vertices.push_back( { x1, y1, color, u1, v1 } );
+    vertices.push_back( { x0, y1, color, u0, v1 } );
+    for( const int i : {
+             0, 1, 2, 0, 2, 3
+         } ) {
+        indices.push_back( first + i );
+    }
+}
+
+bool TextBatchRenderer::glyph( const SDL_Renderer_Ptr &, const std::string &ch, point p,
+                               const SDL_Color &color )
+{
+    auto it = current->glyphs.find( ch );
+    if( it == current->glyphs.end() ) {
+        it = current->glyphs.emplace( ch, add_glyph( *current, ch ) ).first;
+    }
+    const glyph_slot &slot = it->second;
+    if( slot.index < 0 ) {
+        return false;
+    }
+    const SDL_Rect src{ slot.index % current->columns * current->slot_size.x,
+                        slot.index / current->columns * current->slot_size.y,
+                        slot.width, current->slot_size.y };
+    quad( SDL_Rect{ p.x, p.y, slot.width, current->slot_size.y }, src, color );
+    return true;
+}
+
+void TextBatchRenderer::rect( const SDL_Renderer_Ptr &, const SDL_Rect &rect,
+                              const SDL_Color &color )
+{
+    // Sample the middle of the white slot so filtering never reaches a glyph
+    const SDL_Rect white_texel{ current->slot_size.x / 2, current->slot_size.y / 2, 0, 0 };
+    quad( rect, white_texel, color );
+}
+
+void TextBatchRenderer::flush( const SDL_Renderer_Ptr &renderer )
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if( indices.empty() ) {
+        return;
+    }
+    const vertex &first = vertices.front();
+    printErrorIf( SDL_RenderGeometryRaw( renderer.get(), current->texture.get(),
+                                         &first.x, sizeof( vertex ),
+                                         &first.color, sizeof( vertex ),
+                                         &first.u, sizeof( vertex ),
+                                         static_cast<int>( vertices.size() ), indices.data(),
+                                         static_cast<int>( indices.size() ), sizeof( int ) ) != 0,
+                  "SDL_RenderGeometryRaw failed" );
+    flush_count++;
+    vertices.clear();
+    indices.clear();
+#else
+    static_cast<void>( renderer );
+#endif
+}
+
+void TextBatchRenderer::clear()
+{
+    vertices.clear();
+    indices.clear();
+    current = nullptr;
+    current_font = nullptr;
+    atlases.clear();
+}
+
+#endif // TILES
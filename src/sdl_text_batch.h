@@ -0,0 +1,90 @@
+#pragma once
+
+#if defined(TILES)
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "point.h"
+#include "sdl_geometry.h"
+#include "sdl_wrappers.h"
+
+class Font;
+
+/// Implementation of a GeometryRenderer that collects the cells of a window
+/// into a single vertex buffer, rendered with one SDL_RenderGeometry call.
+///
+/// Glyphs are rasterized once per font, in white, into an atlas texture and
+/// tinted through vertex colors, so one atlas serves every curses color.
+/// Rectangles sample a white area of the same atlas, which lets backgrounds,
+/// box lines and glyphs share the draw call.
+/// Needs SDL 2.0.18 or newer, @ref begin always fails on older versions.
+class TextBatchRenderer : public GeometryRenderer
+{
+    public:
+        /// Starts a batch of cells drawn with @p font.
+        /// @return `false` if there is no atlas for the font, draw directly then.
+        bool begin( const SDL_Renderer_Ptr &renderer, Font &font );
+
+        /// Queues glyph @p ch at @p p.
+        /// @return `false` if the glyph can't be put in the atlas, draw it directly then.
+        bool glyph( const SDL_Renderer_Ptr &renderer, const std::string &ch, point p,
+                    const SDL_Color &color );
+
+        using GeometryRenderer::rect;
+
+        /// Queues a rectangle, drawn blended with the rest of the batch.
+        void rect( const SDL_Renderer_Ptr &renderer, const SDL_Rect &rect,
+                   const SDL_Color &color ) override;
+
+        /// Renders everything queued since @ref begin.
+        void flush( const SDL_Renderer_Ptr &renderer );
+
+        /// Drops every atlas. Call this whenever the fonts are destroyed or
+        /// recreated, atlases are keyed by the address of their font.
+        void clear();
+
+        /// Number of render calls issued by @ref flush so far, for benchmarks.
+        int get_flush_count() const {
+            return flush_count;
+        }
+
+    private:
+        struct glyph_slot {
+            // -1 if the glyph could not be added
+            int index = -1;
+            int width = 0;
+        };
+        struct atlas {
+            SDL_Texture_Ptr texture;
+            int size = 0;
+            point slot_size;
+            int columns = 0;
+            int capacity = 0;
+            // Slot 0 is solid white, used for rectangles
+            int next_slot = 1;
+            std::unordered_map<std::string, glyph_slot> glyphs;
+        };
+        // Same layout as SDL_Vertex, which older SDL versions lack
+        struct vertex {
+            float x;
+            float y;
+            SDL_Color color;
+            float u;
+            float v;
+        };
+
+        static atlas create_atlas( const SDL_Renderer_Ptr &renderer, Font &font );
+        glyph_slot add_glyph( atlas &target, const std::string &ch );
+        void quad( const SDL_Rect &dst, const SDL_Rect &src, const SDL_Color &color );
+
+        std::unordered_map<const Font *, atlas> atlases;
+        Font *current_font = nullptr;
+        atlas *current = nullptr;
+        std::vector<vertex> vertices;
+        std::vector<int> indices;
+        int flush_count = 0;
+};
+
+#endif // TILES
@@ -68,6 +68,7 @@
 #include "sdl_geometry.h"
 #include "sdl_utils.h"
 #include "sdl_font.h"
+#include "sdl_text_batch.h"
 #include "sdlsound.h"
 #include "string_formatter.h"
 #include "uistate.h"
@@ -112,6 +113,8 @@ static bool needupdate = false;
 static bool need_invalidate_framebuffers = false;
 static const std::string empty_string;
 
+static const option_handle<bool> option_USE_DRAW_ASCII_LINES_ROUTINE( "USE_DRAW_ASCII_LINES_ROUTINE" );
+
 palette_array windowsPalette;
 
 static Font_Ptr font;
@@ -123,6 +126,9 @@ static SDL_Renderer_Ptr renderer;
 static SDL_PixelFormat_Ptr format;
 static SDL_Texture_Ptr display_buffer;
 static GeometryRenderer_Ptr geometry;
+// Owns text_batch, if batched text rendering is enabled
+static GeometryRenderer_Ptr text_batch_geometry;
+static TextBatchRenderer *text_batch = nullptr;
 #if defined(__ANDROID__)
 static SDL_Texture_Ptr touch_joystick;
 #endif
@@ -436,6 +442,12 @@ static void WinCreate()
     } else {
         geometry = std::make_unique<DefaultGeometryRenderer>();
     }
+
+    if( get_option<bool>( "BATCHED_TEXT_RENDERING" ) ) {
+        auto batch = std::make_unique<TextBatchRenderer>();
+        text_batch = batch.get();
+        text_batch_geometry = std::move( batch );
+    }
 }
 
 static void WinDestroy()
@@ -453,6 +465,8 @@ static void WinDestroy()
         joystick = nullptr;
     }
     geometry.reset();
+    text_batch = nullptr;
+    text_batch_geometry.reset();
     format.reset();
     display_buffer.reset();
     renderer.reset();
@@ -842,6 +856,13 @@ static point draw_string( Font &font,
 }
 
 void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bool blink )
+{
+    draw_om( dest, point( OVERMAP_WINDOW_TERM_WIDTH * font->width,
+                          OVERMAP_WINDOW_TERM_HEIGHT * font->height ), center_abs_omt, blink );
+}
+
+void cata_tiles::draw_om( point dest, point size, const tripoint_abs_omt &center_abs_omt,
+                          bool blink )
 {
     if( !g ) {
         return;
@@ -855,8 +876,8 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
     }
 #endif
 
-    int width = OVERMAP_WINDOW_TERM_WIDTH * font->width;
-    int height = OVERMAP_WINDOW_TERM_HEIGHT * font->height;
+    int width = size.x;
+    int height = size.y;
 
     {
         //set clipping to prevent drawing over stuff we shouldn't
@@ -902,6 +923,51 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
         return tripoint( omp.raw().xy(), 0 );
     };
 
+    // Terrain only changes with the overmaps, so it is drawn from pre-rendered blocks
+    // and only the dynamic parts are drawn tile by tile on top of them.
+    bool terrain_cached = cache_overmap_chunks && !tile_iso && !viewing_weather &&
+                          SDL_RenderTargetSupported( renderer.get() );
+    if( terrain_cached ) {
+        const point tile_size( tile_width, tile_height );
+        if( om_chunks_tile_size != tile_size ) {
+            om_chunks.clear();
+            om_chunks_tile_size = tile_size;
+        }
+        om_frame++;
+        const point chunk_min = divide_xy_round_to_minus_infinity( corner_NW.raw().xy(), om_chunk_size );
+        const point chunk_max = divide_xy_round_to_minus_infinity( corner_SE.raw().xy(), om_chunk_size );
+        std::vector<std::pair<tripoint_abs_omt, const overmap_chunk *>> visible_chunks;
+        for( int y = chunk_min.y; y <= chunk_max.y && terrain_cached; y++ ) {
+            for( int x = chunk_min.x; x <= chunk_max.x; x++ ) {
+                const tripoint_abs_omt origin( x * om_chunk_size, y * om_chunk_size, center_abs_omt.z() );
+                overmap_chunk &chunk = om_chunks[origin];
+                chunk.last_used = om_frame;
+                terrain_cached = update_om_chunk( chunk, origin, has_debug_vision );
+                if( !terrain_cached ) {
+                    // The renderer can't make textures this large, don't retry every frame
+                    cache_overmap_chunks = false;
+                    om_chunks.clear();
+                    break;
+                }
+                visible_chunks.emplace_back( origin, &chunk );
+            }
+        }
+        if( terrain_cached ) {
+            for( const auto &[origin, chunk] : visible_chunks ) {
+                const point pos = player_to_screen( origin.raw().xy() );
+                const SDL_Rect chunk_rect{ pos.x, pos.y, om_chunk_size * tile_width, om_chunk_size * tile_height };
+                RenderCopy( renderer, chunk->texture, nullptr, &chunk_rect );
+            }
+        }
+        // Keep the chunks around the view for panning, drop the rest
+        constexpr size_t max_om_chunks = 16;
+        if( om_chunks.size() > max_om_chunks ) {
+            std::erase_if( om_chunks, [this]( const auto & entry ) {
+                return entry.second.last_used != om_frame;
+            } );
+        }
+    }
+
     for( int row = min_row; row < max_row; row++ ) {
         for( int col = min_col; col < max_col; col++ ) {
             const tripoint_abs_omt omp = corner_NW + point( col, row );
@@ -920,39 +986,15 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
                     id = overmap_ui::get_weather_at_point( omp_sky.xy() ).c_str();
                 }
             }
-            if( id.empty() ) {
-                if( see ) {
-                    id = get_omt_id_rotation_and_subtile( omp, rotation, subtile );
-                } else {
-                    id = "unknown_terrain";
-                }
-            }
-
-            if( overmap_transparency ) {
-                int z_offset = 0;
-                while( id == "open_air" ) {
-                    z_offset++;
-                    const tripoint_abs_omt lower_omp = omp + tripoint( 0, 0, -z_offset );
-                    const bool lower_see = has_debug_vision || overmap_buffer.seen( lower_omp );
-                    if( !lower_see ) {
-                        //actually really strange situation when above overmap is explored, but below one isn't
-                        //so let's account for this just in case, drawing highest seen tile
-                        z_offset--;
-                        break;
+            if( !terrain_cached ) {
+                if( id.empty() ) {
+                    if( see ) {
+                        id = get_omt_id_rotation_and_subtile( omp, rotation, subtile );
+                    } else {
+                        id = "unknown_terrain";
                     }
-                    id = get_omt_id_rotation_and_subtile( lower_omp, rotation, subtile );
                 }
-                draw_om_tile_recursively( omp + tripoint( 0, 0, -z_offset ), id, rotation, subtile, z_offset );
-            } else {
-                const lit_level ll = overmap_buffer.is_explored( omp ) ? lit_level::LOW : lit_level::LIT;
-
-                auto [bgCol, fgCol] = get_overmap_color( overmap_buffer, omp );
-
-                // light level is now used for choosing between grayscale filter and normal lit tiles.
-                const tile_search_params tile { id, C_OVERMAP_TERRAIN, "overmap_terrain", subtile, rotation };
-                draw_from_id_string( tile, omp.raw(), bgCol, fgCol,
-                                     ll, false, 0, false,
-                                     height_3d );
+                draw_om_terrain( omp, id, rotation, subtile, has_debug_vision, height_3d );
             }
 
             if( blink && uistate.overmap_highlighted_omts.contains( omp ) ) {
@@ -980,6 +1022,9 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
                 }
                 const int horde_size = overmap_buffer.get_horde_size( omp );
                 if( showhordes && los && horde_size >= HORDE_VISIBILITY_SIZE ) {
+                    if( id.empty() ) {
+                        id = get_omt_id_rotation_and_subtile( omp, rotation, subtile );
+                    }
                     // a little bit of hardcoded fallbacks for hordes
                     std::string horde_id;
                     if( find_tile_with_season( id ) ) {
@@ -1346,6 +1391,12 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, point offs
     // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
     static const std::string space_string = " ";
 
+    // Collect the whole window into one draw call if possible.
+    // Glyphs missing from the atlas are drawn on top after the batch.
+    const bool batched = text_batch && text_batch->begin( renderer, *font );
+    const GeometryRenderer_Ptr &cell_geometry = batched ? text_batch_geometry : geometry;
+    std::vector<std::pair<point, const cursecell *>> unbatched;
+
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
         if( !win->line[j].touched ) {
@@ -1391,8 +1442,8 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, point offs
 
             // Spaces are used a lot, so this does help noticeably
             if( cell.ch == space_string ) {
-                geometry->rect( renderer, point( drawx, drawy ), font->width, font->height,
-                                color_as_sdl( cell.BG ) );
+                cell_geometry->rect( renderer, point( drawx, drawy ), font->width, font->height,
+                                     color_as_sdl( cell.BG ) );
                 continue;
             }
             const int codepoint = UTF8_getch( cell.ch );
@@ -1403,7 +1454,7 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, point offs
                 // utf8_width() may return a negative width
                 continue;
             }
-            bool use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
+            bool use_draw_ascii_lines_routine = option_USE_DRAW_ASCII_LINES_ROUTINE.get();
             unsigned char uc = static_cast<unsigned char>( cell.ch[0] );
             switch( codepoint ) {
                 case LINE_XOXO_UNICODE:
@@ -1458,15 +1509,23 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, point offs
                     use_draw_ascii_lines_routine = false;
                     break;
             }
-            geometry->rect( renderer, point( drawx, drawy ), font->width * cw, font->height,
-                            color_as_sdl( BG ) );
+            cell_geometry->rect( renderer, point( drawx, drawy ), font->width * cw, font->height,
+                                 color_as_sdl( BG ) );
             if( use_draw_ascii_lines_routine ) {
-                font->draw_ascii_lines( renderer, geometry, uc, point( drawx, drawy ), FG );
-            } else {
+                font->draw_ascii_lines( renderer, cell_geometry, uc, point( drawx, drawy ), FG );
+            } else if( !batched ) {
                 font->OutputChar( renderer, geometry, cell.ch, point( drawx, drawy ), FG );
+            } else if( !text_batch->glyph( renderer, cell.ch, point( drawx, drawy ), color_as_sdl( FG ) ) ) {
+                unbatched.emplace_back( point( drawx, drawy ), &cell );
             }
         }
     }
+    if( batched ) {
+        text_batch->flush( renderer );
+        for( const std::pair<point, const cursecell *> &p : unbatched ) {
+            font->OutputChar( renderer, geometry, p.second->ch, p.first, p.second->FG );
+        }
+    }
     win->draw = false; //We drew the window, mark it as so
     //Keeping track of last drawn window and tilemode zoom level
     ::winBuffer = w.weak_ptr();
@@ -3454,6 +3513,12 @@ static void CheckMessages()
     // resizing already reinitializes the render target
     if( !resized && render_target_reset ) {
         throwErrorIf( !SetupRenderTarget(), "SetupRenderTarget failed" );
+        if( tilecontext ) {
+            tilecontext->invalidate_view_cache();
+        }
+        if( overmap_tilecontext ) {
+            overmap_tilecontext->invalidate_view_cache();
+        }
         reinitialize_framebuffer( true );
         needupdate = true;
         restore_on_out_of_scope<input_event> prev_last_input( last_input );
@@ -3709,6 +3774,10 @@ void catacurses::init_interface()
     overmap_font = std::make_unique<FontFallbackList>( renderer, format, fl.overmap_fontwidth,
                    fl.overmap_fontheight,
                    windowsPalette, fl.overmap_typeface, fl.overmap_fontsize, fl.fontblending );
+    // The new fonts may reuse the addresses of old ones, whose atlases are stale
+    if( text_batch ) {
+        text_batch->clear();
+    }
     stdscr = newwin( get_terminal_height(), get_terminal_width(), point_zero );
     //newwin calls `new WINDOW`, and that will throw, but not return nullptr.
 
@@ -3722,6 +3791,10 @@ void catacurses::init_interface()
 // This is supposed to be called from init.cpp, and only from there.
 void load_tileset()
 {
+    // Rebuild the glyph atlases on the next draw, in case the fonts were reloaded
+    if( text_batch ) {
+        text_batch->clear();
+    }
     if( !tilecontext || !use_tiles ) {
         return;
     }
@@ -3762,6 +3835,9 @@ void catacurses::endwin()
 {
     tilecontext.reset();
     overmap_tilecontext.reset();
+    if( text_batch ) {
+        text_batch->clear();
+    }
     font.reset();
     map_font.reset();
     overmap_font.reset();
@@ -27,21 +27,73 @@ void event_multiset::set_type( event_type type )
     type_ = type;
 }
 
-int event_multiset::count() const
+event_multiset::event_multiset( const event_multiset &other ) :
+    type_( other.type_ ),
+    counts_( other.counts_ ),
+    count_( other.count_ ),
+    summaries_( other.summaries_ )
 {
-    int total = 0;
-    for( const auto &pair : counts_ ) {
-        total += pair.second;
+}
+
+event_multiset &event_multiset::operator=( const event_multiset &other )
+{
+    if( this != &other ) {
+        type_ = other.type_;
+        counts_ = other.counts_;
+        count_ = other.count_;
+        summaries_ = other.summaries_;
+        indices_.clear();
     }
-    return total;
+    return *this;
+}
+
+const event_multiset::field_index &event_multiset::index_for( const std::string &field ) const
+{
+    auto [it, inserted] = indices_.try_emplace( field );
+    if( inserted ) {
+        for( const counts_type::value_type &entry : counts_ ) {
+            auto value = entry.first.find( field );
+            if( value != entry.first.end() ) {
+                it->second[value->second].push_back( &entry );
+            }
+        }
+    }
+    return it->second;
+}
+
+const std::vector<const event_multiset::counts_type::value_type *> *event_multiset::candidates(
+    const cata::event::data_type &criteria ) const
+{
+    static const std::vector<const counts_type::value_type *> none;
+    const std::vector<const counts_type::value_type *> *best = nullptr;
+    for( const auto &criterion : criteria ) {
+        const field_index &index = index_for( criterion.first );
+        auto it = index.find( criterion.second );
+        if( it == index.end() ) {
+            return &none;
+        }
+        if( best == nullptr || it->second.size() < best->size() ) {
+            best = &it->second;
+        }
+    }
+    return best;
+}
+
+int event_multiset::count() const
+{
+    return count_;
 }
 
 int event_multiset::count( const cata::event::data_type &criteria ) const
 {
+    const auto *entries = candidates( criteria );
+    if( entries == nullptr ) {
+        return count();
+    }
     int total = 0;
-    for( const auto &pair : counts_ ) {
-        if( event_data_matches( pair.first, criteria ) ) {
-            total += pair.second;
+    for( const counts_type::value_type *entry : *entries ) {
+        if( event_data_matches( entry->first, criteria ) ) {
+            total += entry->second;
         }
     }
     return total;
@@ -49,19 +101,24 @@ int event_multiset::count( const cata::event::data_type &criteria ) const
 
 int event_multiset::total( const std::string &field ) const
 {
-    return total( field, {} );
+    auto it = summaries_.find( field );
+    return it == summaries_.end() ? 0 : it->second.total;
 }
 
 int event_multiset::total( const std::string &field, const cata::event::data_type &criteria ) const
 {
+    const auto *entries = candidates( criteria );
+    if( entries == nullptr ) {
+        return total( field );
+    }
     int total = 0;
-    for( const auto &pair : counts_ ) {
-        auto it = pair.first.find( field );
-        if( it == pair.first.end() ) {
+    for( const counts_type::value_type *entry : *entries ) {
+        auto it = entry->first.find( field );
+        if( it == entry->first.end() ) {
             continue;
         }
-        if( event_data_matches( pair.first, criteria ) ) {
-            total += pair.second * it->second.get<cata_variant_type::int_>();
+        if( event_data_matches( entry->first, criteria ) ) {
+            total += entry->second * it->second.get<cata_variant_type::int_>();
         }
     }
     return total;
@@ -69,44 +126,47 @@ int event_multiset::total( const std::string &field, const cata::event::data_typ
 
 int event_multiset::minimum( const std::string &field ) const
 {
-    int minimum = 0;
-    for( const auto &pair : counts_ ) {
-        auto it = pair.first.find( field );
-        if( it == pair.first.end() ) {
-            continue;
-        }
-        const int potential = it->second.get<cata_variant_type::int_>();
-        if( potential < minimum ) {
-            minimum = potential;
-        }
-    }
-    return minimum;
+    auto it = summaries_.find( field );
+    return it == summaries_.end() ? 0 : it->second.minimum;
 }
 
 int event_multiset::maximum( const std::string &field ) const
 {
-    int maximum = 0;
-    for( const auto &pair : counts_ ) {
-        auto it = pair.first.find( field );
-        if( it == pair.first.end() ) {
-            continue;
-        }
-        const int potential = it->second.get<cata_variant_type::int_>();
-        if( potential > maximum ) {
-            maximum = potential;
-        }
-    }
-    return maximum;
+    auto it = summaries_.find( field );
+    return it == summaries_.end() ? 0 : it->second.maximum;
 }
 
 void event_multiset::add( const cata::event &e )
 {
-    counts_[e.data()]++;
+    add( e.data(), 1 );
 }
 
 void event_multiset::add( const counts_type::value_type &e )
 {
-    counts_[e.first] += e.second;
+    add( e.first, e.second );
+}
+
+void event_multiset::add( const cata::event::data_type &data, const int count )
+{
+    auto [entry, inserted] = counts_.try_emplace( data, 0 );
+    entry->second += count;
+    count_ += count;
+
+    for( const auto &field : data ) {
+        if( field.second.type() == cata_variant_type::int_ ) {
+            const int value = field.second.get<cata_variant_type::int_>();
+            field_summary &summary = summaries_[field.first];
+            summary.total += count * value;
+            summary.minimum = std::min( summary.minimum, value );
+            summary.maximum = std::max( summary.maximum, value );
+        }
+        if( inserted ) {
+            auto index = indices_.find( field.first );
+            if( index != indices_.end() ) {
+                index->second[field.second].push_back( &*entry );
+            }
+        }
+    }
 }
 
 base_watcher::~base_watcher()
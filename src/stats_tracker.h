@@ -39,6 +39,11 @@ class event_multiset
         // type
         event_multiset() : type_( event_type::num_event_types ) {}
         event_multiset( event_type type ) : type_( type ) {}
+        // The field indices point into counts_, so copies rebuild them on demand
+        event_multiset( const event_multiset & );
+        event_multiset( event_multiset && ) noexcept = default;
+        event_multiset &operator=( const event_multiset & );
+        event_multiset &operator=( event_multiset && ) noexcept = default;
 
         void set_type( event_type );
 
@@ -60,6 +65,9 @@ class event_multiset
         // some values that must be matched in the events of that type.  You can
         // provide just a subset of the relevant keys from the event_type in
         // your criteria.
+        // Queries without criteria read running aggregates kept up to date by
+        // add.  Queries with criteria only scan the entries sharing the
+        // rarest of the criteria's field values.
         int count() const;
         int count( const cata::event::data_type &criteria ) const;
         int total( const std::string &field ) const;
@@ -73,8 +81,28 @@ class event_multiset
         void serialize( JsonOut & ) const;
         void deserialize( JsonIn & );
     private:
+        // Running aggregates of an integer-valued field over every entry
+        struct field_summary {
+            int total = 0;
+            int minimum = 0;
+            int maximum = 0;
+        };
+        // Entries of counts_ holding each value of one field
+        using field_index =
+            std::unordered_map<cata_variant, std::vector<const counts_type::value_type *>>;
+
+        void add( const cata::event::data_type &, int count );
+        const field_index &index_for( const std::string &field ) const;
+        // Entries that may match criteria, nullptr meaning all of them
+        const std::vector<const counts_type::value_type *> *candidates(
+            const cata::event::data_type &criteria ) const;
+
         event_type type_;
         counts_type counts_;
+        int count_ = 0;
+        std::unordered_map<std::string, field_summary> summaries_;
+        // Built on the first query filtering by the field, then maintained by add
+        mutable std::unordered_map<std::string, field_index> indices_;
 };
 
 class base_watcher
@@ -38,6 +38,7 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.is_uniform, second.is_uniform );
     std::swap( first.active_items, second.active_items );
     std::swap( first.field_count, second.field_count );
+    std::swap( first.field_tiles, second.field_tiles );
     std::swap( first.last_touched, second.last_touched );
     std::swap( first.spawns, second.spawns );
     std::swap( first.vehicles, second.vehicles );
@@ -48,6 +49,8 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.legacy_computer, second.legacy_computer );
     std::swap( first.temperature, second.temperature );
     std::swap( first.cosmetics, second.cosmetics );
+    first.mark_dirty();
+    second.mark_dirty();
 
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
@@ -239,6 +242,7 @@ submap::~submap() = default;
 void submap::update_lum_rem( point p, const item &i )
 {
     is_uniform = false;
+    mark_dirty();
     if( !i.is_emissive() ) {
         return;
     } else if( lum[p.x][p.y] && lum[p.x][p.y] < 255 ) {
@@ -262,6 +266,7 @@ void submap::update_lum_rem( point p, const item &i )
 
 void submap::insert_cosmetic( point p, const std::string &type, const std::string &str )
 {
+    mark_dirty();
     cosmetic_t ins;
 
     ins.pos = p;
@@ -315,6 +320,7 @@ const std::string &submap::get_graffiti( point p ) const
 void submap::set_graffiti( point p, const std::string &new_graffiti )
 {
     is_uniform = false;
+    mark_dirty();
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
@@ -327,6 +333,7 @@ void submap::set_graffiti( point p, const std::string &new_graffiti )
 void submap::delete_graffiti( point p )
 {
     is_uniform = false;
+    mark_dirty();
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -355,6 +362,7 @@ std::string submap::get_signage( point p ) const
 void submap::set_signage( point p, const std::string &s )
 {
     is_uniform = false;
+    mark_dirty();
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
@@ -366,6 +374,7 @@ void submap::set_signage( point p, const std::string &s )
 void submap::delete_signage( point p )
 {
     is_uniform = false;
+    mark_dirty();
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -411,6 +420,8 @@ computer *submap::get_computer( point p )
     // need to update to std::map first so modifications to the returned object
     // only affects the exact point p
     update_legacy_computer();
+    // The caller may modify the returned computer.
+    mark_dirty();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         return &it->second;
@@ -420,6 +431,7 @@ computer *submap::get_computer( point p )
 
 void submap::set_computer( point p, const computer &c )
 {
+    mark_dirty();
     update_legacy_computer();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
@@ -431,10 +443,19 @@ void submap::set_computer( point p, const computer &c )
 
 void submap::delete_computer( point p )
 {
+    mark_dirty();
     update_legacy_computer();
     computers.erase( p );
 }
 
+bool submap::is_dirty() const
+{
+    // Vehicles, constructions in progress, active furniture, active items and fields change
+    // in place while the submap is loaded, without going through the setters.
+    return generation != saved_generation || !vehicles.empty() || !partial_constructions.empty() ||
+           !active_furniture.empty() || !active_items.empty() || field_count > 0;
+}
+
 bool submap::contains_vehicle( vehicle *veh )
 {
     const auto match = std::ranges::find_if(
@@ -452,6 +473,7 @@ void submap::rotate( int turns )
     if( turns == 0 ) {
         return;
     }
+    mark_dirty();
 
     const auto rotate_point = [turns]( point  p ) {
         return p.rotate( turns, { SEEX, SEEY } );
@@ -533,4 +555,18 @@ void submap::rotate( int turns )
         rot_active_furn.emplace( point_sm_ms( rotate_point( elem.first.raw() ) ), elem.second );
     }
     active_furniture = rot_active_furn;
+
+    rebuild_field_tiles();
+}
+
+void submap::rebuild_field_tiles()
+{
+    field_tiles.reset();
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( fld[x][y].field_count() > 0 ) {
+                set_field_tile( point( x, y ) );
+            }
+        }
+    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -94,10 +95,12 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_trap( point p, trap_id trap ) {
             is_uniform = false;
+            mark_dirty();
             trp[p.x][p.y] = trap;
         }
 
         void set_all_traps( const trap_id &trap ) {
+            mark_dirty();
             std::uninitialized_fill_n( &trp[0][0], elements, trap );
         }
 
@@ -107,10 +110,12 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_furn( point p, furn_id furn ) {
             is_uniform = false;
+            mark_dirty();
             frn[p.x][p.y] = furn;
         }
 
         void set_all_furn( const furn_id &furn ) {
+            mark_dirty();
             std::uninitialized_fill_n( &frn[0][0], elements, furn );
         }
 
@@ -120,10 +125,12 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_ter( point p, ter_id terr ) {
             is_uniform = false;
+            mark_dirty();
             ter[p.x][p.y] = terr;
         }
 
         void set_all_ter( const ter_id &terr ) {
+            mark_dirty();
             std::uninitialized_fill_n( &ter[0][0], elements, terr );
         }
 
@@ -133,6 +140,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_radiation( point p, const int radiation ) {
             is_uniform = false;
+            mark_dirty();
             rad[p.x][p.y] = radiation;
         }
 
@@ -142,11 +150,13 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_lum( point p, uint8_t luminance ) {
             is_uniform = false;
+            mark_dirty();
             lum[p.x][p.y] = luminance;
         }
 
         void update_lum_add( point p, const item &i ) {
             is_uniform = false;
+            mark_dirty();
             if( i.is_emissive() && lum[p.x][p.y] < 255 ) {
                 lum[p.x][p.y]++;
             }
@@ -172,6 +182,13 @@ class submap : maptile_soa<SEEX, SEEY>
             return fld[p.x][p.y];
         }
 
+        /** Marks a tile as holding a field, so that field processing visits it. */
+        void set_field_tile( point p ) {
+            field_tiles.set( p.x * SEEY + p.y );
+        }
+        /** Rebuilds @ref field_tiles from the fields actually present. */
+        void rebuild_field_tiles();
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -185,6 +202,7 @@ class submap : maptile_soa<SEEX, SEEY>
         }
 
         void set_temperature( int new_temperature ) {
+            mark_dirty();
             temperature = new_temperature;
         }
 
@@ -217,6 +235,28 @@ class submap : maptile_soa<SEEX, SEEY>
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version, const tripoint offset );
 
+        /**
+         * Records a change to the saved state of this submap. Setters call this themselves,
+         * code that modifies the exposed containers in place has to call it.
+         */
+        void mark_dirty() {
+            generation++;
+        }
+        /** Whether the submap changed since it was last written or read. */
+        bool is_dirty() const;
+        /**
+         * Called after the current state has been written in save transaction @p tx,
+         * see @ref world::current_save_tx, or read from the save.
+         */
+        void mark_saved( uint64_t tx = 0 ) {
+            saved_generation = generation;
+            saved_tx = tx;
+        }
+        /** Save transaction of the last write, the submap is dirty again if it failed. */
+        uint64_t get_saved_tx() const {
+            return saved_tx;
+        }
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
@@ -226,6 +266,12 @@ class submap : maptile_soa<SEEX, SEEY>
         active_item_cache active_items;
 
         int field_count = 0;
+        /**
+         * Tiles field processing has to visit, indexed by x * SEEY + y.
+         * A superset of the tiles holding fields: bits are set when a field is added
+         * and cleared once processing finds the tile empty.
+         */
+        std::bitset<SEEX * SEEY> field_tiles;
         time_point last_touched = calendar::turn_zero;
         std::vector<spawn_point> spawns;
         /**
@@ -243,6 +289,10 @@ class submap : maptile_soa<SEEX, SEEY>
         std::map<point, computer> computers;
         std::unique_ptr<computer> legacy_computer;
         int temperature = 0;
+        // Bumped on every change, a new submap starts out dirty.
+        uint32_t generation = 1;
+        uint32_t saved_generation = 0;
+        uint64_t saved_tx = 0;
 
         void update_legacy_computer();
 
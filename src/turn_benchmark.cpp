@@ -0,0 +1,172 @@
+#include "turn_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <numeric>
+#include <ostream>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "coordinates.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "json.h"
+#include "options.h"
+#include "profile.h"
+#include "rng.h"
+#include "string_formatter.h"
+
+namespace turn_benchmark
+{
+
+int parse_args( options &opts, int num_args, const char **params )
+{
+    if( num_args < 3 ) {
+        return -1;
+    }
+    opts.world = params[0];
+    opts.turns = std::atoi( params[1] );
+    opts.report_path = params[2];
+    if( opts.turns <= 0 ) {
+        return -1;
+    }
+    int consumed = 3;
+    if( num_args > consumed && params[consumed][0] != '-' ) {
+        const std::string script = params[consumed];
+        if( script == "wait" ) {
+            opts.script = script_kind::wait;
+        } else if( script == "travel" ) {
+            opts.script = script_kind::travel;
+        } else {
+            return -1;
+        }
+        consumed++;
+    }
+    if( num_args > consumed && params[consumed][0] != '-' ) {
+        opts.seed = static_cast<unsigned int>( std::strtoul( params[consumed], nullptr, 10 ) );
+        consumed++;
+    }
+    return consumed;
+}
+
+namespace
+{
+
+using duration = std::chrono::duration<double, std::milli>;
+
+double percentile( const std::vector<double> &sorted, double p )
+{
+    if( sorted.empty() ) {
+        return 0.0;
+    }
+    const size_t idx = std::min( sorted.size() - 1,
+                                 static_cast<size_t>( p * static_cast<double>( sorted.size() ) ) );
+    return sorted[idx];
+}
+
+void write_report( std::ostream &stream, const options &opts, std::vector<double> turn_ms,
+                   double total_ms, uint64_t allocations )
+{
+    std::sort( turn_ms.begin(), turn_ms.end() );
+    const double sum = std::accumulate( turn_ms.begin(), turn_ms.end(), 0.0 );
+    const size_t turns = turn_ms.size();
+
+    std::vector<const cata::profile::zone_site *> zones;
+    for( const cata::profile::zone_site *site : cata::profile::zone_sites() ) {
+        if( site->calls > 0 ) {
+            zones.push_back( site );
+        }
+    }
+    std::sort( zones.begin(), zones.end(), []( const auto * a, const auto * b ) {
+        return a->total() > b->total();
+    } );
+
+    JsonOut jsout( stream, true );
+    jsout.start_object();
+    jsout.member( "world", opts.world );
+    jsout.member( "script", opts.script == script_kind::travel ? "travel" : "wait" );
+    jsout.member( "seed", opts.seed );
+    jsout.member( "turns", turns );
+    jsout.member( "wall_ms", total_ms );
+    jsout.member( "turn_ms" );
+    jsout.start_object();
+    jsout.member( "mean", turns > 0 ? sum / static_cast<double>( turns ) : 0.0 );
+    jsout.member( "p50", percentile( turn_ms, 0.50 ) );
+    jsout.member( "p90", percentile( turn_ms, 0.90 ) );
+    jsout.member( "p99", percentile( turn_ms, 0.99 ) );
+    jsout.member( "max", turn_ms.empty() ? 0.0 : turn_ms.back() );
+    jsout.end_object();
+    // Builds without allocation counting report null instead of a misleading zero
+    if( cata::profile::counts_allocations() ) {
+        jsout.member( "allocations", allocations );
+        jsout.member( "allocations_per_turn",
+                      turns > 0 ? static_cast<double>( allocations ) / static_cast<double>( turns ) : 0.0 );
+    } else {
+        jsout.null_member( "allocations" );
+        jsout.null_member( "allocations_per_turn" );
+    }
+    jsout.member( "zones" );
+    jsout.start_array();
+    for( const cata::profile::zone_site *site : zones ) {
+        jsout.start_object();
+        jsout.member( "name", std::string( site->name ) );
+        jsout.member( "location", string_format( "%s:%d", site->location.file_name(),
+                      site->location.line() ) );
+        jsout.member( "calls", site->calls.load() );
+        jsout.member( "total_ms", duration( site->total() ).count() );
+        jsout.member( "per_turn_ms", duration( site->total() ).count() / static_cast<double>( turns ) );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+    stream << '\n';
+}
+
+} // namespace
+
+int run( const options &opts )
+{
+    if( !g->load( opts.world ) ) {
+        cata_printf( "Benchmark: cannot load world '%s'.\n", opts.world );
+        return 1;
+    }
+    options_manager::cache_balance_options();
+    rng_set_engine_seed( opts.seed );
+
+    avatar &u = get_avatar();
+    std::vector<double> turn_ms;
+    turn_ms.reserve( opts.turns );
+
+    cata::profile::reset();
+    cata::profile::collecting = true;
+    const auto bench_start = std::chrono::steady_clock::now();
+    for( int i = 0; i < opts.turns; i++ ) {
+        if( opts.script == script_kind::travel && i > 0 && i % opts.travel_interval == 0 ) {
+            g->place_player_overmap( u.global_omt_location() + point_east );
+        }
+        // No input is read while the avatar is out of moves, so every turn is a wait.
+        u.moves = 0;
+        const auto turn_start = std::chrono::steady_clock::now();
+        if( g->do_turn() ) {
+            break;
+        }
+        turn_ms.push_back( duration( std::chrono::steady_clock::now() - turn_start ).count() );
+    }
+    const double total_ms = duration( std::chrono::steady_clock::now() - bench_start ).count();
+    cata::profile::collecting = false;
+    const uint64_t allocations = cata::profile::allocation_count();
+
+    const bool written = write_to_file( opts.report_path, [&]( std::ostream & stream ) {
+        write_report( stream, opts, turn_ms, total_ms, allocations );
+    } );
+    if( !written ) {
+        return 1;
+    }
+    cata_printf( "Benchmark: %d turns in %.1f ms, report written to %s.\n",
+                 static_cast<int>( turn_ms.size() ), total_ms, opts.report_path );
+    return 0;
+}
+
+} // namespace turn_benchmark
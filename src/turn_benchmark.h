@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+/**
+ * Headless turn replay used to measure simulation performance.
+ *
+ * Loads the first save of a world, runs a fixed number of turns with a scripted
+ * avatar and writes a JSON report with turn time percentiles, allocation counts
+ * and the per-zone timings of every ZoneScoped site that was reached.
+ */
+namespace turn_benchmark
+{
+
+enum class script_kind : int {
+    // Avatar stays in place.
+    wait,
+    // Avatar is moved one overmap tile east every @ref options::travel_interval turns.
+    travel,
+};
+
+struct options {
+    std::string world;
+    std::string report_path;
+    int turns = 1000;
+    script_kind script = script_kind::wait;
+    int travel_interval = 50;
+    unsigned int seed = 42;
+};
+
+/**
+ * Parses "<world> <turns> <report> [wait|travel] [seed]".
+ * @return Number of parameters consumed, or -1 on error.
+ */
+int parse_args( options &opts, int num_args, const char **params );
+
+/** Runs the benchmark. Expects static data to be loaded. @return Process exit code. */
+int run( const options &opts );
+
+} // namespace turn_benchmark
@@ -2734,6 +2734,67 @@ std::vector<detached_ptr<item>> vehicle_part::pieces_for_broken_part() const
     return item_group::items_from( group, calendar::turn );
 }
 
+void vehicle_mount_grid::clear()
+{
+    origin = point_zero;
+    width = 0;
+    height = 0;
+    offsets.clear();
+    indices.clear();
+}
+
+void vehicle_mount_grid::build( const std::vector<std::pair<point, int>> &entries )
+{
+    clear();
+    if( entries.empty() ) {
+        return;
+    }
+    point min = entries.front().first;
+    point max = min;
+    for( const std::pair<point, int> &e : entries ) {
+        min.x = std::min( min.x, e.first.x );
+        min.y = std::min( min.y, e.first.y );
+        max.x = std::max( max.x, e.first.x );
+        max.y = std::max( max.y, e.first.y );
+    }
+    origin = min;
+    width = max.x - min.x + 1;
+    height = max.y - min.y + 1;
+
+    // Counting sort: count per cell, prefix sum, then scatter in original order
+    offsets.assign( static_cast<size_t>( width * height ) + 1, 0 );
+    for( const std::pair<point, int> &e : entries ) {
+        offsets[cell_index( e.first ) + 1]++;
+    }
+    for( size_t i = 1; i < offsets.size(); i++ ) {
+        offsets[i] += offsets[i - 1];
+    }
+    indices.resize( entries.size() );
+    std::vector<int> fill( offsets.begin(), offsets.end() - 1 );
+    for( const std::pair<point, int> &e : entries ) {
+        indices[fill[cell_index( e.first )]++] = e.second;
+    }
+}
+
+int vehicle_mount_grid::cell_index( point mount ) const
+{
+    const point rel = mount - origin;
+    if( rel.x < 0 || rel.y < 0 || rel.x >= width || rel.y >= height ) {
+        return -1;
+    }
+    return rel.y * width + rel.x;
+}
+
+std::span<const int> vehicle_mount_grid::at( point mount ) const
+{
+    const int cell = cell_index( mount );
+    if( cell < 0 ) {
+        return {};
+    }
+    return std::span<const int>( indices.data() + offsets[cell],
+                                 indices.data() + offsets[cell + 1] );
+}
+
 std::vector<int> vehicle::parts_at_relative( point dp,
         const bool use_cache ) const
 {
@@ -2746,13 +2807,8 @@ std::vector<int> vehicle::parts_at_relative( point dp,
         }
         return res;
     } else {
-        const auto &iter = relative_parts.find( dp );
-        if( iter != relative_parts.end() ) {
-            return iter->second;
-        } else {
-            std::vector<int> res;
-            return res;
-        }
+        const std::span<const int> here = relative_parts.at( dp );
+        return std::vector<int>( here.begin(), here.end() );
     }
 }
 
@@ -2826,13 +2882,9 @@ int vehicle::part_with_feature( int part, vpart_bitflags const flag, bool unbrok
     if( part_flag( part, flag ) && ( !unbroken || !parts[part].is_broken() ) ) {
         return part;
     }
-    const auto it = relative_parts.find( parts[part].mount );
-    if( it != relative_parts.end() ) {
-        const std::vector<int> &parts_here = it->second;
-        for( auto &i : parts_here ) {
-            if( part_flag( i, flag ) && ( !unbroken || !parts[i].is_broken() ) ) {
-                return i;
-            }
+    for( const int i : relative_parts.at( parts[part].mount ) ) {
+        if( part_flag( i, flag ) && ( !unbroken || !parts[i].is_broken() ) ) {
+            return i;
         }
     }
     return -1;
@@ -2845,8 +2897,7 @@ int vehicle::part_with_feature( int part, const std::string &flag, bool unbroken
 
 int vehicle::part_with_feature( point pt, const std::string &flag, bool unbroken ) const
 {
-    std::vector<int> parts_here = parts_at_relative( pt, true );
-    for( auto &elem : parts_here ) {
+    for( const int elem : relative_parts.at( pt ) ) {
         if( part_flag( elem, flag ) && ( !unbroken || !parts[ elem ].is_broken() ) ) {
             return elem;
         }
@@ -3008,10 +3059,10 @@ void vpart_position::set_label( const std::string &text ) const
 
 int vehicle::next_part_to_close( int p, bool outside ) const
 {
-    std::vector<int> parts_here = parts_at_relative( parts[p].mount, true );
+    const std::span<const int> parts_here = parts_at_relative_view( parts[p].mount );
 
     // We want reverse, since we close the outermost thing first (curtains), and then the innermost thing (door)
-    for( std::vector<int>::reverse_iterator part_it = parts_here.rbegin();
+    for( auto part_it = parts_here.rbegin();
          part_it != parts_here.rend();
          ++part_it ) {
 
@@ -3027,10 +3078,8 @@ int vehicle::next_part_to_close( int p, bool outside ) const
 
 int vehicle::next_part_to_open( int p, bool outside ) const
 {
-    std::vector<int> parts_here = parts_at_relative( parts[p].mount, true );
-
     // We want forwards, since we open the innermost thing first (curtains), and then the innermost thing (door)
-    for( auto &elem : parts_here ) {
+    for( const int elem : parts_at_relative_view( parts[p].mount ) ) {
         if( part_flag( elem, VPFLAG_OPENABLE ) && parts[ elem ].is_available() && parts[elem].open == 0 &&
             ( !outside || !part_flag( elem, "OPENCLOSE_INSIDE" ) ) ) {
             return elem;
@@ -3321,7 +3370,7 @@ int vehicle::part_displayed_at( point dp ) const
     // it's clear where the magic number comes from.
     const int ON_ROOF_Z = 9;
 
-    std::vector<int> parts_in_square = parts_at_relative( dp, true );
+    const std::span<const int> parts_in_square = parts_at_relative_view( dp );
 
     if( parts_in_square.empty() ) {
         return -1;
@@ -3357,8 +3406,7 @@ int vehicle::part_displayed_at( point dp ) const
 
 int vehicle::roof_at_part( const int part ) const
 {
-    std::vector<int> parts_in_square = parts_at_relative( parts[part].mount, true );
-    for( const int p : parts_in_square ) {
+    for( const int p : parts_at_relative_view( parts[part].mount ) ) {
         if( part_info( p ).location == "on_roof" || part_flag( p, "ROOF" ) ) {
             return p;
         }
@@ -6299,6 +6347,25 @@ void vehicle::refresh()
 
     bool refresh_done = false;
 
+    // Build grid of point -> all parts in that point, sorted by list order.
+    // Parts with equal list order end up in reverse index order, as if each
+    // was inserted before its equals.
+    std::vector<std::pair<point, int>> mounted;
+    mounted.reserve( parts.size() );
+    for( const vpart_reference &vp : get_all_parts() ) {
+        if( !vp.part().removed ) {
+            mounted.emplace_back( vp.mount(), static_cast<int>( vp.part_index() ) );
+        }
+    }
+    std::sort( mounted.begin(), mounted.end(),
+    [&svpv]( const std::pair<point, int> &lhs, const std::pair<point, int> &rhs ) {
+        if( svpv( lhs.second, rhs.second ) ) {
+            return true;
+        }
+        return !svpv( rhs.second, lhs.second ) && lhs.second > rhs.second;
+    } );
+    relative_parts.build( mounted );
+
     // Main loop over all vehicle parts.
     for( const vpart_reference &vp : get_all_parts() ) {
         const size_t p = vp.part_index();
@@ -6308,19 +6375,12 @@ void vehicle::refresh()
         }
         refresh_done = true;
 
-        // Build map of point -> all parts in that point
         const point pt = vp.mount();
         mount_min.x = std::min( mount_min.x, pt.x );
         mount_min.y = std::min( mount_min.y, pt.y );
         mount_max.x = std::max( mount_max.x, pt.x );
         mount_max.y = std::max( mount_max.y, pt.y );
 
-        // This will keep the parts at point pt sorted
-        std::vector<int>::iterator vii = std::lower_bound( relative_parts[pt].begin(),
-                                         relative_parts[pt].end(),
-                                         static_cast<int>( p ), svpv );
-        relative_parts[pt].insert( vii, p );
-
         if( vpi.has_flag( VPFLAG_FLOATS ) ) {
             floating.push_back( p );
         }
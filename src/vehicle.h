@@ -5,6 +5,7 @@
 #include <map>
 #include <optional>
 #include <set>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -116,6 +117,44 @@ struct veh_collision {
 
     veh_collision() = default;
 };
+
+/**
+ * Dense lookup of part indices by mount point.
+ *
+ * Covers the bounding box of the vehicle's mount points with one cell per mount,
+ * each cell being a span into a single shared list of part indices.
+ * Rebuilt by @ref vehicle::refresh, so it is only valid as long as parts are not
+ * added or removed.
+ */
+class vehicle_mount_grid
+{
+    public:
+        void clear();
+        /**
+         * Rebuilds the grid from a list of (mount, part index) pairs.
+         * Pairs sharing a mount keep their relative order.
+         */
+        void build( const std::vector<std::pair<point, int>> &entries );
+
+        /** Part indices at given mount point, empty if there are none. */
+        std::span<const int> at( point mount ) const;
+        bool contains( point mount ) const {
+            return !at( mount ).empty();
+        }
+        /** Index of the cell at given mount point, or -1 if it's outside of the grid. */
+        int cell_index( point mount ) const;
+        int cell_count() const {
+            return width * height;
+        }
+
+    private:
+        point origin;
+        int width = 0;
+        int height = 0;
+        // cell i holds indices[offsets[i]] .. indices[offsets[i + 1]]
+        std::vector<int> offsets;
+        std::vector<int> indices;
+};
 //TODO!: location stuffs here
 class vehicle_stack : public item_stack
 {
@@ -709,6 +748,10 @@ class vehicle
 
         // returns the list of indices of parts at certain position (not accounting frame direction)
         std::vector<int> parts_at_relative( point dp, bool use_cache ) const;
+        // same as cached parts_at_relative, but doesn't copy the list
+        std::span<const int> parts_at_relative_view( point dp ) const {
+            return relative_parts.at( dp );
+        }
 
         // returns index of part, inner to given, with certain flag, or -1
         int part_with_feature( int p, const std::string &f, bool unbroken ) const;
@@ -1663,7 +1706,7 @@ class vehicle
          */
         vproto_id type;
         // parts_at_relative(dp) is used a lot (to put it mildly)
-        std::map<point, std::vector<int>> relative_parts;
+        vehicle_mount_grid relative_parts;
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
@@ -15,6 +15,7 @@
 #include "avatar.h"
 #include "bodypart.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "enums.h"
 #include "explosion.h"
@@ -29,6 +30,7 @@
 #include "math_defines.h"
 #include "messages.h"
 #include "monster.h"
+#include "npc.h"
 #include "options.h"
 #include "player.h"
 #include "point_float.h"
@@ -399,6 +401,112 @@ void vehicle::stop( bool update_cache )
     }
 }
 
+namespace
+{
+
+/**
+ * Cheap rejection test for horizontal collisions.
+ *
+ * A tile holding no creature, no vehicle other than the moving one and only flat
+ * terrain and furniture can't produce a collision for any part moved into it, so the
+ * per-part narrowphase can be skipped for it. All parts on a mount move into the same
+ * tile, so results are remembered per mount cell until the next hit, which may fling
+ * creatures around or destroy obstacles.
+ */
+class collision_broadphase
+{
+    public:
+        collision_broadphase( const vehicle &veh, const tripoint &dp ) : veh( veh ),
+            here( get_map() ), cache( here.get_cache_ref( veh.sm_pos.z ) ),
+            cells( veh.relative_parts.cell_count(), cell_unknown ) {
+            // Swept bounding box of the tiles the vehicle moves into
+            const tripoint origin = veh.global_pos3() + dp;
+            min = origin.xy();
+            max = origin.xy();
+            for( const vpart_reference &vp : veh.get_all_parts() ) {
+                const point dest = origin.xy() + vp.part().precalc[1].xy();
+                min.x = std::min( min.x, dest.x );
+                min.y = std::min( min.y, dest.y );
+                max.x = std::max( max.x, dest.x );
+                max.y = std::max( max.y, dest.y );
+            }
+            collect_characters();
+        }
+
+        bool is_clear( point mount, const tripoint &dest ) {
+            const int cell = veh.relative_parts.cell_index( mount );
+            if( cell < 0 ) {
+                return test( dest );
+            }
+            if( cells[cell] == cell_unknown ) {
+                cells[cell] = test( dest ) ? cell_clear : cell_blocked;
+            }
+            return cells[cell] == cell_clear;
+        }
+
+        // Called after a collision, which may have flung or moved anything in the way
+        void forget() {
+            std::fill( cells.begin(), cells.end(), cell_unknown );
+            collect_characters();
+        }
+
+    private:
+        // Characters are not in the creature tracker, collect those in the way once
+        // instead of scanning all NPCs for every part.
+        void collect_characters() {
+            characters.clear();
+            const auto in_box = [&]( const Character & who ) {
+                const tripoint &pos = who.pos();
+                return !who.in_vehicle && pos.x >= min.x && pos.x <= max.x &&
+                       pos.y >= min.y && pos.y <= max.y;
+            };
+            Character &you = get_player_character();
+            if( in_box( you ) ) {
+                characters.push_back( you.pos() );
+            }
+            for( npc &guy : g->all_npcs() ) {
+                if( !guy.is_dead() && in_box( guy ) ) {
+                    characters.push_back( guy.pos() );
+                }
+            }
+        }
+
+        bool test( const tripoint &dest ) const {
+            if( !here.inbounds( dest ) ) {
+                return false;
+            }
+            if( cache.veh_exists_at[dest.x][dest.y] ) {
+                const optional_vpart_position ovp = here.veh_at( dest );
+                if( ovp && &ovp->vehicle() != &veh ) {
+                    return false;
+                }
+            }
+            if( here.move_cost_ter_furn( dest ) != 2 ) {
+                return false;
+            }
+            if( g->critter_tracker->find( dest ) ) {
+                return false;
+            }
+            return std::find( characters.begin(), characters.end(), dest ) == characters.end();
+        }
+
+        enum cell_state : char {
+            cell_unknown,
+            cell_clear,
+            cell_blocked
+        };
+
+        const vehicle &veh;
+        const map &here;
+        const level_cache &cache;
+        point min;
+        point max;
+        std::vector<tripoint> characters;
+        std::vector<cell_state> cells;
+};
+
+} // namespace
+
 bool vehicle::collision( std::vector<veh_collision> &colls,
                          const tripoint &dp,
                          bool just_detect, bool bash_floor )
@@ -442,6 +550,10 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
     const int velocity_before = coll_velocity;
     int lowest_velocity = coll_velocity;
     const int sign_before = sgn( velocity_before );
+    std::optional<collision_broadphase> broadphase;
+    if( !vertical ) {
+        broadphase.emplace( *this, dp );
+    }
     bool empty = true;
     for( int p = 0; static_cast<size_t>( p ) < parts.size(); p++ ) {
         const vpart_info &info = part_info( p );
@@ -453,12 +565,18 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
         // Coordinates of where part will go due to movement (dx/dy/dz)
         //  and turning (precalc[1])
         const tripoint dsp = global_pos3() + dp + parts[p].precalc[1];
+        if( broadphase && broadphase->is_clear( parts[p].mount, dsp ) ) {
+            continue;
+        }
         veh_collision coll = part_collision( p, dsp, just_detect, bash_floor );
         if( coll.type == veh_coll_nothing ) {
             continue;
         }
 
         colls.push_back( coll );
+        if( broadphase ) {
+            broadphase->forget();
+        }
 
         if( just_detect ) {
             // DO insert the first collision so we can tell what was it
@@ -521,13 +639,9 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != sm_pos.z;
-    Character &player_character = get_player_character();
-    const bool pl_ctrl = player_in_control( player_character );
     Creature *critter = g->critter_at( p, true );
     player *ph = dynamic_cast<player *>( critter );
 
-    Creature *driver = pl_ctrl ? &player_character : nullptr;
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
@@ -652,6 +766,9 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         return ret;
     }
     stop_autodriving();
+    Character &player_character = get_player_character();
+    const bool pl_ctrl = player_in_control( player_character );
+    Creature *driver = pl_ctrl ? &player_character : nullptr;
     // Calculate mass AFTER checking for collision
     //  because it involves iterating over all cargo
     // Rotors only use rotor mass in calculation.
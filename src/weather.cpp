@@ -1171,11 +1171,6 @@ void weather_manager::set_nextweather( time_point t )
 
 auto weather_manager::get_temperature( const tripoint &location ) const -> units::temperature
 {
-    const auto &cached = temperature_cache.find( location );
-    if( cached != temperature_cache.end() ) {
-        return cached->second;
-    }
-
     // local modifier
     int temp_mod = 0;
 
@@ -1225,12 +1220,12 @@ units::temperature
         return temperatures::annual_average;
     }
 
-    tripoint abs_ms = project_to<coords::ms>( location ).raw();
-    w_point w = get_cur_weather_gen().get_weather( abs_ms, calendar::turn, g->get_seed() );
+    const units::temperature surface_temperature =
+        get_weather_noise( get_cur_weather_gen(), location.xy() ).temperature;
 
     if( location.z() >= 0 ) {
         // Surface: full influence from current weather
-        return w.temperature;
+        return surface_temperature;
     }
 
     // Underground: gradual transition to annual average
@@ -1243,7 +1238,7 @@ units::temperature
     const double influence_factor = location.z() == -1 ? 0.5 : 0.25;
 
     const double annual_avg_c = units::to_celsius( temperatures::annual_average );
-    const double current_temp_c = units::to_celsius( w.temperature );
+    const double current_temp_c = units::to_celsius( surface_temperature );
     const double temp_diff_c = current_temp_c - annual_avg_c;
     const double base_temp_c = annual_avg_c + temp_diff_c * influence_factor;
 
@@ -1257,7 +1252,49 @@ auto weather_manager::get_water_temperature( const tripoint & ) const -> units::
 
 void weather_manager::clear_temp_cache()
 {
-    temperature_cache.clear();
+    g->m.set_radiant_heat_cache_dirty();
+}
+
+weather_noise weather_manager::get_weather_noise( const weather_generator &wgen,
+        const point_abs_omt &p ) const
+{
+    // About 16k overmap terrains, more than a zoomed out overmap view shows
+    static constexpr size_t max_blocks = 64;
+    const time_point hour = calendar::turn_zero +
+                            time_duration::from_hours( to_hours<int>( calendar::turn - calendar::turn_zero ) );
+    if( noise_blocks_hour != hour ) {
+        noise_blocks.clear();
+        noise_blocks_hour = hour;
+    }
+
+    const point_abs_omt origin( multiply_xy( divide_xy_round_to_minus_infinity( p.raw(),
+                                weather_noise_block_size ), weather_noise_block_size ) );
+    const point_rel_omt offset = p - origin;
+    const size_t index = offset.y() * weather_noise_block_size + offset.x();
+    const unsigned int seed = g->get_seed();
+    for( const weather_noise_block &block : noise_blocks ) {
+        if( block.wgen == &wgen && block.seed == seed && block.origin == origin ) {
+            return block.noise[index];
+        }
+    }
+
+    if( noise_blocks.size() >= max_blocks ) {
+        noise_blocks.erase( noise_blocks.begin() );
+    }
+    weather_noise_block &block = noise_blocks.emplace_back();
+    block.wgen = &wgen;
+    block.seed = seed;
+    block.origin = origin;
+    wgen.get_weather_noise( project_to<coords::ms>( origin ), weather_noise_block_size,
+                            weather_noise_block_size, SEEX * 2, hour, calendar::config, seed,
+                            block.noise );
+    return block.noise[index];
+}
+
+void weather_manager::clear_weather_noise()
+{
+    noise_blocks.clear();
+    noise_blocks_hour = calendar::before_time_starts;
 }
 
 namespace weather
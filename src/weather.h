@@ -210,15 +210,22 @@ class weather_manager
         // The time at which weather will shift next.
         time_point nextweather;
 
-        /** temperature cache, cleared every turn, sparse map of map tripoints to temperatures */
-        mutable std::unordered_map< tripoint, units::temperature > temperature_cache;
         // Returns outdoor or indoor temperature of given location (in local coords).
         auto get_temperature( const tripoint &location ) const -> units::temperature;
         // Returns outdoor or indoor temperature of given location
         auto get_temperature( const tripoint_abs_omt &location ) const -> units::temperature;
         // Returns water temperature of given location (in local coords).
         auto get_water_temperature( const tripoint &location ) const -> units::temperature;
+        // Invalidates the per-turn radiant heat caches, see map::get_radiant_heat
         void clear_temp_cache();
+        /**
+         * Weather noise of the overmap terrain at the start of the current hour.
+         * Noise is computed for a whole block of overmap terrains at once and cached until
+         * the hour or the game seed changes.
+         */
+        weather_noise get_weather_noise( const weather_generator &wgen, const point_abs_omt &p ) const;
+        /** Drops the blocks cached by @ref get_weather_noise, for a new or loaded game. */
+        void clear_weather_noise();
 
         // Get precise weather data
         const w_point &get_precise() const {
@@ -233,6 +240,17 @@ class weather_manager
     private:
         // Cached weather data
         w_point weather_precise;
+
+        static constexpr int weather_noise_block_size = 16;
+        struct weather_noise_block {
+            const weather_generator *wgen;
+            unsigned int seed;
+            point_abs_omt origin;
+            std::vector<weather_noise> noise;
+        };
+        // Blocks of get_weather_noise for noise_blocks_hour, oldest first
+        mutable std::vector<weather_noise_block> noise_blocks;
+        mutable time_point noise_blocks_hour = calendar::before_time_starts;
 };
 
 weather_manager &get_weather();
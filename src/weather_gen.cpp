@@ -87,6 +87,19 @@ static units::temperature season_temp( const weather_generator &wg, double year_
            + units::multiply_any_unit( wg.season_stats[next_season].average_temperature, t );
 }
 
+// Temperature in celsius before the location dependent noise is added
+static double base_temperature_celsius( const weather_generator &wg,
+                                        const weather_gen_common &common, const time_point &t )
+{
+    const double dayFraction = time_past_midnight( t ) / 1_days;
+    // -1 at coldest_hour, +1 twelve hours later
+    const double dayv = std::cos( tau * ( dayFraction + .5 - coldest_hour / 24 ) );
+
+    units::temperature season_factor = season_temp( wg, common.year_fraction );
+    return units::to_celsius<double>( season_factor ) +
+           dayv * units::to_celsius<double>( wg.temperature_daily_amplitude );
+}
+
 static units::temperature weather_temperature_from_common_data( const weather_generator &wg,
         const weather_gen_common &common, const time_point &t )
 {
@@ -95,14 +108,8 @@ static units::temperature weather_temperature_from_common_data( const weather_ge
     const double z( common.z );
 
     const unsigned modSEED = common.modSEED;
-    const double dayFraction = time_past_midnight( t ) / 1_days;
-    // -1 at coldest_hour, +1 twelve hours later
-    const double dayv = std::cos( tau * ( dayFraction + .5 - coldest_hour / 24 ) );
-
-    units::temperature season_factor = season_temp( wg, common.year_fraction );
     const double temperature_celsius =
-        units::to_celsius<double>( season_factor ) +
-        dayv * units::to_celsius<double>( wg.temperature_daily_amplitude ) +
+        base_temperature_celsius( wg, common, t ) +
         raw_noise_4d( x, y, z, modSEED ) * units::to_celsius<double>( wg.temperature_noise_amplitude );
 
     return units::from_celsius( temperature_celsius );
@@ -123,6 +130,12 @@ w_point weather_generator::get_weather( const tripoint &location, const time_poi
 
 w_point weather_generator::get_weather( const tripoint_abs_ms &location, const time_point &t,
                                         const calendar_config &calendar_config, unsigned seed ) const
+{
+    return get_weather( get_weather_noise( location, t, calendar_config, seed ), t, calendar_config );
+}
+
+weather_noise weather_generator::get_weather_noise( const tripoint_abs_ms &location,
+        const time_point &t, const calendar_config &calendar_config, unsigned seed ) const
 {
     const weather_gen_common common = get_common_data( location.xy(), t, calendar_config, seed );
 
@@ -135,25 +148,92 @@ w_point weather_generator::get_weather( const tripoint_abs_ms &location, const t
     const double cgyf = common.cosine_of_gregorian_year_fraction;
     const season_type season = common.season;
 
-    // Noise factors
-    const units::temperature T( weather_temperature_from_common_data( *this, common, t ) );
-    double A( raw_noise_4d( x, y, z, modSEED ) * 8.0 );
-    double W( raw_noise_4d( x / 2.5, y / 2.5, z / 200, modSEED ) * 10.0 );
+    weather_noise result;
+    result.temperature = weather_temperature_from_common_data( *this, common, t );
+    result.acid = raw_noise_4d( x, y, z, modSEED ) * 8.0;
+    result.wind = raw_noise_4d( x / 2.5, y / 2.5, z / 200, modSEED ) * 10.0;
 
     // Humidity variation
     double mod_h = season_stats[static_cast<size_t>( season )].humidity_mod;
     // Relative humidity, a percentage.
-    double H = std::min( 100., std::max( 0.,
-                                         base_humidity + mod_h + 100 * (
-                                                 .15 * -cgyf +
-                                                 raw_noise_4d( x, y, z, modSEED + 101 ) *
-                                                 .2 * ( cgyf + 2 ) ) ) );
+    result.humidity = std::min( 100., std::max( 0.,
+                                base_humidity + mod_h + 100 * (
+                                        .15 * -cgyf +
+                                        raw_noise_4d( x, y, z, modSEED + 101 ) *
+                                        .2 * ( cgyf + 2 ) ) ) );
 
     // Pressure
-    double P =
+    result.pressure =
         base_pressure +
         raw_noise_4d( x, y, z, modSEED + 211 ) *
         10 * ( cgyf + 2 );
+    return result;
+}
+
+void weather_generator::get_weather_noise( const point_abs_ms &origin, int width, int height,
+        int step, const time_point &t, const calendar_config &calendar_config, unsigned seed,
+        std::vector<weather_noise> &noise ) const
+{
+    const weather_gen_common common = get_common_data( origin, t, calendar_config, seed );
+    const double z( common.z );
+    const unsigned modSEED = common.modSEED;
+    const double cgyf = common.cosine_of_gregorian_year_fraction;
+    const double mod_h = season_stats[static_cast<size_t>( common.season )].humidity_mod;
+    const double base_celsius = base_temperature_celsius( *this, common, t );
+    const double noise_celsius = units::to_celsius<double>( temperature_noise_amplitude );
+
+    const size_t size = static_cast<size_t>( width ) * height;
+    std::vector<double> xs( size );
+    std::vector<double> ys( size );
+    for( int j = 0; j < height; j++ ) {
+        for( int i = 0; i < width; i++ ) {
+            xs[j * width + i] = ( origin.x() + i * step ) / 2000.0;
+            ys[j * width + i] = ( origin.y() + j * step ) / 2000.0;
+        }
+    }
+
+    // One pass per noise layer, the temperature and acid noise are the same layer
+    std::vector<double> base_noise( size );
+    std::vector<double> wind_noise( size );
+    std::vector<double> humidity_noise( size );
+    std::vector<double> pressure_noise( size );
+    for( size_t i = 0; i < size; i++ ) {
+        base_noise[i] = raw_noise_4d( xs[i], ys[i], z, modSEED );
+    }
+    for( size_t i = 0; i < size; i++ ) {
+        wind_noise[i] = raw_noise_4d( xs[i] / 2.5, ys[i] / 2.5, z / 200, modSEED );
+    }
+    for( size_t i = 0; i < size; i++ ) {
+        humidity_noise[i] = raw_noise_4d( xs[i], ys[i], z, modSEED + 101 );
+    }
+    for( size_t i = 0; i < size; i++ ) {
+        pressure_noise[i] = raw_noise_4d( xs[i], ys[i], z, modSEED + 211 );
+    }
+
+    noise.resize( size );
+    for( size_t i = 0; i < size; i++ ) {
+        weather_noise &result = noise[i];
+        result.temperature = units::from_celsius( base_celsius + base_noise[i] * noise_celsius );
+        result.acid = base_noise[i] * 8.0;
+        result.wind = wind_noise[i] * 10.0;
+        result.humidity = std::min( 100., std::max( 0., base_humidity + mod_h + 100 * (
+                                        .15 * -cgyf + humidity_noise[i] * .2 * ( cgyf + 2 ) ) ) );
+        result.pressure = base_pressure + pressure_noise[i] * 10 * ( cgyf + 2 );
+    }
+}
+
+w_point weather_generator::get_weather( const weather_noise &noise, const time_point &t,
+                                        const calendar_config &calendar_config ) const
+{
+    const weather_gen_common common = get_common_data( point_abs_ms(), t, calendar_config, 0 );
+    // +1 in midwinter, -1 in midsummer
+    const double cgyf = common.cosine_of_gregorian_year_fraction;
+    const season_type season = common.season;
+    const units::temperature T = noise.temperature;
+    const double H = noise.humidity;
+    const double P = noise.pressure;
+    const double A = noise.acid;
+    double W = noise.wind;
 
     // Wind power
     W = std::max( 0, static_cast<int>( base_wind * rng( 1, 2 ) / std::pow( ( P + W ) / 1014.78, rng( 9,
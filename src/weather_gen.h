@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "calendar.h"
 #include "coordinates.h"
@@ -20,6 +21,17 @@ struct w_point {
     bool acidic = false;
 };
 
+/** The parts of a @ref w_point that only depend on location, time and seed. */
+struct weather_noise {
+    units::temperature temperature = 0_f;
+    double humidity = 0;
+    double pressure = 0;
+    // Noise the wind power is rolled from
+    double wind = 0;
+    // Noise that decides acid rain
+    double acid = 0;
+};
+
 struct season_modifier {
     units::temperature average_temperature = 0_c;
     int humidity_mod = 0;
@@ -62,6 +74,21 @@ class weather_generator
         w_point get_weather( const tripoint &, const time_point &, unsigned seed ) const;
         w_point get_weather( const tripoint_abs_ms &location, const time_point &t,
                              const calendar_config &calendar_config, unsigned seed ) const;
+        /** Completes the noise of a location to a weather point, rolling the wind. */
+        w_point get_weather( const weather_noise &noise, const time_point &t,
+                             const calendar_config &calendar_config ) const;
+        /** The noise part of @ref get_weather for a single location. */
+        weather_noise get_weather_noise( const tripoint_abs_ms &location, const time_point &t,
+                                         const calendar_config &calendar_config, unsigned seed ) const;
+        /**
+         * The noise part of @ref get_weather for a block of width x height locations that are
+         * step map squares apart, starting at origin, in row-major order.
+         * Terms that only depend on time are computed once for the block, and each noise layer
+         * is evaluated in its own pass over the block.
+         */
+        void get_weather_noise( const point_abs_ms &origin, int width, int height, int step,
+                                const time_point &t, const calendar_config &calendar_config, unsigned seed,
+                                std::vector<weather_noise> &noise ) const;
         const weather_type_id &get_weather_conditions( const tripoint &, const time_point &,
                 unsigned seed ) const;
         const weather_type_id &get_weather_conditions( const w_point & ) const;
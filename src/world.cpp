@@ -13,48 +13,13 @@
 #include "filesystem.h"
 #include "output.h"
 #include "worldfactory.h"
+#include "options.h"
 #include "mod_manager.h"
 #include "path_info.h"
-#include "compress.h"
+#include "save_database.h"
 #include "sqlite3.h"
-#include "zlib.h"
 
 #define dbg(x) DebugLogFL((x),DC::Main)
-static sqlite3 *open_db( const std::string &path )
-{
-    sqlite3 *db = nullptr;
-    int ret;
-
-    ret = sqlite3_initialize();
-    if( ret != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to initialize sqlite3 (Error " << ret << ")";
-        throw std::runtime_error( "Failed to initialize sqlite3" );
-    }
-
-    ret = sqlite3_open_v2( path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL );
-    if( ret != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to open db" << path << " (Error " << ret << ")";
-        throw std::runtime_error( "Failed to open db" );
-    }
-
-    auto sql = R"sql(
-        CREATE TABLE IF NOT EXISTS files (
-            path           TEXT PRIMARY KEY NOT NULL,
-            parent         TEXT NOT NULL,
-            compression    TEXT DEFAULT NULL,
-            data           BLOB NOT NULL
-        );
-    )sql";
-
-    char *sqlErrMsg = 0;
-    ret = sqlite3_exec( db, sql, NULL, NULL, &sqlErrMsg );
-    if( ret != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to init db" << path << " (" << sqlErrMsg << ")";
-        throw std::runtime_error( "Failed to open db" );
-    }
-
-    return db;
-}
 
 save_t::save_t( const std::string &name ): name( name ) {}
 
@@ -157,6 +122,7 @@ void WORLDINFO::load_legacy_options( std::istream &fin )
 bool WORLDINFO::load_options()
 {
     WORLD_OPTIONS = get_options().get_world_defaults();
+    options_manager::mark_changed();
 
     using namespace std::placeholders;
     const auto path = folder_path() + "/" + PATH_INFO::worldoptions();
@@ -209,8 +175,7 @@ bool WORLDINFO::save( const bool is_conversion ) const
     // choice of world save format.
     if( world_save_format == save_format::V2_COMPRESSED_SQLITE3 &&
         !file_exist( folder_path() + "/map.sqlite3" ) ) {
-        sqlite3 *db = open_db( folder_path() + "/map.sqlite3" );
-        sqlite3_close( db );
+        save_database db( folder_path() + "/map.sqlite3" );
     }
     return true;
 }
@@ -258,143 +223,11 @@ void load_external_option( const JsonObject &jo )
     }
 }
 
-static bool file_exist_in_db( sqlite3 *db, const std::string &path )
-{
-    int fileCount = 0;
-    const char *sql = "SELECT count() FROM files WHERE path = :path";
-    sqlite3_stmt *stmt = nullptr;
-
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
-        // Retrieve the count result
-        fileCount = sqlite3_column_int( stmt, 0 );
-    } else {
-        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    sqlite3_finalize( stmt );
-
-    return fileCount > 0;
-}
 
-static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
+static bool read_from_db_json( save_database &db, save_table table, const tripoint &key,
+                               const std::string &path, file_read_json_fn reader, bool optional )
 {
-    std::ostringstream oss;
-    writer( oss );
-    auto data = oss.str();
-
-    std::vector<std::byte> compressedData;
-    zlib_compress( data, compressedData );
-
-    size_t basePos = path.find_last_of( "/\\" );
-    auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
-
-    auto sql = R"sql(
-        INSERT INTO files(path, parent, data, compression)
-        VALUES (:path, :parent, :data, 'zlib')
-        ON CONFLICT(path) DO UPDATE
-            SET data = excluded.data,
-                parent = excluded.parent,
-                compression = excluded.compression;
-    )sql";
-
-    sqlite3_stmt *stmt = nullptr;
-
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
-        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), parent.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
-        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), compressedData.data(),
-                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_step( stmt ) != SQLITE_DONE ) {
-        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
-    }
-    sqlite3_finalize( stmt );
-}
-
-static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
-                          bool optional )
-{
-    const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
-
-    sqlite3_stmt *stmt = nullptr;
-
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
-        // Retrieve the count result
-        const void *blobData = sqlite3_column_blob( stmt, 0 );
-        int blobSize = sqlite3_column_bytes( stmt, 0 );
-        auto compression_raw = sqlite3_column_text( stmt, 1 );
-        std::string compression = compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "";
-
-        if( blobData == nullptr ) {
-            return false; // Return an empty string if there's no data
-        }
-
-        std::string dataString;
-        if( compression.empty() ) {
-            dataString = std::string( static_cast<const char *>( blobData ), blobSize );
-        } else if( compression == "zlib" ) {
-            zlib_decompress( blobData, blobSize, dataString );
-        } else {
-            throw std::runtime_error( "Unknown compression format: " + compression );
-        }
-
-        std::istringstream stream( dataString );
-        reader( stream );
-        sqlite3_finalize( stmt );
-    } else {
-        auto err = sqlite3_errmsg( db );
-        sqlite3_finalize( stmt );
-
-        if( !optional ) {
-            dbg( DL::Error ) << "Failed to execute query: " << err << '\n';
-            throw std::runtime_error( "DB query failed" );
-        }
-        return false;
-    }
-
-    return true;
-}
-
-static bool read_from_db_json( sqlite3 *db, const std::string &path, file_read_json_fn reader,
-                               bool optional )
-{
-    return read_from_db( db, path, [&]( std::istream & fin ) {
+    return db.read( table, key, [&]( std::istream & fin ) {
         JsonIn jsin( fin, path );
         reader( jsin );
     }, optional );
@@ -409,7 +242,7 @@ world::world( WORLDINFO *info )
     }
 
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        map_db = open_db( info->folder_path() + "/map.sqlite3" );
+        map_db = std::make_unique<save_database>( info->folder_path() + "/map.sqlite3" );
     } else {
         if( !assure_dir_exist( "/maps" ) ) {
             dbg( DL::Error ) << "Unable to create or open world directory structure: " << info->folder_path();
@@ -423,13 +256,6 @@ world::~world()
         dbg( DL::Error ) << "Save transaction was not committed before world destruction";
     }
 
-    if( map_db ) {
-        sqlite3_close( map_db );
-    }
-
-    if( save_db ) {
-        sqlite3_close( save_db );
-    }
 }
 
 void world::start_save_tx()
@@ -440,13 +266,15 @@ void world::start_save_tx()
     save_tx_start_ts = std::chrono::duration_cast< std::chrono::milliseconds >(
                            std::chrono::system_clock::now().time_since_epoch()
                        ).count();
+    tx_stats = save_tx_stats();
+    save_tx_id = ++last_started_tx;
 
     if( map_db ) {
-        sqlite3_exec( map_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+        sqlite3_exec( map_db->get_db(), "BEGIN TRANSACTION", NULL, NULL, NULL );
     }
 
     if( save_db ) {
-        sqlite3_exec( save_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+        sqlite3_exec( save_db->get_db(), "BEGIN TRANSACTION", NULL, NULL, NULL );
     }
 }
 
@@ -456,13 +284,20 @@ int64_t world::commit_save_tx()
         throw std::runtime_error( "Attempted to commit a save transaction while none was in progress" );
     }
 
+    bool committed = true;
     if( map_db ) {
-        sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
+        committed &= sqlite3_exec( map_db->get_db(), "COMMIT", NULL, NULL, NULL ) == SQLITE_OK;
     }
 
     if( save_db ) {
-        sqlite3_exec( save_db, "COMMIT", NULL, NULL, NULL );
+        committed &= sqlite3_exec( save_db->get_db(), "COMMIT", NULL, NULL, NULL ) == SQLITE_OK;
+    }
+    if( committed ) {
+        last_committed_tx = save_tx_id;
+    } else {
+        dbg( DL::Error ) << "Failed to commit save transaction";
     }
+    save_tx_id = 0;
 
     int64_t now = std::chrono::duration_cast< std::chrono::milliseconds >(
                       std::chrono::system_clock::now().time_since_epoch()
@@ -472,6 +307,12 @@ int64_t world::commit_save_tx()
     return duration;
 }
 
+void world::record_write( size_t bytes ) const
+{
+    tx_stats.entries++;
+    tx_stats.bytes += bytes;
+}
+
 /**
  * DOMAIN SPECIFIC: MAP
  */
@@ -494,7 +335,7 @@ bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) c
 
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db_json( map_db, quad_path, reader, true );
+        return read_from_db_json( *map_db, save_table::map_quads, om_addr, quad_path, reader, true );
     } else {
         if( !file_exist( quad_path ) ) {
             // Fix for old saves where the path was generated using std::stringstream, which
@@ -519,7 +360,7 @@ bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) cons
 
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, quad_path, writer );
+        record_write( map_db->write( save_table::map_quads, om_addr, writer ) );
         return true;
     } else {
         assure_dir_exist( dirname );
@@ -544,7 +385,7 @@ std::string world::overmap_player_filename( const point_abs_om &p ) const
 bool world::overmap_exists( const point_abs_om &p ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return file_exist_in_db( map_db, overmap_terrain_filename( p ) );
+        return map_db->exists( save_table::overmaps, tripoint( p.raw(), 0 ) );
     } else {
         return file_exist( overmap_terrain_filename( p ) );
     }
@@ -553,7 +394,7 @@ bool world::overmap_exists( const point_abs_om &p ) const
 bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db( map_db, overmap_terrain_filename( p ), reader, true );
+        return map_db->read( save_table::overmaps, tripoint( p.raw(), 0 ), reader, true );
     } else {
         return read_from_file( overmap_terrain_filename( p ), reader, true );
     }
@@ -562,8 +403,8 @@ bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn reader )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        sqlite3 *playerdb = get_player_db();
-        return read_from_db( playerdb, overmap_player_filename( p ), reader, true );
+        return get_player_db().read( save_table::overmap_visibility, tripoint( p.raw(), 0 ), reader,
+                                     true );
     } else {
         return read_from_player_file( overmap_player_filename( p ), reader, true );
     }
@@ -572,7 +413,7 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 bool world::write_overmap( const point_abs_om &p, file_write_fn writer ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, overmap_terrain_filename( p ), writer );
+        record_write( map_db->write( save_table::overmaps, tripoint( p.raw(), 0 ), writer ) );
         return true;
     } else {
         return write_to_file( overmap_terrain_filename( p ), writer );
@@ -582,8 +423,8 @@ bool world::write_overmap( const point_abs_om &p, file_write_fn writer ) const
 bool world::write_overmap_player_visibility( const point_abs_om &p, file_write_fn writer )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, overmap_player_filename( p ), writer );
+        record_write( get_player_db().write( save_table::overmap_visibility, tripoint( p.raw(), 0 ),
+                                             writer ) );
         return true;
     } else {
         return write_to_player_file( overmap_player_filename( p ), writer );
@@ -601,8 +442,8 @@ static std::string get_mm_filename( const tripoint &p )
 bool world::read_player_mm_quad( const tripoint &p, file_read_json_fn reader )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        sqlite3 *playerdb = get_player_db();
-        return read_from_db_json( playerdb, get_mm_filename( p ), reader, true );
+        return read_from_db_json( get_player_db(), save_table::map_memory, p, get_mm_filename( p ),
+                                  reader, true );
     } else {
         return read_from_player_file_json( ".mm1/" + get_mm_filename( p ), reader, true );
     }
@@ -611,8 +452,7 @@ bool world::read_player_mm_quad( const tripoint &p, file_read_json_fn reader )
 bool world::write_player_mm_quad( const tripoint &p, file_write_fn writer )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, get_mm_filename( p ), writer );
+        record_write( get_player_db().write( save_table::map_memory, p, writer ) );
         return true;
     } else {
         const std::string descr = string_format(
@@ -633,22 +473,26 @@ std::string world::get_player_path() const
     return base64_encode( g->u.get_save_id() );
 }
 
-sqlite3 *world::get_player_db()
+save_database &world::get_player_db()
 {
     if( !save_db ) {
-        save_db = open_db( info->folder_path() + "/" + get_player_path() + ".sqlite3" );
+        save_db = std::make_unique<save_database>( info->folder_path() + "/" + get_player_path() +
+                  ".sqlite3" );
         last_save_id = g->u.get_save_id();
     }
 
     if( last_save_id != g->u.get_save_id() ) {
+        // The copy has to include what is still in the write-ahead log
+        save_db->checkpoint();
         copy_file(
             info->folder_path() + "/" + base64_encode( last_save_id ) + ".sqlite3",
             info->folder_path() + "/" + base64_encode( g->u.get_save_id() ) + ".sqlite3"
         );
-        save_db = open_db( info->folder_path() + "/" + get_player_path() + ".sqlite3" );
+        save_db = std::make_unique<save_database>( info->folder_path() + "/" + get_player_path() +
+                  ".sqlite3" );
     }
 
-    return save_db;
+    return *save_db;
 }
 
 bool world::player_file_exist( const std::string &path )
@@ -691,7 +535,12 @@ bool world::file_exist( const std::string &path ) const
 bool world::write_to_file( const std::string &path, file_write_fn writer,
                            const char *fail_message ) const
 {
-    return ::write_to_file( info->folder_path() + "/" + path, writer, fail_message );
+    return ::write_to_file( info->folder_path() + "/" + path, [&]( std::ostream & fout ) {
+        const std::streampos start = fout.tellp();
+        writer( fout );
+        const std::streamoff written = fout.tellp() - start;
+        record_write( written > 0 ? static_cast<size_t>( written ) : 0 );
+    }, fail_message );
 }
 
 bool world::read_from_file( const std::string &path, file_read_fn reader,
@@ -725,10 +574,10 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
     // The map database should already be loaded via the constructor.
     // The save database(s) will need to be created separately here.
     // Transactions are mostly being used for performance reasons rather than consistency.
-    sqlite3_exec( map_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+    sqlite3_exec( map_db->get_db(), "BEGIN TRANSACTION", NULL, NULL, NULL );
 
     // Keep track of the last used save DB
-    sqlite3 *last_save_db = nullptr;
+    std::unique_ptr<save_database> last_save_db;
     std::string last_save_id;
 
     // Begin copying files to the new world folder.
@@ -752,7 +601,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
                     continue;
                 }
                 ::read_from_file( subpath, [&]( std::istream & fin ) {
-                    write_to_db( map_db, map_path, [&]( std::ostream & fout ) {
+                    map_db->write_file( map_path, [&]( std::ostream & fout ) {
                         fout << fin.rdbuf();
                     } );
                 } );
@@ -763,7 +612,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
         // Migrate o.* files into the map database
         if( part.starts_with( "o." ) ) {
             ::read_from_file( file_path, [&]( std::istream & fin ) {
-                write_to_db( map_db, part, [&]( std::ostream & fout ) {
+                map_db->write_file( part, [&]( std::ostream & fout ) {
                     fout << fin.rdbuf();
                 } );
             } );
@@ -775,17 +624,17 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
             auto save_id = part.substr( 0, part.find( '.' ) );
             if( save_id != last_save_id ) {
                 if( last_save_db ) {
-                    sqlite3_exec( last_save_db, "COMMIT", NULL, NULL, NULL );
-                    sqlite3_close( last_save_db );
+                    sqlite3_exec( last_save_db->get_db(), "COMMIT", NULL, NULL, NULL );
                 }
-                last_save_db = open_db( info->folder_path() + "/" + save_id + ".sqlite3" );
+                last_save_db = std::make_unique<save_database>( info->folder_path() + "/" + save_id +
+                               ".sqlite3" );
                 last_save_id = save_id;
-                sqlite3_exec( last_save_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+                sqlite3_exec( last_save_db->get_db(), "BEGIN TRANSACTION", NULL, NULL, NULL );
             }
 
             if( part.find( ".seen." ) != std::string::npos ) {
                 ::read_from_file( file_path, [&]( std::istream & fin ) {
-                    write_to_db( last_save_db, part.substr( save_id.size() ), [&]( std::ostream & fout ) {
+                    last_save_db->write_file( part.substr( save_id.size() ), [&]( std::ostream & fout ) {
                         fout << fin.rdbuf();
                     } );
                 } );
@@ -799,7 +648,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
                         continue;
                     }
                     ::read_from_file( subpath, [&]( std::istream & fin ) {
-                        write_to_db( last_save_db, map_path, [&]( std::ostream & fout ) {
+                        last_save_db->write_file( map_path, [&]( std::ostream & fout ) {
                             fout << fin.rdbuf();
                         } );
                     } );
@@ -816,9 +665,8 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
     }
 
     if( last_save_db ) {
-        sqlite3_exec( last_save_db, "COMMIT", NULL, NULL, NULL );
-        sqlite3_close( last_save_db );
+        sqlite3_exec( last_save_db->get_db(), "COMMIT", NULL, NULL, NULL );
     }
 
-    sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
+    sqlite3_exec( map_db->get_db(), "COMMIT", NULL, NULL, NULL );
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 #include "json.h"
 #include "options.h"
@@ -9,7 +10,7 @@
 #include "fstream_utils.h"
 
 class avatar;
-class sqlite3;
+class save_database;
 
 class save_t
 {
@@ -103,6 +104,33 @@ class world
         int64_t commit_save_tx();
         /**@}*/
 
+        /** What the current (or last) save transaction wrote. */
+        struct save_tx_stats {
+            /** Files written, or rows written for sqlite based saves. */
+            int entries = 0;
+            /** Bytes written, after compression. */
+            size_t bytes = 0;
+        };
+        const save_tx_stats &get_save_tx_stats() const {
+            return tx_stats;
+        }
+
+        /**
+         * Id of the save transaction in progress, 0 outside of one. Writes made outside
+         * of a transaction take effect right away.
+         */
+        uint64_t current_save_tx() const {
+            return save_tx_id;
+        }
+        /**
+         * Whether data written during save transaction @p tx is in the save. False while
+         * the transaction is in progress or after it failed to commit. A later commit
+         * covers it too, as every save rewrites what isn't known to be saved.
+         */
+        bool save_tx_committed( uint64_t tx ) const {
+            return tx == 0 || tx <= last_committed_tx;
+        }
+
         /*
          * Targeted/domain-specific file operations. Different save formats may choose to
          * lay out files differently, so centralize file placement logic here rather than
@@ -166,16 +194,22 @@ class world
     private:
         /** If non-zero, indicates we're in the middle of a save event */
         int64_t save_tx_start_ts = 0;
+        mutable save_tx_stats tx_stats;
+        uint64_t save_tx_id = 0;
+        uint64_t last_started_tx = 0;
+        uint64_t last_committed_tx = 0;
+
+        void record_write( size_t bytes ) const;
 
         std::string overmap_terrain_filename( const point_abs_om &p ) const;
         std::string overmap_player_filename( const point_abs_om &p ) const;
         std::string get_player_path() const;
 
-        sqlite3 *map_db = nullptr;
+        std::unique_ptr<save_database> map_db;
 
-        sqlite3 *save_db = nullptr;
+        std::unique_ptr<save_database> save_db;
         std::string last_save_id = "";
-        sqlite3 *get_player_db();
+        save_database &get_player_db();
 };
 
 
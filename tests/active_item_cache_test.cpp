@@ -1,14 +1,18 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "game.h"
 #include "game_constants.h"
 #include "item.h"
 #include "map.h"
 #include "point.h"
+#include "safe_reference.h"
 #include "state_helpers.h"
 
 TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
@@ -50,3 +54,79 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_items_are_processed_at_their_speed", "[item]" )
+{
+    clear_all_state();
+    item &fast = *item::spawn_temporary( "firecracker_act", calendar::start_of_cataclysm,
+                                         item::default_charges_tag() );
+    item &slow = *item::spawn_temporary( "apple" );
+    REQUIRE( fast.processing_speed() == 1 );
+    const int slow_speed = slow.processing_speed();
+    REQUIRE( slow_speed > 1 );
+
+    active_item_cache cache;
+    cache.add( fast );
+    cache.add( slow );
+    // Adding twice must not produce a second reference
+    cache.add( slow );
+    REQUIRE( cache.get().size() == 2 );
+
+    const int turns = slow_speed * 3;
+    int fast_count = 0;
+    int slow_count = 0;
+    for( int i = 0; i < turns; ++i ) {
+        calendar::turn += 1_turns;
+        for( item *it : cache.get_for_processing() ) {
+            if( it == &fast ) {
+                fast_count++;
+            } else if( it == &slow ) {
+                slow_count++;
+            }
+        }
+    }
+    CHECK( fast_count == turns );
+    CHECK( slow_count == 3 );
+
+    SECTION( "items missed for a long time are processed once" ) {
+        calendar::turn += time_duration::from_turns( slow_speed * 100 );
+        std::vector<item *> due = cache.get_for_processing();
+        CHECK( std::count( due.begin(), due.end(), &slow ) == 1 );
+    }
+    SECTION( "removed items are not processed" ) {
+        cache.remove( &slow );
+        for( int i = 0; i < slow_speed; ++i ) {
+            calendar::turn += 1_turns;
+            std::vector<item *> due = cache.get_for_processing();
+            CHECK( std::find( due.begin(), due.end(), &slow ) == due.end() );
+        }
+        CHECK( cache.get().size() == 1 );
+    }
+}
+
+TEST_CASE( "timer_wheel_entries_fire_on_their_due_turn", "[item]" )
+{
+    item &it = *item::spawn_temporary( "apple" );
+    // Due turns on and next to the boundaries where upper levels cascade down
+    const int start = GENERATE( 0, 100 );
+    const int due_turn = GENERATE( item_timer_wheel::level0_size,
+                                   item_timer_wheel::level0_size * 3,
+                                   item_timer_wheel::level0_size * 3 + 1,
+                                   item_timer_wheel::span,
+                                   item_timer_wheel::span * 2 + item_timer_wheel::level0_size );
+    CAPTURE( start, due_turn );
+
+    item_timer_wheel wheel;
+    std::vector<item_timer_wheel::entry> due;
+    wheel.advance( start, due );
+    wheel.schedule( { cache_reference<item>( it ), due_turn, 1 } );
+    int fired = -1;
+    for( int turn = start + 1; turn <= due_turn + 1 && fired < 0; ++turn ) {
+        wheel.advance( turn, due );
+        if( !due.empty() ) {
+            fired = turn;
+        }
+    }
+    CHECK( fired == due_turn );
+    CHECK( wheel.size() == 0 );
+}
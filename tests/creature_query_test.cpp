@@ -0,0 +1,96 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "avatar.h"
+#include "bionics.h"
+#include "calendar.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+#include "weather.h"
+
+static const bionic_id bio_power_storage( "bio_power_storage" );
+
+static const efftype_id effect_downed( "downed" );
+static const efftype_id effect_stunned( "stunned" );
+
+static const trait_id trait_WATERSLEEP( "WATERSLEEP" );
+
+TEST_CASE( "effect_queries_follow_added_and_removed_effects", "[creature][effect]" )
+{
+    clear_all_state();
+    monster &zed = spawn_test_monster( "mon_zombie", tripoint( 60, 60, 0 ) );
+    REQUIRE_FALSE( zed.has_effect( effect_stunned ) );
+
+    zed.add_effect( effect_stunned, 5_turns );
+    CHECK( zed.has_effect( effect_stunned ) );
+    CHECK_FALSE( zed.has_effect( effect_downed ) );
+    CHECK_FALSE( zed.has_effect( efftype_id( "not_an_effect" ) ) );
+
+    const monster copy( zed );
+    CHECK( copy.has_effect( effect_stunned ) );
+
+    zed.remove_effect( effect_stunned );
+    CHECK_FALSE( zed.has_effect( effect_stunned ) );
+    zed.process_effects();
+    CHECK_FALSE( zed.has_effect( effect_stunned ) );
+
+    zed.add_effect( effect_stunned, 5_turns );
+    CHECK( zed.has_effect( effect_stunned ) );
+}
+
+TEST_CASE( "trait_and_bionic_queries_follow_changes", "[character][mutations][bionics]" )
+{
+    clear_all_state();
+    avatar &dummy = get_avatar();
+
+    REQUIRE_FALSE( dummy.has_trait( trait_WATERSLEEP ) );
+    dummy.set_mutation( trait_WATERSLEEP );
+    CHECK( dummy.has_trait( trait_WATERSLEEP ) );
+    CHECK( dummy.has_one_of_traits( { trait_id( "not_a_trait" ), trait_WATERSLEEP } ) );
+    dummy.unset_mutation( trait_WATERSLEEP );
+    CHECK_FALSE( dummy.has_trait( trait_WATERSLEEP ) );
+    CHECK_FALSE( dummy.has_one_of_traits( { trait_WATERSLEEP } ) );
+
+    REQUIRE_FALSE( dummy.has_bionic( bio_power_storage ) );
+    dummy.add_bionic( bio_power_storage );
+    CHECK( dummy.has_bionic( bio_power_storage ) );
+    dummy.remove_bionic( bio_power_storage );
+    CHECK_FALSE( dummy.has_bionic( bio_power_storage ) );
+    dummy.add_bionic( bio_power_storage );
+    dummy.my_bionics->clear();
+    CHECK_FALSE( dummy.has_bionic( bio_power_storage ) );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "creature_query_benchmark", "[.][creature][benchmark]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_grass" ) );
+    avatar &dummy = get_avatar();
+    dummy.setpos( tripoint( 60, 60, 0 ) );
+
+    std::vector<monster *> zombies;
+    for( int i = 0; i < 20; i++ ) {
+        zombies.push_back( &spawn_test_monster( "mon_zombie",
+                                                tripoint( 50 + i, 50 + i % 5, 0 ) ) );
+    }
+    get_map().build_map_cache( 0 );
+
+    BENCHMARK( "monster::plan for 20 zombies" ) {
+        for( monster *zed : zombies ) {
+            zed->plan();
+        }
+        return zombies.size();
+    };
+    BENCHMARK( "Character::update_bodytemp" ) {
+        dummy.update_bodytemp( get_map(), get_weather() );
+        return dummy.get_effect_int( effect_stunned );
+    };
+}
@@ -150,3 +150,45 @@ TEST_CASE( "tiny_character", "[encumbrance]" )
                                 add_trait( "SMALL2" ) );
     }
 }
+
+TEST_CASE( "encumbrance_is_recalculated_only_after_inputs_change", "[encumbrance]" )
+{
+    clear_all_state();
+    npc dummy;
+    dummy.worn.clear();
+    dummy.reset_encumbrance();
+    const derived_stat_counters &counters = Character::get_derived_stat_counters();
+    CHECK( dummy.encumb( body_part_torso ) == 0 );
+    const int64_t computed = counters.encumbrance_computed;
+
+    // Nothing changed, so the cached values are reused
+    CHECK( dummy.encumb( body_part_torso ) == 0 );
+    dummy.get_encumbrance();
+    CHECK( counters.encumbrance_computed == computed );
+
+    dummy.wear_item( item::spawn( "vest" ), false );
+    CHECK( dummy.encumb( body_part_torso ) == vest_e );
+    CHECK( dummy.encumb( body_part_torso ) == vest_e );
+    CHECK( counters.encumbrance_computed == computed + 1 );
+
+    dummy.set_mutation( trait_id( "SMALL2" ) );
+    CHECK( dummy.encumb( body_part_torso ) == vest_e * 2 );
+    CHECK( counters.encumbrance_computed == computed + 2 );
+}
+
+TEST_CASE( "trait_enchantments_are_kept_until_traits_change", "[encumbrance][enchantments]" )
+{
+    clear_all_state();
+    npc dummy;
+    const derived_stat_counters &counters = Character::get_derived_stat_counters();
+    dummy.recalculate_enchantment_cache();
+    const int64_t computed = counters.trait_enchantments_computed;
+
+    dummy.recalculate_enchantment_cache();
+    dummy.recalculate_enchantment_cache();
+    CHECK( counters.trait_enchantments_computed == computed );
+
+    dummy.set_mutation( trait_id( "SMALL2" ) );
+    dummy.recalculate_enchantment_cache();
+    CHECK( counters.trait_enchantments_computed == computed + 1 );
+}
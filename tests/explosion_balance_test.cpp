@@ -286,3 +286,130 @@ TEST_CASE( "rotated_vehicle_walls_block_explosions" )
     CHECK( m == &s );
     CHECK( m->get_hp() == m->get_hp_max() );
 }
+
+static explosion_data can_bomb_explosion()
+{
+    item &grenade = *item::spawn_temporary( "can_bomb_act" );
+    const auto *actor = dynamic_cast<const explosion_iuse *>
+                        ( grenade.get_use( "explosion" )->get_actor_ptr() );
+    REQUIRE( actor != nullptr );
+    return actor->explosion;
+}
+
+TEST_CASE( "simultaneous_explosions_resolve_together", "[grenade][explosion]" )
+{
+    clear_all_state();
+    put_player_underground();
+    const explosion_data data = can_bomb_explosion();
+    const tripoint first( 30, 30, 0 );
+    const tripoint second( 60, 30, 0 );
+    REQUIRE( rl_dist( first, second ) > 2 * data.safe_range() );
+
+    // One wall on each side, only the first bomb's wall shields a monster
+    for( const tripoint &pt : closest_points_first( first, 2 ) ) {
+        if( square_dist( first, pt ) > 1 ) {
+            g->m.ter_set( pt, t_wall_metal );
+        }
+    }
+    const monster &m_first = spawn_test_monster( "mon_zombie", first + point_east );
+    const monster &m_shielded = spawn_test_monster( "mon_zombie", first + point( 3, 0 ) );
+    const monster &m_second = spawn_test_monster( "mon_zombie", second + point_east );
+
+    explosion_handler::explosion_queue &queue = explosion_handler::get_explosion_queue();
+    queue.clear();
+    explosion_handler::explosion( first, data, nullptr );
+    explosion_handler::explosion( second, data, nullptr );
+    queue.execute();
+
+    CHECK( queue.get_count() == 2 );
+    CHECK( m_first.hp_percentage() < 100 );
+    CHECK( m_shielded.hp_percentage() == 100 );
+    CHECK( m_second.hp_percentage() < 100 );
+}
+
+static bool occluded( const std::vector<tripoint> &points, const tripoint &p )
+{
+    return std::find( points.begin(), points.end(), p ) != points.end();
+}
+
+// Explosions cast one field of view from their center: an obstacle shadows everything
+//   it covers, which is more than the straight lines through it
+TEST_CASE( "explosion_occlusion_is_a_field_of_view", "[explosion]" )
+{
+    clear_all_state();
+    put_player_underground();
+    map &here = get_map();
+    const tripoint center( 60, 60, 0 );
+    const int radius = 12;
+
+    SECTION( "a wall shadows the tiles behind it" ) {
+        for( int y = -3; y <= 3; y++ ) {
+            here.ter_set( center + point( 4, y ), t_wall_metal );
+        }
+        const std::vector<tripoint> points = explosion_detail::occluded_points( center,
+                                             radius );
+        CHECK( occluded( points, center + point( 6, 0 ) ) );
+        CHECK( occluded( points, center + point( 6, 3 ) ) );
+        CHECK( occluded( points, center + point( 9, -2 ) ) );
+        // The wall itself is hit
+        CHECK_FALSE( occluded( points, center + point( 4, 0 ) ) );
+        CHECK_FALSE( occluded( points, center + point( 4, 3 ) ) );
+        // Tiles in the clear
+        CHECK_FALSE( occluded( points, center + point( -6, 0 ) ) );
+        CHECK_FALSE( occluded( points, center + point( 2, 5 ) ) );
+        CHECK_FALSE( occluded( points, center + point( 4, -8 ) ) );
+    }
+
+    SECTION( "a pillar shadows a cone" ) {
+        here.ter_set( center + point( 2, 0 ), t_wall_metal );
+        const std::vector<tripoint> points = explosion_detail::occluded_points( center,
+                                             radius );
+        CHECK( occluded( points, center + point( 3, 0 ) ) );
+        CHECK( occluded( points, center + point( 10, 0 ) ) );
+        // Off the straight line, but still covered by the pillar
+        CHECK( occluded( points, center + point( 8, -1 ) ) );
+        CHECK( occluded( points, center + point( 8, 1 ) ) );
+        CHECK_FALSE( occluded( points, center + point( 8, -3 ) ) );
+        CHECK_FALSE( occluded( points, center + point( 8, 3 ) ) );
+    }
+
+    SECTION( "a rotated vehicle shadows the tiles behind it" ) {
+        const size_t in_the_open = explosion_detail::occluded_points( center, radius ).size();
+        here.add_vehicle( vproto_id( "apc" ), center + point( -6, 5 ), -45_degrees, 0, 0 );
+        here.build_map_cache( 0 );
+        CHECK( explosion_detail::occluded_points( center, radius ).size() > in_the_open );
+    }
+
+    SECTION( "nothing is reached from inside an obstacle" ) {
+        here.ter_set( center, t_wall_metal );
+        CHECK( explosion_detail::occluded_points( center, 2 ).size() == 24 );
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "explosion_chain_benchmark", "[.][explosion][benchmark]" )
+{
+    clear_all_state();
+    put_player_underground();
+    const explosion_data data = can_bomb_explosion();
+    // 20 bombs going off at once, in a cluster with some walls between them
+    std::vector<tripoint> bombs;
+    for( int i = 0; i < 20; i++ ) {
+        bombs.emplace_back( 50 + ( i % 5 ) * 3, 50 + ( i / 5 ) * 3, 0 );
+    }
+
+    explosion_handler::explosion_queue &queue = explosion_handler::get_explosion_queue();
+    BENCHMARK( "20 simultaneous explosions" ) {
+        clear_map();
+        for( int x = 48; x < 66; x += 2 ) {
+            g->m.ter_set( tripoint( x, 48, 0 ), t_wall_metal );
+            g->m.ter_set( tripoint( x, 63, 0 ), t_wall_metal );
+        }
+        queue.clear();
+        for( const tripoint &p : bombs ) {
+            explosion_handler::explosion( p, data, nullptr );
+        }
+        queue.execute();
+        return queue.get_count();
+    };
+}
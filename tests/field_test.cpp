@@ -0,0 +1,84 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "field.h"
+#include "field_type.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "submap.h"
+#include "type_id.h"
+
+static int count_fields( map &here, const field_type_id &type )
+{
+    int count = 0;
+    for( const tripoint &p : here.points_on_zlevel( 0 ) ) {
+        if( here.get_field( p, type ) != nullptr ) {
+            count++;
+        }
+    }
+    return count;
+}
+
+TEST_CASE( "field_tiles_track_fields_on_submap", "[field]" )
+{
+    clear_all_state();
+    build_test_map( t_grass );
+    map &here = get_map();
+    const tripoint pos( 30, 30, 0 );
+    point local;
+    submap *sm = here.get_submap_at( pos, local );
+    REQUIRE( sm->field_tiles.none() );
+
+    here.add_field( pos, fd_smoke, 1 );
+    CHECK( sm->field_tiles.count() == 1 );
+    CHECK( sm->field_tiles.test( local.x * SEEY + local.y ) );
+
+    here.remove_field( pos, fd_smoke );
+    here.process_fields();
+    CHECK( sm->field_tiles.none() );
+
+    SECTION( "rebuilding matches the fields present" ) {
+        here.add_field( pos, fd_smoke, 1 );
+        sm->field_tiles.reset();
+        sm->rebuild_field_tiles();
+        CHECK( sm->field_tiles.count() == 1 );
+    }
+}
+
+static void build_wooden_house( map &here, const tripoint &origin, int size )
+{
+    for( int x = 0; x < size; x++ ) {
+        for( int y = 0; y < size; y++ ) {
+            const tripoint p = origin + point( x, y );
+            const bool wall = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            here.ter_set( p, wall ? t_wall_wood : t_floor );
+            here.furn_set( p, !wall && x % 3 == 0 && y % 3 == 0 ? f_table : f_null );
+        }
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "burning_building_benchmark", "[.][field][benchmark]" )
+{
+    clear_all_state();
+    build_test_map( t_grass );
+    map &here = get_map();
+    const tripoint origin( 50, 50, 0 );
+    constexpr int size = 20;
+
+    BENCHMARK( "burn down a wooden house for 200 turns" ) {
+        clear_fields( 0 );
+        build_wooden_house( here, origin, size );
+        here.add_field( origin + point( size / 2, size / 2 ), fd_fire, 3 );
+        for( int i = 0; i < 200; i++ ) {
+            calendar::turn += 1_turns;
+            here.process_fields();
+        }
+        return count_fields( here, fd_fire );
+    };
+}
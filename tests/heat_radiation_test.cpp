@@ -0,0 +1,81 @@
+#include "catch/catch.hpp"
+
+#include "field_type.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "weather.h"
+
+TEST_CASE( "radiant_heat_reaches_visible_tiles_only", "[map][temperature]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    map &here = get_map();
+    const tripoint fire_pos( 60, 60, 0 );
+    constexpr int intensity = 2;
+    constexpr int heat = 6 * intensity * intensity;
+
+    here.add_field( fire_pos, fd_fire, intensity );
+    // Wall off everything to the west of the fire
+    for( int y = fire_pos.y - 8; y <= fire_pos.y + 8; y++ ) {
+        here.ter_set( tripoint( fire_pos.x - 2, y, 0 ), t_wall );
+    }
+    get_weather().clear_temp_cache();
+    here.build_map_cache( 0 );
+
+    CHECK( get_heat_radiation( fire_pos, false ) == heat );
+    CHECK( get_heat_radiation( fire_pos, true ) == intensity );
+    CHECK( get_heat_radiation( fire_pos + point_east, false ) == heat );
+    CHECK( get_heat_radiation( fire_pos + point( 3, 0 ), false ) == heat / 3 );
+    CHECK( get_heat_radiation( fire_pos + point( 6, 6 ), true ) == intensity );
+    CHECK( get_heat_radiation( fire_pos + point( 7, 0 ), false ) == 0 );
+    // The wall itself is lit, but nothing behind it
+    CHECK( get_heat_radiation( fire_pos + point( -2, 0 ), true ) == intensity );
+    CHECK( get_heat_radiation( fire_pos + point( -3, 0 ), false ) == 0 );
+    CHECK( get_heat_radiation( fire_pos + tripoint_above, false ) == 0 );
+
+    SECTION( "removing the fire removes its heat" ) {
+        here.remove_field( fire_pos, fd_fire );
+        CHECK( get_heat_radiation( fire_pos, false ) == 0 );
+        CHECK( get_heat_radiation( fire_pos + point_east, true ) == 0 );
+    }
+
+    SECTION( "heat from several sources adds up" ) {
+        here.add_field( fire_pos + point( 4, 0 ), fd_fire, intensity );
+        CHECK( get_heat_radiation( fire_pos + point( 2, 0 ), false ) == heat / 2 + heat / 2 );
+    }
+}
+
+TEST_CASE( "radiant_heat_of_a_hot_terrain_field_adds_up", "[map][temperature]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    map &here = get_map();
+    const tripoint center( 60, 60, 0 );
+    const ter_id lava( "t_lava" );
+    const int heat = 6 * lava->heat_radiation * lava->heat_radiation;
+    for( const tripoint &p : here.points_in_radius( center, 2 ) ) {
+        here.ter_set( p, lava );
+    }
+    get_weather().clear_temp_cache();
+    here.build_map_cache( 0 );
+
+    // Itself and 8 neighbours at distance 1, 16 tiles at distance 2
+    CHECK( get_heat_radiation( center, false ) == heat * 9 + heat / 2 * 16 );
+    CHECK( get_heat_radiation( center, true ) == lava->heat_radiation );
+
+    SECTION( "a wall next to the field still blocks" ) {
+        // Sources next to the wall are shadowcast, the others see everything in range
+        for( int y = center.y - 8; y <= center.y + 8; y++ ) {
+            here.ter_set( tripoint( center.x + 3, y, 0 ), t_wall );
+        }
+        CHECK( get_heat_radiation( center + point( 4, 0 ), false ) == 0 );
+        CHECK( get_heat_radiation( center, false ) == heat * 9 + heat / 2 * 16 );
+        CHECK( get_heat_radiation( center + point( -4, 0 ), false ) ==
+               heat / 2 * 5 + heat / 3 * 5 + heat / 4 * 5 + heat / 5 * 5 + heat / 6 * 5 );
+    }
+}
@@ -0,0 +1,117 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "avatar.h"
+#include "coordinates.h"
+#include "game_constants.h"
+#include "mongroup.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+
+// Hordes only move when near the player, so use the player's overmap
+static overmap &player_overmap()
+{
+    const tripoint_abs_sm player_sm( get_avatar().global_sm_location() );
+    return overmap_buffer.get( project_to<coords::om>( player_sm.xy() ) );
+}
+
+static void add_horde( overmap &om, const tripoint_om_sm &pos, const tripoint_om_sm &target,
+                       int interest )
+{
+    mongroup horde( GROUP_ZOMBIE, pos, 1, 10 );
+    horde.horde = true;
+    horde.horde_behaviour = "roam";
+    horde.target = target;
+    horde.interest = interest;
+    om.add_mon_group( horde );
+}
+
+static mongroup *horde_at( overmap &om, const tripoint_om_sm &pos )
+{
+    const std::vector<mongroup *> groups = overmap_buffer.groups_at( project_combine( om.pos(),
+                                           pos ) );
+    return groups.empty() ? nullptr : groups.front();
+}
+
+TEST_CASE( "hordes_react_to_signals_in_range", "[overmap][horde]" )
+{
+    clear_all_state();
+    overmap &om = player_overmap();
+    om.clear_mon_groups();
+
+    const tripoint_om_sm far_target( 0, 0, 0 );
+    const tripoint_om_sm signal( 60, 50, 0 );
+    const tripoint_om_sm same_cell( 55, 50, 0 );
+    const tripoint_om_sm other_cell( 45, 50, 0 );
+    const tripoint_om_sm out_of_range( 100, 50, 0 );
+    add_horde( om, same_cell, far_target, 0 );
+    add_horde( om, other_cell, far_target, 0 );
+    add_horde( om, out_of_range, far_target, 0 );
+
+    overmap_buffer.signal_hordes( project_combine( om.pos(), signal ), 20 );
+
+    REQUIRE( horde_at( om, same_cell ) != nullptr );
+    REQUIRE( horde_at( om, other_cell ) != nullptr );
+    REQUIRE( horde_at( om, out_of_range ) != nullptr );
+    CHECK( horde_at( om, same_cell )->target == signal );
+    CHECK( horde_at( om, other_cell )->target == signal );
+    CHECK( horde_at( om, out_of_range )->target == far_target );
+}
+
+TEST_CASE( "moving_hordes_stay_indexed", "[overmap][horde]" )
+{
+    clear_all_state();
+    overmap &om = player_overmap();
+    om.clear_mon_groups();
+
+    const tripoint_om_sm start( 70, 70, 0 );
+    const tripoint_om_sm target( 71, 70, 0 );
+    add_horde( om, start, target, 100 );
+
+    for( int i = 0; i < 1000 && horde_at( om, target ) == nullptr; i++ ) {
+        overmap_buffer.move_hordes();
+    }
+    REQUIRE( horde_at( om, target ) != nullptr );
+    CHECK( horde_at( om, start ) == nullptr );
+
+    // Signals find the horde at its new position
+    horde_at( om, target )->interest = 0;
+    const tripoint_om_sm signal( 78, 70, 0 );
+    overmap_buffer.signal_hordes( project_combine( om.pos(), signal ), 8 );
+    CHECK( horde_at( om, target )->target == signal );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "horde_simulation_benchmark", "[.][overmap][horde][benchmark]" )
+{
+    clear_all_state();
+    overmap &om = player_overmap();
+    om.clear_mon_groups();
+    rng_set_engine_seed( 4242424242 );
+
+    // A horde on every other submap of the overmap
+    for( int x = 0; x < OMAPX * 2; x += 2 ) {
+        for( int y = 0; y < OMAPY * 2; y += 2 ) {
+            const tripoint_om_sm pos( x, y, 0 );
+            add_horde( om, pos, pos + point( rng( -10, 10 ), rng( -10, 10 ) ), rng( 15, 100 ) );
+        }
+    }
+
+    BENCHMARK( "50 signals and 10 horde moves" ) {
+        for( int i = 0; i < 50; i++ ) {
+            const tripoint_om_sm signal( rng( 0, OMAPX * 2 - 1 ), rng( 0, OMAPY * 2 - 1 ), 0 );
+            overmap_buffer.signal_hordes( project_combine( om.pos(), signal ), rng( 5, 40 ) );
+        }
+        for( int i = 0; i < 10; i++ ) {
+            overmap_buffer.move_hordes();
+        }
+        return om.pos();
+    };
+}
@@ -0,0 +1,89 @@
+#include "catch/catch.hpp"
+
+#include "avatar.h"
+#include "bodypart.h"
+#include "calendar.h"
+#include "flag.h"
+#include "item.h"
+#include "state_helpers.h"
+#include "units.h"
+
+TEST_CASE( "item_mod_flags_follow_attached_and_changed_mods", "[item]" )
+{
+    detached_ptr<item> gun = item::spawn( "m1918" );
+    detached_ptr<item> mod = item::spawn( "bipod" );
+    item &bipod = *mod;
+    REQUIRE_FALSE( gun->has_flag( flag_BIPOD ) );
+    const units::mass bare_weight = gun->weight();
+
+    REQUIRE( gun->is_gunmod_compatible( bipod ).success() );
+    gun->put_in( std::move( mod ) );
+    CHECK( gun->has_flag( flag_BIPOD ) );
+    const units::mass modded_weight = gun->weight();
+    CHECK( modded_weight > bare_weight );
+
+    // Changing the attached mod reaches the gun through its location
+    bipod.set_flag( flag_REDUCED_WEIGHT );
+    CHECK( gun->has_flag( flag_REDUCED_WEIGHT ) );
+    CHECK( gun->weight() < modded_weight );
+    bipod.unset_flag( flag_REDUCED_WEIGHT );
+    CHECK_FALSE( gun->has_flag( flag_REDUCED_WEIGHT ) );
+    CHECK( gun->weight() == modded_weight );
+
+    detached_ptr<item> removed = gun->contents.remove_top( &bipod );
+    CHECK_FALSE( gun->has_flag( flag_BIPOD ) );
+    CHECK( gun->weight() == bare_weight );
+}
+
+TEST_CASE( "item_weight_and_volume_follow_charges_and_vars", "[item]" )
+{
+    detached_ptr<item> bottle = item::spawn( "bottle_plastic" );
+    const units::mass empty_weight = bottle->weight();
+    bottle->put_in( item::spawn( "water_clean", calendar::turn, 2 ) );
+    const units::mass full_weight = bottle->weight();
+    REQUIRE( full_weight > empty_weight );
+
+    item &water = bottle->contents.front();
+    const units::mass water_weight = water.weight();
+    const units::volume water_volume = water.volume();
+    water.charges = 1;
+    CHECK( water.weight() < water_weight );
+    CHECK( water.volume() < water_volume );
+    CHECK( bottle->weight() == empty_weight + water.weight() );
+
+    bottle->set_var( "weight", 1000000 );
+    CHECK( bottle->weight( false ) == 1_kilogram );
+    bottle->erase_var( "weight" );
+    CHECK( bottle->weight( false ) == empty_weight );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "item_derived_properties_benchmark", "[.][item][benchmark]" )
+{
+    clear_all_state();
+    avatar &dummy = get_avatar();
+    for( const char *armor : {
+             "jeans", "hoodie", "backpack", "duffelbag"
+         } ) {
+        dummy.wear_item( item::spawn( armor ) );
+    }
+    for( int i = 0; i < 10; i++ ) {
+        detached_ptr<item> bottle = item::spawn( "bottle_plastic" );
+        bottle->put_in( item::spawn( "water_clean", calendar::turn, 2 ) );
+        dummy.i_add( std::move( bottle ) );
+        dummy.i_add( item::spawn( "flashlight" ) );
+        dummy.i_add( item::spawn( "aspirin" ) );
+        dummy.i_add( item::spawn( "2x4" ) );
+    }
+    detached_ptr<item> gun = item::spawn( "m1918" );
+    gun->put_in( item::spawn( "bipod" ) );
+    dummy.i_add( std::move( gun ) );
+
+    BENCHMARK( "weight and volume carried" ) {
+        return dummy.weight_carried().value() + dummy.volume_carried().value();
+    };
+    BENCHMARK( "encumbrance" ) {
+        dummy.reset_encumbrance();
+        return dummy.encumb( body_part_torso );
+    };
+}
@@ -1,6 +1,7 @@
 #include "catch/catch.hpp"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "avatar.h"
@@ -9,6 +10,8 @@
 #include "game_constants.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
 #include "point.h"
 #include "state_helpers.h"
 #include "type_id.h"
@@ -144,3 +147,35 @@ TEST_CASE( "bash_through_roof_can_destroy_multiple_times" )
         }
     }
 }
+
+TEST_CASE( "precomputed_line_of_sight_matches_map_sees", "[map][vision]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    map &here = get_map();
+    const tripoint center( 60, 60, 0 );
+    for( const tripoint &p : here.points_in_radius( center, 20 ) ) {
+        if( ( p.x * 7 + p.y * 13 ) % 11 == 0 ) {
+            here.ter_set( p, t_wall );
+        }
+    }
+    here.build_map_cache( 0 );
+
+    std::vector<std::pair<tripoint, tripoint>> pairs;
+    for( const tripoint &p : here.points_in_radius( center, 20 ) ) {
+        pairs.emplace_back( center + point( p.y % 5, 0 ), p );
+    }
+    std::vector<bool> expected;
+    for( const auto &[from, to] : pairs ) {
+        expected.push_back( here.sees( from, to, -1 ) );
+    }
+
+    // Force the vision cache to be dropped, then fill it from the batch.
+    here.set_seen_cache_dirty( 0 );
+    here.build_map_cache( 0 );
+    here.precompute_sees( pairs );
+    for( size_t i = 0; i < pairs.size(); i++ ) {
+        CAPTURE( pairs[i].first, pairs[i].second );
+        CHECK( here.sees( pairs[i].first, pairs[i].second, -1 ) == expected[i] );
+    }
+}
@@ -0,0 +1,95 @@
+#include "catch/catch.hpp"
+
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "world.h"
+
+static world::save_tx_stats save_maps()
+{
+    world *w = g->get_active_world();
+    w->start_save_tx();
+    get_map().save();
+    overmap_buffer.save();
+    MAPBUFFER.save();
+    w->commit_save_tx();
+    return w->get_save_tx_stats();
+}
+
+// Drops the loaded submaps and reads the reality bubble back from the save
+static void reload_map()
+{
+    map &here = get_map();
+    MAPBUFFER.clear();
+    here.load( here.get_abs_sub(), false );
+}
+
+TEST_CASE( "changed_map_data_survives_a_reload", "[mapbuffer]" )
+{
+    clear_all_state();
+    // Map quads are not written at all while mapgen is disabled.
+    restore_on_out_of_scope<bool> restore_mapgen( disable_mapgen );
+    disable_mapgen = false;
+    build_test_map( t_floor );
+    map &here = get_map();
+    const tripoint p( 60, 60, 0 );
+    here.add_item( p, item::spawn( "rock" ) );
+
+    // The first save writes everything that was loaded.
+    save_maps();
+
+    SECTION( "a terrain change" ) {
+        here.ter_set( p + tripoint_east, t_wall );
+        const world::save_tx_stats stats = save_maps();
+        CHECK( stats.entries > 0 );
+        CHECK( stats.bytes > 0 );
+        reload_map();
+        CHECK( here.ter( p + tripoint_east ) == t_wall );
+    }
+
+    SECTION( "an item edited in place" ) {
+        REQUIRE( here.i_at( p ).size() == 1 );
+        here.i_at( p ).only_item().set_var( "edited_in_place", 1 );
+        save_maps();
+        reload_map();
+        REQUIRE( here.i_at( p ).size() == 1 );
+        CHECK( here.i_at( p ).only_item().get_var( "edited_in_place", 0.0 ) == 1.0 );
+    }
+}
+
+TEST_CASE( "only_changed_map_data_is_saved", "[mapbuffer][overmap]" )
+{
+    clear_all_state();
+    restore_on_out_of_scope<bool> restore_mapgen( disable_mapgen );
+    disable_mapgen = false;
+    build_test_map( t_floor );
+    save_maps();
+
+    SECTION( "a save without changes writes nothing" ) {
+        const world::save_tx_stats stats = save_maps();
+        CHECK( stats.entries == 0 );
+        CHECK( stats.bytes == 0 );
+    }
+
+    SECTION( "a terrain change writes only its quad" ) {
+        get_map().ter_set( tripoint( 60, 60, 0 ), t_wall );
+        CHECK( save_maps().entries == 1 );
+        CHECK( save_maps().entries == 0 );
+    }
+
+    SECTION( "an overmap note writes only the overmap view" ) {
+        const tripoint_abs_omt omt = project_to<coords::omt>( get_map().getglobal( tripoint( 60, 60,
+                                     0 ) ) );
+        overmap_buffer.add_note( omt, "note" );
+        CHECK( save_maps().entries == 1 );
+        CHECK( save_maps().entries == 0 );
+    }
+}
@@ -6,12 +6,15 @@
 #include "game.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "map_iterator.h"
 #include "mapdata.h"
 #include "monster.h"
+#include "npc.h"
 #include "options_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
 #include "state_helpers.h"
-
-struct tripoint;
+#include "type_id.h"
 
 static monster &spawn_and_clear( const tripoint &pos, bool set_floor )
 {
@@ -101,3 +104,49 @@ TEST_CASE( "monsters_dont_see_through_vehicle_holes", "[vision]" )
     CHECK( !outside.sees( inside ) );
 
 }
+
+TEST_CASE( "monster_vision_of_npcs_matches_line_of_sight", "[vision][npc]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    put_player_underground();
+    build_test_map( ter_id( "t_grass" ) );
+    map &here = get_map();
+    const tripoint target( 60, 60, 0 );
+    // A wall north of the target, with a gap right above it
+    const ter_id t_wall( "t_wall" );
+    for( int x = 48; x <= 72; x++ ) {
+        if( x != 60 ) {
+            here.ter_set( tripoint( x, 56, 0 ), t_wall );
+        }
+    }
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0 );
+
+    constexpr int range = 12;
+    int total = 0;
+    int agreeing = 0;
+    for( const tripoint &p : here.points_in_radius( target, range ) ) {
+        if( p == target || !here.is_transparent( p ) ) {
+            continue;
+        }
+        total++;
+        agreeing += here.sees_target( p, target, range ) == here.sees( p, target, range );
+    }
+    // The field of view and the lines of sight only disagree along the edges of shadows
+    CHECK( agreeing >= total * 9 / 10 );
+
+    const tripoint in_the_open( 60, 68, 0 );
+    const tripoint through_gap( 60, 50, 0 );
+    const tripoint behind_wall( 52, 50, 0 );
+    CHECK( here.sees_target( in_the_open, target, range ) );
+    CHECK( here.sees_target( through_gap, target, range ) );
+    CHECK_FALSE( here.sees_target( behind_wall, target, range ) );
+    CHECK_FALSE( here.sees_target( in_the_open + tripoint( 0, range, 0 ), target, range ) );
+
+    npc &guy = spawn_npc( target.xy(), "test_talker" );
+    REQUIRE( guy.pos() == target );
+    CHECK( spawn_test_monster( "mon_zombie", through_gap ).sees( guy ) );
+    CHECK_FALSE( spawn_test_monster( "mon_zombie", behind_wall ).sees( guy ) );
+}
+
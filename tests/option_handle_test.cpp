@@ -0,0 +1,104 @@
+#include "catch/catch.hpp"
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "options.h"
+#include "options_helpers.h"
+#include "string_utils.h"
+
+static const option_handle<bool> option_AUTOSAVE( "AUTOSAVE" );
+static const option_handle<int> option_AUTOSAVE_TURNS( "AUTOSAVE_TURNS" );
+
+TEST_CASE( "option_handles_follow_option_changes", "[options]" )
+{
+    override_option autosave( "AUTOSAVE", "false" );
+    override_option turns( "AUTOSAVE_TURNS", "10" );
+    CHECK_FALSE( option_AUTOSAVE.get() );
+    CHECK( option_AUTOSAVE_TURNS.get() == 10 );
+
+    get_options().get_option( "AUTOSAVE" ).setValue( "true" );
+    get_options().get_option( "AUTOSAVE_TURNS" ).setValue( 20 );
+    CHECK( option_AUTOSAVE.get() );
+    CHECK( option_AUTOSAVE_TURNS.get() == 20 );
+
+    get_options().get_option( "AUTOSAVE" ).setNext();
+    CHECK_FALSE( option_AUTOSAVE.get() );
+}
+
+TEST_CASE( "option_observers_run_when_value_changed", "[options]" )
+{
+    override_option turns( "AUTOSAVE_TURNS", "10" );
+    int calls = 0;
+    const int id = get_options().add_observer( "AUTOSAVE_TURNS", [&calls]() {
+        calls++;
+    } );
+    on_out_of_scope remove_observer( [id]() {
+        get_options().remove_observer( id );
+    } );
+
+    get_options().notify_observers();
+    CHECK( calls == 0 );
+
+    get_options().get_option( "AUTOSAVE_TURNS" ).setValue( 30 );
+    get_options().notify_observers();
+    CHECK( calls == 1 );
+    get_options().notify_observers();
+    CHECK( calls == 1 );
+
+    get_options().get_option( "AUTOSAVE_TURNS" ).setValue( 10 );
+    get_options().notify_observers();
+    CHECK( calls == 2 );
+
+    get_options().remove_observer( id );
+    get_options().get_option( "AUTOSAVE_TURNS" ).setValue( 30 );
+    get_options().notify_observers();
+    CHECK( calls == 2 );
+}
+
+// Functions profiled with ZoneScoped are hot, they should read options through an
+// option_handle instead of looking them up by name each time.
+// Relies on function bodies starting and ending with a brace in the first column.
+TEST_CASE( "no_option_lookups_in_profiled_functions", "[options]" )
+{
+    // Resolved from this file so the scan doesn't depend on the working directory
+    const std::string src_dir = ( std::filesystem::path( __FILE__ ).parent_path().parent_path() /
+                                  "src" ).generic_string();
+    const std::vector<std::string> sources = get_files_from_path( ".cpp", src_dir, false, true );
+    REQUIRE_FALSE( sources.empty() );
+    std::vector<std::string> offenders;
+    for( const std::string &path : sources ) {
+        std::istringstream source( read_entire_file( path ) );
+        std::string line;
+        int line_number = 0;
+        bool in_body = false;
+        bool profiled = false;
+        std::vector<std::string> lookups;
+        while( std::getline( source, line ) ) {
+            line_number++;
+            if( line == "{" ) {
+                in_body = true;
+                profiled = false;
+                lookups.clear();
+            } else if( line == "}" && in_body ) {
+                if( profiled ) {
+                    offenders.insert( offenders.end(), lookups.begin(), lookups.end() );
+                }
+                in_body = false;
+            } else if( in_body ) {
+                profiled = profiled || trim( line ).starts_with( "ZoneScoped" );
+                if( line.find( "get_option<" ) != std::string::npos ) {
+                    lookups.push_back( path + ":" + std::to_string( line_number ) + ": " + trim( line ) );
+                }
+            }
+        }
+    }
+    for( const std::string &offender : offenders ) {
+        INFO( offender );
+        FAIL_CHECK( "option looked up by name in a ZoneScoped function, use an option_handle" );
+    }
+}
@@ -0,0 +1,149 @@
+#if defined(TILES)
+
+#include "catch/catch.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "cata_tiles.h"
+#include "cata_utility.h"
+#include "game_constants.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "sdl_geometry.h"
+#include "sdl_wrappers.h"
+#include "state_helpers.h"
+#include "uistate.h"
+
+static constexpr int screen_width = 1920;
+static constexpr int screen_height = 1080;
+
+// Reveal all but the border, so drawing never looks into the neighbouring overmaps
+static overmap &reveal_test_overmap()
+{
+    overmap &om = overmap_buffer.get( point_abs_om() );
+    for( int y = 1; y < OMAPY - 1; y++ ) {
+        for( int x = 1; x < OMAPX - 1; x++ ) {
+            om.set_seen( tripoint_om_omt( x, y, 0 ), true );
+        }
+    }
+    return om;
+}
+
+// Screen contents after drawing the overmap around @p center
+static std::vector<Uint32> draw_om_pixels( cata_tiles &tiles, const SDL_Renderer_Ptr &renderer,
+        const tripoint_abs_omt &center )
+{
+    SetRenderDrawColor( renderer, 0, 0, 0, 0xFF );
+    RenderClear( renderer );
+    tiles.draw_om( point_zero, point( screen_width, screen_height ), center, false );
+    std::vector<Uint32> pixels( static_cast<size_t>( screen_width ) * screen_height );
+    REQUIRE( SDL_RenderReadPixels( renderer.get(), nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(),
+                                   screen_width * sizeof( Uint32 ) ) == 0 );
+    return pixels;
+}
+
+// Number of pixels with a color channel differing by more than rounding
+static int count_mismatched( const std::vector<Uint32> &a, const std::vector<Uint32> &b )
+{
+    int mismatched = 0;
+    for( size_t i = 0; i < a.size(); i++ ) {
+        for( const int shift : {
+                 0, 8, 16
+             } ) {
+            if( std::abs( static_cast<int>( ( a[i] >> shift ) & 0xFF ) -
+                          static_cast<int>( ( b[i] >> shift ) & 0xFF ) ) > 2 ) {
+                mismatched++;
+                break;
+            }
+        }
+    }
+    return mismatched;
+}
+
+TEST_CASE( "overmap_chunk_cache_matches_per_tile_drawing", "[overmap][sdl]" )
+{
+    clear_all_state();
+    overmap &om = reveal_test_overmap();
+    // City labels are drawn with the overmap font, which doesn't exist here
+    const bool show_city_labels = uistate.overmap_show_city_labels;
+    uistate.overmap_show_city_labels = false;
+    on_out_of_scope restore_city_labels( [show_city_labels]() {
+        uistate.overmap_show_city_labels = show_city_labels;
+    } );
+
+    const SDL_Surface_Ptr surface = CreateRGBSurface( 0, screen_width, screen_height, 32,
+                                    0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000 );
+    const SDL_Renderer_Ptr renderer( SDL_CreateSoftwareRenderer( surface.get() ) );
+    REQUIRE( renderer );
+    const GeometryRenderer_Ptr geometry = std::make_unique<DefaultGeometryRenderer>();
+    cata_tiles tiles( renderer, geometry );
+    tiles.load_tileset( "UltimateCataclysm", {} );
+    REQUIRE( tiles.get_tile_width() > 0 );
+
+    const tripoint_abs_omt center( OMAPX / 2, OMAPY / 2, 0 );
+    const auto draw = [&]( bool cached ) {
+        tiles.cache_overmap_chunks = cached;
+        return draw_om_pixels( tiles, renderer, center );
+    };
+
+    const std::vector<Uint32> per_tile = draw( false );
+    const std::vector<Uint32> cached = draw( true );
+    CHECK( count_mismatched( per_tile, cached ) == 0 );
+
+    SECTION( "after a tile is hidden" ) {
+        om.set_seen( tripoint_om_omt( OMAPX / 2 + 3, OMAPY / 2 + 2, 0 ), false );
+    }
+    SECTION( "after a tile is explored" ) {
+        om.set_explored( tripoint_om_omt( OMAPX / 2 - 4, OMAPY / 2 + 1, 0 ), true );
+    }
+    // Chunks drawn before the change must be redrawn, not reused
+    const std::vector<Uint32> cached_after = draw( true );
+    const std::vector<Uint32> per_tile_after = draw( false );
+    CHECK( count_mismatched( per_tile_after, cached_after ) == 0 );
+    CHECK( count_mismatched( cached, cached_after ) > 0 );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "overmap_chunk_cache_panning_benchmark", "[.][overmap][sdl][benchmark]" )
+{
+    clear_all_state();
+    reveal_test_overmap();
+    // City labels are drawn with the overmap font, which doesn't exist here
+    const bool show_city_labels = uistate.overmap_show_city_labels;
+    uistate.overmap_show_city_labels = false;
+
+    const SDL_Surface_Ptr surface = CreateRGBSurface( 0, screen_width, screen_height, 32,
+                                    0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000 );
+    const SDL_Renderer_Ptr renderer( SDL_CreateSoftwareRenderer( surface.get() ) );
+    REQUIRE( renderer );
+    const GeometryRenderer_Ptr geometry = std::make_unique<DefaultGeometryRenderer>();
+    cata_tiles tiles( renderer, geometry );
+    tiles.load_tileset( "UltimateCataclysm", {} );
+    REQUIRE( tiles.get_tile_width() > 0 );
+
+    // Pan one tile at a time from the west to the east edge of the overmap
+    const int half_view = screen_width / tiles.get_tile_width() / 2 + 1;
+    int x = half_view;
+    const auto pan = [&]() {
+        tiles.draw_om( point_zero, point( screen_width, screen_height ),
+                       tripoint_abs_omt( x, OMAPY / 2, 0 ), false );
+        x = x + 1 < OMAPX - half_view ? x + 1 : half_view;
+        return x;
+    };
+
+    tiles.cache_overmap_chunks = false;
+    BENCHMARK( "per tile terrain" ) {
+        return pan();
+    };
+    tiles.cache_overmap_chunks = true;
+    BENCHMARK( "cached terrain chunks" ) {
+        return pan();
+    };
+
+    uistate.overmap_show_city_labels = show_city_labels;
+}
+
+#endif // TILES
@@ -0,0 +1,80 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "character_id.h"
+#include "coordinates.h"
+#include "game.h"
+#include "game_constants.h"
+#include "memory_fast.h"
+#include "npc.h"
+#include "overmap.h"
+#include "overmap_special.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+
+static tripoint random_sm_on_overmap( const point_abs_om &om )
+{
+    const point_abs_sm origin = project_to<coords::sm>( om );
+    return tripoint( origin.x() + rng( 0, OMAPX * 2 - 1 ), origin.y() + rng( 0, OMAPY * 2 - 1 ), 0 );
+}
+
+static bool is_on_overmap( const npc &guy, const point_abs_om &om )
+{
+    const shared_ptr_fast<npc> found = overmap_buffer.get_existing( om )->find_npc( guy.getID() );
+    return found.get() == &guy;
+}
+
+TEST_CASE( "overmap_npc_index_follows_inserted_moved_and_removed_npcs", "[overmap][npc]" )
+{
+    clear_all_state();
+    rng_set_engine_seed( 1234 );
+    std::vector<point_abs_om> overmaps;
+    for( int x = -1; x <= 1; x++ ) {
+        for( int y = -1; y <= 1; y++ ) {
+            overmaps.emplace_back( x, y );
+            overmap_special_batch empty_specials( overmaps.back() );
+            overmap_buffer.create_custom_overmap( overmaps.back(), empty_specials );
+        }
+    }
+
+    std::vector<shared_ptr_fast<npc>> npcs;
+    for( int i = 0; i < 500; i++ ) {
+        shared_ptr_fast<npc> guy = make_shared_fast<npc>();
+        guy->setID( g->assign_npc_id() );
+        guy->spawn_at_sm( random_sm_on_overmap( overmaps[i % overmaps.size()] ) );
+        overmap_buffer.insert_npc( guy );
+        npcs.push_back( guy );
+    }
+    REQUIRE( overmap_buffer.get_overmap_npcs().size() == npcs.size() );
+    for( const shared_ptr_fast<npc> &guy : npcs ) {
+        CHECK( overmap_buffer.find_npc( guy->getID() ) == guy );
+    }
+
+    // Every other NPC travels to the next overmap
+    for( size_t i = 0; i < npcs.size(); i += 2 ) {
+        const point_abs_om dest = overmaps[( i + 1 ) % overmaps.size()];
+        npcs[i]->travel_overmap( random_sm_on_overmap( dest ) );
+        CHECK( overmap_buffer.find_npc( npcs[i]->getID() ) == npcs[i] );
+        CHECK( is_on_overmap( *npcs[i], dest ) );
+        CHECK_FALSE( is_on_overmap( *npcs[i], overmaps[i % overmaps.size()] ) );
+    }
+    CHECK( overmap_buffer.get_overmap_npcs().size() == npcs.size() );
+
+    // Every third NPC is removed
+    for( size_t i = 0; i < npcs.size(); i += 3 ) {
+        CHECK( overmap_buffer.remove_npc( npcs[i]->getID() ) == npcs[i] );
+        CHECK( overmap_buffer.find_npc( npcs[i]->getID() ) == nullptr );
+    }
+    for( size_t i = 0; i < npcs.size(); i++ ) {
+        if( i % 3 != 0 ) {
+            CHECK( overmap_buffer.find_npc( npcs[i]->getID() ) == npcs[i] );
+        }
+    }
+    CHECK( overmap_buffer.get_overmap_npcs().size() == npcs.size() - ( npcs.size() + 2 ) / 3 );
+
+    overmap_buffer.clear();
+    CHECK( overmap_buffer.find_npc( npcs[1]->getID() ) == nullptr );
+}
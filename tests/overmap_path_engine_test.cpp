@@ -0,0 +1,272 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "coordinates.h"
+#include "game_constants.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "overmap_path_engine.h"
+#include "overmap_special.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "rng.h"
+#include "simple_pathfinding.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+// Overmaps with an empty special batch only contain the basic terrain
+static overmap &create_overmap( const point_abs_om &p )
+{
+    overmap_special_batch empty_specials( p );
+    overmap_buffer.create_custom_overmap( p, empty_specials );
+    return *overmap_buffer.get_existing( p );
+}
+
+static bool is_contiguous( const std::vector<tripoint_abs_omt> &path )
+{
+    for( size_t i = 1; i < path.size(); i++ ) {
+        const tripoint d = ( path[i] - path[i - 1] ).raw();
+        if( std::abs( d.x ) + std::abs( d.y ) + std::abs( d.z ) != 1 ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE( "overmap_path_engine_follows_roads_across_overmaps", "[overmap][pathfinding]" )
+{
+    clear_all_state();
+    const oter_id field( "field" );
+    const oter_id road( "road_ew" );
+    const oter_id open_air( "open_air" );
+    constexpr int road_y = 50;
+    constexpr int num_overmaps = 3;
+    for( int i = 0; i < num_overmaps; i++ ) {
+        overmap &om = create_overmap( point_abs_om( i, 0 ) );
+        for( int y = 0; y < OMAPY; y++ ) {
+            for( int x = 0; x < OMAPX; x++ ) {
+                om.ter_set( tripoint_om_omt( x, y, 0 ), y == road_y ? road : field );
+                om.ter_set( tripoint_om_omt( x, y, 1 ), open_air );
+            }
+        }
+    }
+
+    overmap_path_engine &engine = overmap_buffer.get_path_engine();
+    const tripoint_abs_omt src( 5, road_y, 0 );
+    const tripoint_abs_omt dest( num_overmaps * OMAPX - 6, road_y, 0 );
+    const int graph_routes = engine.road_graph_routes;
+    std::vector<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest,
+                                         overmap_path_params::for_npc() );
+    REQUIRE( path.size() == static_cast<size_t>( dest.x() - src.x() + 1 ) );
+    CHECK( path.front() == dest );
+    CHECK( path.back() == src );
+    CHECK( is_contiguous( path ) );
+    CHECK( engine.road_graph_routes == graph_routes + 1 );
+
+    // Blocking the road invalidates the road graph, the path goes around the block
+    const tripoint_abs_omt block( OMAPX + OMAPX / 2, road_y, 0 );
+    overmap_buffer.ter_set( block, oter_id( "empty_rock" ) );
+    path = overmap_buffer.get_travel_path( src, dest, overmap_path_params::for_npc() );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.front() == dest );
+    CHECK( path.back() == src );
+    CHECK( is_contiguous( path ) );
+    CHECK( std::find( path.begin(), path.end(), block ) == path.end() );
+}
+
+// Cost of a path under the rules of pf::find_overmap_path: every cell but the ends is
+// paid for, a cell where the path turns horizontally costs 99/140 of its price.
+template<typename Scorer>
+static int path_cost( const std::vector<tripoint_abs_omt> &path, Scorer scorer )
+{
+    int total = 0;
+    for( size_t i = 1; i + 1 < path.size(); i++ ) {
+        const tripoint in = ( path[i] - path[i - 1] ).raw();
+        const tripoint out = ( path[i + 1] - path[i] ).raw();
+        const int cost = scorer( path[i] );
+        const bool turns = in != out && in.z == 0 && out.z == 0;
+        total += turns ? cost * 99 / 140 : cost;
+    }
+    return total;
+}
+
+// Path from src to dest. pf::find_overmap_path returns the cells from where its two
+// searches met to the destination, followed by those from there back to the source.
+static std::vector<tripoint_abs_omt> from_source( const std::vector<tripoint_abs_omt> &points,
+        const tripoint_abs_omt &dest )
+{
+    const auto dest_iter = std::find( points.begin(), points.end(), dest );
+    std::vector<tripoint_abs_omt> ret( std::next( dest_iter ), points.end() );
+    std::reverse( ret.begin(), ret.end() );
+    ret.insert( ret.end(), points.begin(), std::next( dest_iter ) );
+    return ret;
+}
+
+TEST_CASE( "overmap_path_engine_matches_find_overmap_path", "[overmap][pathfinding]" )
+{
+    clear_all_state();
+    // A grid of roads through fields, forest and rock
+    const oter_id field( "field" );
+    const oter_id forest( "forest" );
+    const oter_id rock( "empty_rock" );
+    const oter_id road_ew( "road_ew" );
+    const oter_id road_ns( "road_ns" );
+    const oter_id road_nesw( "road_nesw" );
+    const oter_id open_air( "open_air" );
+    constexpr int num_overmaps = 3;
+    constexpr int road_spacing = 30;
+    rng_set_engine_seed( 1234567 );
+    for( int i = 0; i < num_overmaps; i++ ) {
+        overmap &om = create_overmap( point_abs_om( i, 0 ) );
+        for( int y = 0; y < OMAPY; y++ ) {
+            for( int x = 0; x < OMAPX; x++ ) {
+                const bool road_x = x % road_spacing == road_spacing / 2;
+                const bool road_y = y % road_spacing == road_spacing / 2;
+                oter_id ter = field;
+                if( road_x && road_y ) {
+                    ter = road_nesw;
+                } else if( road_x ) {
+                    ter = road_ns;
+                } else if( road_y ) {
+                    ter = road_ew;
+                } else if( one_in( 10 ) ) {
+                    ter = rock;
+                } else if( one_in( 3 ) ) {
+                    ter = forest;
+                }
+                om.ter_set( tripoint_om_omt( x, y, 0 ), ter );
+                om.ter_set( tripoint_om_omt( x, y, 1 ), open_air );
+            }
+        }
+    }
+
+    overmap_path_params params = overmap_path_params::for_player();
+    params.only_known_by_player = false;
+    SECTION( "on open roads" ) {
+        params.avoid_danger = false;
+    }
+    SECTION( "around dangerous road tiles" ) {
+        params.avoid_danger = true;
+        for( int i = 0; i < 20; i++ ) {
+            const tripoint_abs_omt p( rng( 0, num_overmaps * OMAPX - 1 ),
+                                      rng( 0, OMAPY / road_spacing - 1 ) * road_spacing + road_spacing / 2, 0 );
+            overmap_buffer.add_note( p, "danger" );
+            overmap_buffer.mark_note_dangerous( p, 0, true );
+        }
+    }
+
+    // Scoring of the old overmapbuffer::get_travel_path, for the terrain above
+    const auto terrain_cost = [&]( const tripoint_abs_omt & p ) {
+        if( params.avoid_danger && overmap_buffer.is_marked_dangerous( p ) ) {
+            return -1;
+        }
+        const oter_id &ter = overmap_buffer.ter_existing( p );
+        if( is_ot_match( "road", ter, ot_match_type::type ) ) {
+            return params.road_cost;
+        } else if( is_ot_match( "field", ter, ot_match_type::type ) ) {
+            return params.field_cost;
+        } else if( is_ot_match( "forest", ter, ot_match_type::type ) ) {
+            return params.forest_cost;
+        } else if( is_ot_match( "open_air", ter, ot_match_type::type ) ) {
+            return params.air_cost;
+        } else if( is_ot_match( "empty_rock", ter, ot_match_type::type ) ) {
+            return -1;
+        }
+        return params.other_cost;
+    };
+    // Both searches overestimate the remaining cost by up to about a cell, so neither
+    // is exactly optimal
+    const int slack = 2 * std::max( { params.road_cost, params.field_cost, params.forest_cost } );
+
+    constexpr int radius = 4 * OMAPX;
+    overmap_path_engine &engine = overmap_buffer.get_path_engine();
+    for( int i = 0; i < 20; i++ ) {
+        const tripoint_abs_omt src( rng( 0, OMAPX - 1 ), rng( 0, OMAPY - 1 ), 0 );
+        const tripoint_abs_omt dest( rng( OMAPX, num_overmaps * OMAPX - 1 ), rng( 0, OMAPY - 1 ), 0 );
+        if( terrain_cost( src ) < 0 || terrain_cost( dest ) < 0 ) {
+            continue;
+        }
+        CAPTURE( src, dest );
+        const pf::simple_path<tripoint_abs_omt> reference = pf::find_overmap_path( src, dest, radius,
+        [&]( const tripoint_abs_omt & p ) {
+            const int cost = p == src ? 0 : terrain_cost( p );
+            return cost < 0 ? pf::omt_score::rejected : pf::omt_score( cost );
+        } );
+        engine.use_road_graph = false;
+        std::vector<tripoint_abs_omt> dense = overmap_buffer.get_travel_path( src, dest, params );
+        engine.use_road_graph = true;
+        std::vector<tripoint_abs_omt> graph = overmap_buffer.get_travel_path( src, dest, params );
+        // The reference gives up after fewer cells
+        CHECK( ( reference.points.empty() || !dense.empty() ) );
+        CHECK( dense.empty() == graph.empty() );
+        if( reference.points.empty() || dense.empty() || graph.empty() ) {
+            continue;
+        }
+        std::reverse( dense.begin(), dense.end() );
+        std::reverse( graph.begin(), graph.end() );
+        for( const std::vector<tripoint_abs_omt> *path : {
+                 &dense, &graph
+             } ) {
+            CHECK( path->front() == src );
+            CHECK( path->back() == dest );
+            CHECK( is_contiguous( *path ) );
+            CHECK( std::all_of( std::next( path->begin() ), path->end(), [&]( const tripoint_abs_omt & p ) {
+                return terrain_cost( p ) >= 0;
+            } ) );
+        }
+        const int reference_cost = path_cost( from_source( reference.points, dest ), terrain_cost );
+        const int dense_cost = path_cost( dense, terrain_cost );
+        const int graph_cost = path_cost( graph, terrain_cost );
+        CAPTURE( reference_cost, dense_cost, graph_cost );
+        CHECK( dense_cost <= reference_cost + slack );
+        CHECK( graph_cost * 100 <= ( reference_cost + slack ) * engine.road_graph_max_cost_percent );
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "overmap_travel_path_benchmark", "[.][overmap][pathfinding][benchmark]" )
+{
+    clear_all_state();
+    constexpr int num_overmaps = 4;
+    for( int x = 0; x < num_overmaps; x++ ) {
+        for( int y = 0; y < num_overmaps; y++ ) {
+            create_overmap( point_abs_om( x, y ) );
+        }
+    }
+
+    // 50 routes of 500 OMTs within the generated overmaps
+    rng_set_engine_seed( 4242424242 );
+    std::vector<std::pair<tripoint_abs_omt, tripoint_abs_omt>> routes;
+    constexpr int length = 500;
+    constexpr int size = num_overmaps * OMAPX;
+    while( routes.size() < 50 ) {
+        const tripoint_abs_omt src( rng( 0, size - 1 ), rng( 0, size - 1 ), 0 );
+        const int dx = rng( -length, length );
+        const int dy = ( one_in( 2 ) ? 1 : -1 ) * ( length - std::abs( dx ) );
+        const tripoint_abs_omt dest = src + tripoint( dx, dy, 0 );
+        if( dest.x() >= 0 && dest.y() >= 0 && dest.x() < size && dest.y() < size ) {
+            routes.emplace_back( src, dest );
+        }
+    }
+
+    overmap_path_engine &engine = overmap_buffer.get_path_engine();
+    const auto find_all = [&]() {
+        size_t found = 0;
+        for( const auto &[src, dest] : routes ) {
+            found += !overmap_buffer.get_travel_path( src, dest, overmap_path_params::for_npc() ).empty();
+        }
+        return found;
+    };
+    engine.use_road_graph = false;
+    BENCHMARK( "dense grid search" ) {
+        return find_all();
+    };
+    engine.use_road_graph = true;
+    BENCHMARK( "road graph" ) {
+        return find_all();
+    };
+}
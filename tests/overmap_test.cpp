@@ -39,6 +39,33 @@ TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
     REQUIRE( test_overmap->scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
 
+TEST_CASE( "overmap_revision_changes_with_view_and_terrain", "[overmap]" )
+{
+    clear_all_state();
+    std::unique_ptr<overmap> test_overmap = std::make_unique<overmap>( point_abs_om() );
+    std::unique_ptr<overmap> other_overmap = std::make_unique<overmap>( point_abs_om( 1, 0 ) );
+    CHECK( test_overmap->get_revision() != other_overmap->get_revision() );
+
+    const tripoint_om_omt p( 20, 30, 0 );
+    int64_t revision = test_overmap->get_revision();
+    test_overmap->set_seen( p, true );
+    CHECK( test_overmap->get_revision() != revision );
+    revision = test_overmap->get_revision();
+
+    // Writing the same state again is not a change
+    test_overmap->set_seen( p, true );
+    CHECK( test_overmap->get_revision() == revision );
+    test_overmap->set_explored( p, true );
+    CHECK( test_overmap->get_revision() != revision );
+    revision = test_overmap->get_revision();
+
+    test_overmap->ter_set( p, oter_id( "forest_thick" ) );
+    CHECK( test_overmap->get_revision() != revision );
+    revision = test_overmap->get_revision();
+    test_overmap->ter_set( p, oter_id( "forest_thick" ) );
+    CHECK( test_overmap->get_revision() == revision );
+}
+
 TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
 {
     clear_all_state();
@@ -0,0 +1,106 @@
+#include "catch/catch.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "compress.h"
+#include "save_blob_codec.h"
+#include "sqlite3.h"
+#include "string_formatter.h"
+
+// Submap-like JSON that differs between quads only in details
+static std::string fake_quad( int n )
+{
+    static const std::vector<std::string> terrain = { "t_grass", "t_dirt", "t_tree", "t_shrub" };
+    std::string quad = string_format( R"({"version":33,"coordinates":[%d,%d,0],"terrain":[)", n, n * 7 );
+    for( int i = 0; i < 144; i++ ) {
+        quad += string_format( R"("%s",)", terrain[( n * 31 + i * i ) % terrain.size()] );
+    }
+    quad += string_format( R"(],"items":[[3,4,{"typeid":"rock","charges":%d}]],"traps":[]})",
+                           n % 17 );
+    return quad;
+}
+
+static sqlite3 *open_memory_db()
+{
+    sqlite3 *db = nullptr;
+    REQUIRE( sqlite3_open( ":memory:", &db ) == SQLITE_OK );
+    REQUIRE( sqlite3_exec( db, R"sql(
+        CREATE TABLE dictionaries (
+            id             INTEGER PRIMARY KEY,
+            category       TEXT NOT NULL,
+            data           BLOB NOT NULL
+        );
+    )sql", nullptr, nullptr, nullptr ) == SQLITE_OK );
+    return db;
+}
+
+TEST_CASE( "save_blob_categories", "[save]" )
+{
+    CHECK( save_blob_category_of( "maps/0.0.0/1.2.0.map" ) == save_blob_category::submap );
+    CHECK( save_blob_category_of( "o.0.-1" ) == save_blob_category::overmap );
+    CHECK( save_blob_category_of( "12.-3.0.mmr" ) == save_blob_category::map_memory );
+    CHECK( save_blob_category_of( ".seen.0.0" ) == save_blob_category::overmap_visibility );
+    CHECK( save_blob_category_of( "master.gsav" ) == save_blob_category::other );
+}
+
+TEST_CASE( "save_blob_codec_trains_and_reuses_dictionaries", "[save]" )
+{
+    sqlite3 *db = open_memory_db();
+    std::vector<std::string> quads;
+    std::vector<std::vector<std::byte>> blobs;
+    std::vector<std::string> codecs;
+    {
+        save_blob_codec codec( db );
+        for( int i = 0; i < save_blob_codec::samples_per_dictionary * 2; i++ ) {
+            quads.push_back( fake_quad( i ) );
+            blobs.emplace_back();
+            codecs.push_back( codec.compress( save_blob_category::submap, quads.back(),
+                                              blobs.back() ) );
+        }
+    }
+    CHECK( codecs.front() == "zlib" );
+    CHECK( codecs[save_blob_codec::samples_per_dictionary - 2] == "zlib" );
+    CHECK( codecs.back() == "zlib_dict:1" );
+
+    std::vector<std::byte> plain;
+    zlib_compress( quads.back(), plain );
+    CHECK( blobs.back().size() < plain.size() );
+
+    // A new codec finds the dictionary in the database, for reading and writing
+    save_blob_codec codec( db );
+    for( size_t i = 0; i < quads.size(); i++ ) {
+        std::string data;
+        codec.decompress( codecs[i], blobs[i].data(), blobs[i].size(), data );
+        CHECK( data == quads[i] );
+    }
+    std::vector<std::byte> blob;
+    CHECK( codec.compress( save_blob_category::submap, fake_quad( 100 ), blob ) == "zlib_dict:1" );
+    // Other categories train their own
+    CHECK( codec.compress( save_blob_category::overmap, fake_quad( 100 ), blob ) == "zlib" );
+    sqlite3_close( db );
+}
+
+TEST_CASE( "save_blob_codec_reads_legacy_rows", "[save]" )
+{
+    sqlite3 *db = open_memory_db();
+    save_blob_codec codec( db );
+    const std::string quad = fake_quad( 1 );
+    std::string data;
+
+    std::vector<std::byte> blob;
+    zlib_compress( quad, blob );
+    codec.decompress( "zlib", blob.data(), blob.size(), data );
+    CHECK( data == quad );
+
+    codec.decompress( "", quad.data(), quad.size(), data );
+    CHECK( data == quad );
+
+    CHECK_THROWS_AS( codec.decompress( "lz4", quad.data(), quad.size(), data ),
+                     std::runtime_error );
+    CHECK_THROWS_AS( codec.decompress( "zlib_dict:7", blob.data(), blob.size(), data ),
+                     std::runtime_error );
+    sqlite3_close( db );
+}
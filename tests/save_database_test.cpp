@@ -0,0 +1,305 @@
+#include "catch/catch.hpp"
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "compress.h"
+#include "filesystem.h"
+#include "json.h"
+#include "path_info.h"
+#include "point.h"
+#include "profile.h"
+#include "save_database.h"
+#include "sqlite3.h"
+#include "string_formatter.h"
+
+static std::string fresh_db_path( const std::string &name )
+{
+    const std::string path = PATH_INFO::savedir() + name;
+    for( const char *suffix : {
+             "", "-wal", "-shm"
+         } ) {
+        remove_file( path + suffix );
+    }
+    return path;
+}
+
+static std::string quad_json( const tripoint &p )
+{
+    return string_format( R"({"coordinates":[%d,%d,%d],"terrain":["t_grass",144]})", p.x, p.y, p.z );
+}
+
+static std::string read_string( save_database &db, save_table table, const tripoint &key )
+{
+    std::string out;
+    db.read( table, key, [&]( std::istream & fin ) {
+        std::getline( fin, out );
+    } );
+    return out;
+}
+
+static int user_version( sqlite3 *db )
+{
+    sqlite3_stmt *stmt = nullptr;
+    REQUIRE( sqlite3_prepare_v2( db, "PRAGMA user_version", -1, &stmt, nullptr ) == SQLITE_OK );
+    REQUIRE( sqlite3_step( stmt ) == SQLITE_ROW );
+    const int version = sqlite3_column_int( stmt, 0 );
+    sqlite3_finalize( stmt );
+    return version;
+}
+
+static int count_rows( sqlite3 *db, const std::string &table )
+{
+    sqlite3_stmt *stmt = nullptr;
+    REQUIRE( sqlite3_prepare_v2( db, ( "SELECT COUNT(*) FROM " + table ).c_str(), -1, &stmt,
+                                 nullptr ) == SQLITE_OK );
+    REQUIRE( sqlite3_step( stmt ) == SQLITE_ROW );
+    const int count = sqlite3_column_int( stmt, 0 );
+    sqlite3_finalize( stmt );
+    return count;
+}
+
+// Creates a schema version 2 database holding files, after running extra_sql on it
+static void create_v2_db( const std::string &path,
+                          const std::vector<std::pair<std::string, std::string>> &files,
+                          const char *extra_sql = "" )
+{
+    sqlite3 *db = nullptr;
+    REQUIRE( sqlite3_open( path.c_str(), &db ) == SQLITE_OK );
+    REQUIRE( sqlite3_exec( db, R"sql(
+        CREATE TABLE files (
+            path           TEXT PRIMARY KEY NOT NULL,
+            parent         TEXT NOT NULL,
+            compression    TEXT DEFAULT NULL,
+            data           BLOB NOT NULL
+        );
+    )sql", nullptr, nullptr, nullptr ) == SQLITE_OK );
+    REQUIRE( sqlite3_exec( db, extra_sql, nullptr, nullptr, nullptr ) == SQLITE_OK );
+    for( const auto &[file, contents] : files ) {
+        std::vector<std::byte> blob;
+        zlib_compress( contents, blob );
+        sqlite3_stmt *stmt = nullptr;
+        REQUIRE( sqlite3_prepare_v2( db,
+                                     "INSERT INTO files VALUES (?1, '', 'zlib', ?2)", -1, &stmt, nullptr ) == SQLITE_OK );
+        sqlite3_bind_text( stmt, 1, file.c_str(), -1, SQLITE_TRANSIENT );
+        sqlite3_bind_blob( stmt, 2, blob.data(), blob.size(), SQLITE_TRANSIENT );
+        REQUIRE( sqlite3_step( stmt ) == SQLITE_DONE );
+        sqlite3_finalize( stmt );
+    }
+    sqlite3_close( db );
+}
+
+TEST_CASE( "save_database_reads_and_writes_typed_tables", "[save]" )
+{
+    save_database db( fresh_db_path( "typed_tables.sqlite3" ) );
+    const tripoint quad( 12, -7, 0 );
+    CHECK_FALSE( db.exists( save_table::map_quads, quad ) );
+    CHECK_FALSE( db.read( save_table::map_quads, quad, []( std::istream & ) {} ) );
+
+    db.write( save_table::map_quads, quad, [&]( std::ostream & fout ) {
+        fout << quad_json( quad );
+    } );
+    CHECK( db.exists( save_table::map_quads, quad ) );
+    CHECK_FALSE( db.exists( save_table::map_quads, quad + tripoint_above ) );
+    CHECK( read_string( db, save_table::map_quads, quad ) == quad_json( quad ) );
+
+    // Overwrites replace the row, tables don't share keys
+    db.write( save_table::map_quads, quad, []( std::ostream & fout ) {
+        fout << "replaced";
+    } );
+    CHECK( read_string( db, save_table::map_quads, quad ) == "replaced" );
+    CHECK_FALSE( db.exists( save_table::map_memory, quad ) );
+
+    // Overmaps are keyed by (x, y) only
+    db.write( save_table::overmaps, tripoint( 1, 2, 0 ), []( std::ostream & fout ) {
+        fout << "overmap";
+    } );
+    CHECK( read_string( db, save_table::overmaps, tripoint( 1, 2, 5 ) ) == "overmap" );
+    CHECK( user_version( db.get_db() ) == save_database::schema_version );
+}
+
+TEST_CASE( "save_database_migrates_v2_files_table", "[save]" )
+{
+    const std::string path = fresh_db_path( "v2_migration.sqlite3" );
+    const std::vector<std::pair<std::string, std::string>> files = {
+        { "maps/0.0.0/3.-4.0.map", "quad" },
+        { "o.1.-2", "overmap" },
+        { "5.6.-1.mmr", "memory" },
+        { ".seen.0.0", "seen" },
+        { "maps/0.0.0/notes.txt", "other" },
+    };
+    create_v2_db( path, files );
+
+    save_database db( path );
+    CHECK( user_version( db.get_db() ) == save_database::schema_version );
+    CHECK( read_string( db, save_table::map_quads, tripoint( 3, -4, 0 ) ) == "quad" );
+    CHECK( read_string( db, save_table::overmaps, tripoint( 1, -2, 0 ) ) == "overmap" );
+    CHECK( read_string( db, save_table::map_memory, tripoint( 5, 6, -1 ) ) == "memory" );
+    CHECK( read_string( db, save_table::overmap_visibility, tripoint_zero ) == "seen" );
+
+    // Only rows without a typed table remain
+    sqlite3_stmt *stmt = nullptr;
+    REQUIRE( sqlite3_prepare_v2( db.get_db(), "SELECT path FROM files", -1, &stmt,
+                                 nullptr ) == SQLITE_OK );
+    REQUIRE( sqlite3_step( stmt ) == SQLITE_ROW );
+    CHECK( std::string( reinterpret_cast<const char *>( sqlite3_column_text( stmt, 0 ) ) ) ==
+           "maps/0.0.0/notes.txt" );
+    CHECK( sqlite3_step( stmt ) == SQLITE_DONE );
+    sqlite3_finalize( stmt );
+}
+
+TEST_CASE( "save_database_migration_keeps_v2_rows_on_failure", "[save]" )
+{
+    const std::string path = fresh_db_path( "v2_failed_migration.sqlite3" );
+    // The overmap can't be inserted into this table
+    create_v2_db( path, {
+        { "maps/0.0.0/3.-4.0.map", "quad" },
+        { "o.1.-2", "overmap" },
+    }, R"sql(
+        CREATE TABLE overmaps (
+            x              INTEGER NOT NULL CHECK (x <> 1),
+            y              INTEGER NOT NULL,
+            compression    TEXT DEFAULT NULL,
+            data           BLOB NOT NULL,
+            PRIMARY KEY (x, y)
+        );
+    )sql" );
+
+    CHECK_THROWS( save_database( path ) );
+
+    sqlite3 *db = nullptr;
+    REQUIRE( sqlite3_open( path.c_str(), &db ) == SQLITE_OK );
+    CHECK( user_version( db ) == 0 );
+    CHECK( count_rows( db, "files" ) == 2 );
+    CHECK( count_rows( db, "map_quads" ) == 0 );
+    sqlite3_close( db );
+}
+
+static constexpr int large_blob_entries = 100000;
+
+struct large_blob_result {
+    size_t stored = 0;
+    int read = 0;
+    bool in_order = true;
+};
+
+// Writes a blob of several MiB as JSON and reads it back
+static large_blob_result round_trip_large_blob( const std::string &db_name )
+{
+    save_database db( fresh_db_path( db_name ) );
+    const tripoint key( 4, 2, 0 );
+    const std::string filler( 48, 'x' );
+
+    large_blob_result result;
+    result.stored = db.write( save_table::overmaps, key, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_array();
+        for( int i = 0; i < large_blob_entries; i++ ) {
+            jsout.start_object();
+            jsout.member( "id", i );
+            jsout.member( "filler", filler );
+            jsout.end_object();
+        }
+        jsout.end_array();
+    } );
+    db.read( save_table::overmaps, key, [&]( std::istream & fin ) {
+        // JsonObject seeks back over its members, the stream has to support that
+        JsonIn jsin( fin );
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            JsonObject jo = jsin.get_object();
+            result.in_order &= jo.get_int( "id" ) == result.read &&
+                               jo.get_string( "filler" ) == filler;
+            result.read++;
+        }
+    } );
+    return result;
+}
+
+TEST_CASE( "save_database_streams_large_blobs", "[save]" )
+{
+    const large_blob_result result = round_trip_large_blob( "streamed_blobs.sqlite3" );
+
+    CHECK( result.read == large_blob_entries );
+    CHECK( result.in_order );
+    CHECK( result.stored < static_cast<size_t>( large_blob_entries ) * 10 );
+}
+
+// Needs a build with COUNT_ALLOCATIONS, which replaces the global operator new to count them
+TEST_CASE( "save_database_streams_large_blobs_in_bounded_memory", "[.][save][allocations]" )
+{
+    REQUIRE( cata::profile::counts_allocations() );
+
+    cata::profile::reset();
+    cata::profile::collecting = true;
+    const large_blob_result result = round_trip_large_blob( "streamed_blobs_allocations.sqlite3" );
+    cata::profile::collecting = false;
+
+    CHECK( result.read == large_blob_entries );
+    // The blob is several MiB uncompressed, neither side may buffer all of it
+    CHECK( cata::profile::largest_allocation() <= 256 * 1024 );
+}
+
+TEST_CASE( "save_database_stream_errors_are_thrown", "[save]" )
+{
+    save_database db( fresh_db_path( "corrupt_blob.sqlite3" ) );
+    const tripoint key( 4, 2, 0 );
+    db.write( save_table::overmaps, key, []( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_array();
+        for( int i = 0; i < 20000; i++ ) {
+            jsout.write( string_format( "entry %d", i ) );
+        }
+        jsout.end_array();
+    } );
+
+    // Break the first deflate block, the block index at the end stays valid
+    sqlite3_blob *blob = nullptr;
+    REQUIRE( sqlite3_blob_open( db.get_db(), "main", "overmaps", "data", 1, 1,
+                                &blob ) == SQLITE_OK );
+    REQUIRE( sqlite3_blob_bytes( blob ) > save_database::inline_read_size );
+    const std::vector<unsigned char> garbage( 16, 0xff );
+    REQUIRE( sqlite3_blob_write( blob, garbage.data(), garbage.size(), 0 ) == SQLITE_OK );
+    sqlite3_blob_close( blob );
+
+    CHECK_THROWS_WITH( db.read( save_table::overmaps, key, []( std::istream & fin ) {
+        JsonIn jsin( fin );
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.skip_value();
+        }
+    } ), "Zlib decompression failed" );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "save_database_quad_load_benchmark", "[.][save][benchmark]" )
+{
+    save_database db( fresh_db_path( "quad_benchmark.sqlite3" ) );
+    std::vector<tripoint> quads;
+    for( int x = 0; x < 100; x++ ) {
+        for( int y = 0; y < 100; y++ ) {
+            quads.emplace_back( x, y, 0 );
+        }
+    }
+    sqlite3_exec( db.get_db(), "BEGIN TRANSACTION", nullptr, nullptr, nullptr );
+    for( const tripoint &p : quads ) {
+        db.write( save_table::map_quads, p, [&]( std::ostream & fout ) {
+            fout << quad_json( p );
+        } );
+    }
+    sqlite3_exec( db.get_db(), "COMMIT", nullptr, nullptr, nullptr );
+
+    BENCHMARK( "load 10000 quads by coordinate" ) {
+        size_t bytes = 0;
+        for( const tripoint &p : quads ) {
+            db.read( save_table::map_quads, p, [&]( std::istream & fin ) {
+                bytes += fin.rdbuf()->in_avail();
+            } );
+        }
+        return bytes;
+    };
+}
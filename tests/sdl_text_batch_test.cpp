@@ -0,0 +1,177 @@
+#if defined(TILES)
+
+#include "catch/catch.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "cata_utility.h"
+#include "path_info.h"
+#include "point.h"
+#include "sdl_font.h"
+#include "sdl_geometry.h"
+#include "sdl_text_batch.h"
+#include "sdl_wrappers.h"
+#include "sdltiles.h"
+
+static constexpr int screen_width = 1920;
+static constexpr int screen_height = 1080;
+static constexpr int font_width = 8;
+static constexpr int font_height = 16;
+
+static const std::vector<std::string> sample_glyphs = {
+    "a", "b", "c", "x", "y", "z", "#", "@", ".", ",", "%", "&", "1", "2", "3", "~"
+};
+
+namespace
+{
+// Software renderer drawing into a full HD surface, no window needed
+struct headless_renderer {
+    SDL_Surface_Ptr surface;
+    SDL_Renderer_Ptr renderer;
+
+    headless_renderer() {
+        if( TTF_WasInit() == 0 ) {
+            TTF_Init();
+        }
+        surface = CreateRGBSurface( 0, screen_width, screen_height, 32, 0x00ff0000, 0x0000ff00,
+                                    0x000000ff, 0xff000000 );
+        renderer.reset( SDL_CreateSoftwareRenderer( surface.get() ) );
+    }
+};
+} // namespace
+
+static std::string test_typeface()
+{
+    return PATH_INFO::fontdir() + "Terminus.ttf";
+}
+
+// Glyph textures of the per cell path are colored through the global palette
+static void set_test_palette()
+{
+    for( size_t i = 0; i < windowsPalette.size(); i++ ) {
+        const int c = static_cast<int>( i ) * 16 % 256;
+        windowsPalette[i] = SDL_Color{ static_cast<Uint8>( c ), static_cast<Uint8>( 255 - c ),
+                                       static_cast<Uint8>( c / 2 + 64 ), 0xFF };
+    }
+}
+
+template<typename Draw>
+static void draw_screen( Draw draw, int columns = screen_width / font_width,
+                         int rows = screen_height / font_height )
+{
+    for( int y = 0; y < rows; y++ ) {
+        for( int x = 0; x < columns; x++ ) {
+            const std::string &ch = sample_glyphs[( x + y ) % sample_glyphs.size()];
+            draw( ch, point( x * font_width, y * font_height ), static_cast<unsigned char>( ( x + y ) % 16 ) );
+        }
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "batched_text_rendering_benchmark", "[.][sdl][benchmark]" )
+{
+    headless_renderer headless;
+    REQUIRE( headless.renderer );
+    restore_on_out_of_scope<palette_array> restore_palette( windowsPalette );
+    set_test_palette();
+    CachedTTFFont font( font_width, font_height, windowsPalette, test_typeface(), font_height, true );
+    const GeometryRenderer_Ptr geometry = std::make_unique<DefaultGeometryRenderer>();
+    TextBatchRenderer batch;
+
+    BENCHMARK( "per cell OutputChar" ) {
+        draw_screen( [&]( const std::string & ch, point p, unsigned char color ) {
+            geometry->rect( headless.renderer, p, font_width, font_height, windowsPalette[0] );
+            font.OutputChar( headless.renderer, geometry, ch, p, color );
+        } );
+        return headless.surface->w;
+    };
+
+    if( !batch.begin( headless.renderer, font ) ) {
+        WARN( "SDL is too old for batched text rendering" );
+        return;
+    }
+    BENCHMARK( "batched glyph atlas" ) {
+        batch.begin( headless.renderer, font );
+        draw_screen( [&]( const std::string & ch, point p, unsigned char color ) {
+            batch.rect( headless.renderer, p, font_width, font_height, windowsPalette[0] );
+            batch.glyph( headless.renderer, ch, p, windowsPalette[color] );
+        } );
+        batch.flush( headless.renderer );
+        return batch.get_flush_count();
+    };
+}
+
+static std::vector<Uint32> read_pixels( const SDL_Renderer_Ptr &renderer, const SDL_Rect &area )
+{
+    std::vector<Uint32> pixels( static_cast<size_t>( area.w ) * area.h );
+    REQUIRE( SDL_RenderReadPixels( renderer.get(), &area, SDL_PIXELFORMAT_ARGB8888, pixels.data(),
+                                   area.w * sizeof( Uint32 ) ) == 0 );
+    return pixels;
+}
+
+TEST_CASE( "batched_text_matches_per_cell_output", "[sdl]" )
+{
+    static constexpr int columns = 40;
+    static constexpr int rows = 12;
+    const SDL_Rect area{ 0, 0, columns * font_width, rows * font_height };
+
+    headless_renderer headless;
+    REQUIRE( headless.renderer );
+    restore_on_out_of_scope<palette_array> restore_palette( windowsPalette );
+    set_test_palette();
+    CachedTTFFont font( font_width, font_height, windowsPalette, test_typeface(), font_height, true );
+    const GeometryRenderer_Ptr geometry = std::make_unique<DefaultGeometryRenderer>();
+    TextBatchRenderer batch;
+    if( !batch.begin( headless.renderer, font ) ) {
+        WARN( "SDL is too old for batched text rendering" );
+        return;
+    }
+
+    const auto clear = [&]() {
+        SetRenderDrawColor( headless.renderer, 0, 0, 0, 0xFF );
+        RenderClear( headless.renderer );
+    };
+    // Background colors differ from the glyph colors in every cell
+    const auto background = []( unsigned char color ) {
+        return windowsPalette[( color + 5 ) % 16];
+    };
+
+    clear();
+    draw_screen( [&]( const std::string & ch, point p, unsigned char color ) {
+        geometry->rect( headless.renderer, p, font_width, font_height, background( color ) );
+        font.OutputChar( headless.renderer, geometry, ch, p, color );
+    }, columns, rows );
+    const std::vector<Uint32> expected = read_pixels( headless.renderer, area );
+
+    clear();
+    batch.begin( headless.renderer, font );
+    bool all_batched = true;
+    draw_screen( [&]( const std::string & ch, point p, unsigned char color ) {
+        batch.rect( headless.renderer, p, font_width, font_height, background( color ) );
+        all_batched &= batch.glyph( headless.renderer, ch, p, windowsPalette[color] );
+    }, columns, rows );
+    batch.flush( headless.renderer );
+    const std::vector<Uint32> actual = read_pixels( headless.renderer, area );
+
+    CHECK( all_batched );
+    CHECK( batch.get_flush_count() == 1 );
+    // Allow rounding differences of the color modulation, nothing more
+    int mismatched = 0;
+    for( size_t i = 0; i < expected.size(); i++ ) {
+        for( const int shift : {
+                 0, 8, 16
+             } ) {
+            const int e = ( expected[i] >> shift ) & 0xFF;
+            const int a = ( actual[i] >> shift ) & 0xFF;
+            if( std::abs( e - a ) > 2 ) {
+                mismatched++;
+                break;
+            }
+        }
+    }
+    CHECK( mismatched == 0 );
+}
+
+#endif // TILES
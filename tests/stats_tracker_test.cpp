@@ -77,6 +77,36 @@ TEST_CASE( "stats_tracker_total_events", "[stats]" )
     CHECK( s.get_events( event_type::character_takes_damage ).total( "damage", damage_to_any ) == 35 );
 }
 
+TEST_CASE( "event_multiset_indices_survive_copies", "[stats]" )
+{
+    const character_id u_id = g->u.getID();
+    character_id other_id = u_id;
+    ++other_id;
+    constexpr event_type ctd = event_type::character_takes_damage;
+    const cata::event::data_type damage_to_u{ { "character", cata_variant( u_id ) } };
+
+    event_multiset original( ctd );
+    original.add( cata::event::make<ctd>( u_id, 10 ) );
+    original.add( cata::event::make<ctd>( other_id, -3 ) );
+    // Builds the index on "character"
+    CHECK( original.count( damage_to_u ) == 1 );
+
+    event_multiset copy = original;
+    original.add( cata::event::make<ctd>( u_id, 7 ) );
+    copy.add( cata::event::make<ctd>( u_id, 4 ) );
+    copy.add( cata::event::make<ctd>( u_id, 4 ) );
+
+    CHECK( original.count( damage_to_u ) == 2 );
+    CHECK( original.total( "damage", damage_to_u ) == 17 );
+    CHECK( original.total( "damage" ) == 14 );
+    CHECK( original.maximum( "damage" ) == 10 );
+    CHECK( original.minimum( "damage" ) == -3 );
+    CHECK( copy.count( damage_to_u ) == 3 );
+    CHECK( copy.total( "damage", damage_to_u ) == 18 );
+    CHECK( copy.count() == 4 );
+    CHECK( copy.count( { { "character", cata_variant( u_id ) }, { "damage", cata_variant( 3 ) } } ) == 0 );
+}
+
 TEST_CASE( "stats_tracker_minimum_events", "[stats]" )
 {
     stats_tracker s;
@@ -0,0 +1,90 @@
+#if defined(TILES)
+
+#include "catch/catch.hpp"
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_tiles.h"
+#include "enums.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "point.h"
+#include "sdl_geometry.h"
+#include "sdl_wrappers.h"
+#include "state_helpers.h"
+
+static constexpr int screen_width = 1280;
+static constexpr int screen_height = 720;
+
+// Screen contents after drawing the map around the player
+static std::vector<Uint32> draw_map_pixels( cata_tiles &tiles, const SDL_Renderer_Ptr &renderer )
+{
+    SetRenderDrawColor( renderer, 0, 0, 0, 0xFF );
+    RenderClear( renderer );
+    std::multimap<point, formatted_text> overlay_strings;
+    color_block_overlay_container color_blocks;
+    tiles.draw( point_zero, get_avatar().pos(), screen_width, screen_height, overlay_strings,
+                color_blocks );
+    std::vector<Uint32> pixels( static_cast<size_t>( screen_width ) * screen_height );
+    REQUIRE( SDL_RenderReadPixels( renderer.get(), nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(),
+                                   screen_width * sizeof( Uint32 ) ) == 0 );
+    return pixels;
+}
+
+// Number of pixels with a color channel differing by more than rounding
+static int count_mismatched( const std::vector<Uint32> &a, const std::vector<Uint32> &b )
+{
+    int mismatched = 0;
+    for( size_t i = 0; i < a.size(); i++ ) {
+        for( const int shift : {
+                 0, 8, 16
+             } ) {
+            if( std::abs( static_cast<int>( ( a[i] >> shift ) & 0xFF ) -
+                          static_cast<int>( ( b[i] >> shift ) & 0xFF ) ) > 2 ) {
+                mismatched++;
+                break;
+            }
+        }
+    }
+    return mismatched;
+}
+
+TEST_CASE( "terrain_view_cache_keeps_vision_effects", "[map][sdl]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    // At night most of the view is drawn with lighting sprites over it
+    set_time( calendar::turn_zero );
+    map &here = get_map();
+    here.update_visibility_cache( get_avatar().posz() );
+    const tripoint far_away = get_avatar().pos() + point( 15, 0 );
+    REQUIRE( here.get_visibility( here.access_cache( far_away.z ).visibility_cache[far_away.x][far_away.y],
+                                  here.get_visibility_variables_cache() ) != VIS_CLEAR );
+
+    const SDL_Surface_Ptr surface = CreateRGBSurface( 0, screen_width, screen_height, 32,
+                                    0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000 );
+    const SDL_Renderer_Ptr renderer( SDL_CreateSoftwareRenderer( surface.get() ) );
+    REQUIRE( renderer );
+    REQUIRE( SDL_RenderTargetSupported( renderer.get() ) );
+    const GeometryRenderer_Ptr geometry = std::make_unique<DefaultGeometryRenderer>();
+    cata_tiles tiles( renderer, geometry );
+    tiles.load_tileset( "UltimateCataclysm", {} );
+    REQUIRE( tiles.get_tile_width() > 0 );
+
+    tiles.cache_terrain_view = false;
+    const std::vector<Uint32> direct = draw_map_pixels( tiles, renderer );
+    tiles.cache_terrain_view = true;
+    const std::vector<Uint32> cached = draw_map_pixels( tiles, renderer );
+    // The second frame is copied from the cached texture without drawing the map
+    const std::vector<Uint32> reused = draw_map_pixels( tiles, renderer );
+    CHECK( count_mismatched( direct, cached ) == 0 );
+    CHECK( count_mismatched( direct, reused ) == 0 );
+}
+
+#endif // TILES
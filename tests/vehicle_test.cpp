@@ -1,7 +1,10 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
+#include <set>
+#include <string>
 #include <vector>
 
 #include "avatar.h"
@@ -11,12 +14,16 @@
 #include "item.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "map_iterator.h"
+#include "npc.h"
+#include "player_helpers.h"
 #include "point.h"
 #include "state_helpers.h"
 #include "type_id.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
 #include "vpart_position.h"
+#include "vpart_range.h"
 #include "veh_type.h"
 
 TEST_CASE( "detaching_vehicle_unboards_passengers" )
@@ -117,6 +124,25 @@ TEST_CASE( "damage_vehicle_oob" )
     }
 }
 
+TEST_CASE( "cached_parts_at_relative_matches_uncached" )
+{
+    clear_all_state();
+    const tripoint vehicle_origin( 60, 60, 0 );
+    vehicle *veh_ptr = get_map().add_vehicle( vproto_id( "car" ), vehicle_origin, 0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+
+    for( const vpart_reference &vp : veh_ptr->get_all_parts() ) {
+        std::vector<int> cached = veh_ptr->parts_at_relative( vp.mount(), true );
+        std::vector<int> uncached = veh_ptr->parts_at_relative( vp.mount(), false );
+        std::sort( cached.begin(), cached.end() );
+        std::sort( uncached.begin(), uncached.end() );
+        CHECK( cached == uncached );
+        CHECK( veh_ptr->parts_at_relative_view( vp.mount() ).size() == cached.size() );
+    }
+    CHECK( veh_ptr->parts_at_relative( point( 100, 100 ), true ).empty() );
+    CHECK( veh_ptr->parts_at_relative_view( point( -100, 100 ) ).empty() );
+}
+
 static void check_wreckage( int zlevel )
 {
     const tripoint test_origin( 60, 60, zlevel );
@@ -201,3 +227,73 @@ TEST_CASE( "vehicle_rotation_reverse" )
         }
     }
 }
+
+// What vehicle::collision would find without its broadphase: the narrowphase of every part
+static bool exhaustive_collision( vehicle &veh, const tripoint &dp )
+{
+    for( const vpart_reference &vp : veh.get_all_parts() ) {
+        const vpart_info &info = vp.info();
+        if( ( info.location != "structure" && !info.has_flag( VPFLAG_EXTENDABLE ) &&
+              info.rotor_diameter() == 0 ) || vp.part().removed ) {
+            continue;
+        }
+        const tripoint dsp = veh.global_pos3() + dp + vp.part().precalc[1];
+        if( veh.part_collision( vp.part_index(), dsp, true, false ).type != veh_coll_nothing ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE( "vehicle_collision_broadphase_matches_exhaustive" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint vehicle_origin( 60, 60, 0 );
+    get_avatar().setpos( vehicle_origin + tripoint( 20, 20, 0 ) );
+    vehicle *veh_ptr = here.add_vehicle( vproto_id( "car" ), vehicle_origin, 0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+    veh.precalc_mounts( 1, veh.face.dir(), veh.pivot_point() );
+
+    // Every tile next to the vehicle, where one step in some direction collides
+    std::set<tripoint> ring;
+    const std::set<tripoint> &occupied = veh.get_points( true );
+    for( const tripoint &p : occupied ) {
+        for( const tripoint &q : here.points_in_radius( p, 1 ) ) {
+            if( !occupied.contains( q ) ) {
+                ring.insert( q );
+            }
+        }
+    }
+    npc &guy = spawn_npc( vehicle_origin.xy() + point( 20, 0 ), "test_talker" );
+    const tripoint guy_away = guy.pos();
+
+    const auto check_all_directions = [&]( const std::string & obstacle, const tripoint & p ) {
+        for( const tripoint &dp : eight_horizontal_neighbors ) {
+            std::vector<veh_collision> colls;
+            const bool expected = exhaustive_collision( veh, dp );
+            CAPTURE( obstacle, p, dp );
+            CHECK( veh.collision( colls, dp, true ) == expected );
+        }
+    };
+
+    check_all_directions( "nothing", tripoint_zero );
+    for( const tripoint &p : ring ) {
+        here.ter_set( p, ter_id( "t_wall" ) );
+        check_all_directions( "wall", p );
+        here.ter_set( p, ter_id( "t_floor" ) );
+
+        here.furn_set( p, furn_id( "f_rubble" ) );
+        check_all_directions( "rubble", p );
+        here.furn_set( p, furn_id( "f_null" ) );
+
+        guy.setpos( p );
+        check_all_directions( "npc", p );
+        guy.setpos( guy_away );
+
+        spawn_test_monster( "mon_zombie", p );
+        check_all_directions( "monster", p );
+        clear_creatures();
+    }
+}
@@ -19,6 +19,7 @@
 #include "lightmap.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "monster.h"
 #include "player_helpers.h"
 #include "point.h"
 #include "shadowcasting.h"
@@ -717,3 +718,40 @@ TEST_CASE( "vision_see_into_vehicle", "[shadowcasting][vision]" )
 
     t.test();
 }
+
+static void update_player_vision( map &here, int z )
+{
+    here.update_visibility_cache( z );
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+}
+
+TEST_CASE( "visible_creatures_follow_vision_and_creature_changes", "[vision][monster]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_grass" ) );
+    set_time( midday );
+    Character &player_character = get_player_character();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    get_weather().weather_id = weather_type_id( "clear" );
+    g->reset_light_level();
+    map &here = get_map();
+    update_player_vision( here, 0 );
+    REQUIRE( player_character.get_visible_creatures( 60 ).empty() );
+
+    monster &zed = spawn_test_monster( "mon_zombie", tripoint( 66, 60, 0 ) );
+    CHECK( player_character.get_visible_creatures( 60 ) == std::vector<Creature *> { &zed } );
+    CHECK( player_character.get_visible_creatures( 5 ).empty() );
+
+    zed.setpos( tripoint( 63, 60, 0 ) );
+    CHECK( player_character.get_visible_creatures( 5 ).size() == 1 );
+
+    // Walls only hide the zombie once the seen cache is rebuilt
+    const ter_id t_wall( "t_wall" );
+    for( int y = 58; y <= 62; y++ ) {
+        here.ter_set( tripoint( 62, y, 0 ), t_wall );
+    }
+    update_player_vision( here, 0 );
+    CHECK( player_character.get_visible_creatures( 60 ).empty() );
+}
+
@@ -5,7 +5,12 @@
 #include <vector>
 
 #include "calendar.h"
+#include "coordinates.h"
+#include "game.h"
+#include "game_constants.h"
 #include "point.h"
+#include "state_helpers.h"
+#include "units_temperature.h"
 #include "weather.h"
 #include "weather_gen.h"
 
@@ -328,3 +333,66 @@ TEST_CASE( "local wind chill calculation", "[weather][wind_chill]" )
         }
     }
 }
+
+static void check_same_noise( const weather_noise &batched, const weather_noise &scalar )
+{
+    CHECK( units::to_celsius<double>( batched.temperature ) ==
+           Approx( units::to_celsius<double>( scalar.temperature ) ) );
+    CHECK( batched.humidity == Approx( scalar.humidity ) );
+    CHECK( batched.pressure == Approx( scalar.pressure ) );
+    CHECK( batched.wind == Approx( scalar.wind ).margin( 1e-9 ) );
+    CHECK( batched.acid == Approx( scalar.acid ).margin( 1e-9 ) );
+}
+
+TEST_CASE( "batched_weather_noise_matches_scalar_noise", "[weather]" )
+{
+    weather_generator generator;
+    generator.base_humidity = 66;
+    generator.base_pressure = 1015;
+    generator.season_stats[SPRING].average_temperature = 8_c;
+    generator.season_stats[SUMMER].average_temperature = 16_c;
+    generator.season_stats[SPRING].humidity_mod = 5;
+    const unsigned seed = 1234;
+    const point_abs_ms origin( -1000, 4321 );
+    constexpr int width = 7;
+    constexpr int height = 5;
+    constexpr int step = 24;
+
+    std::vector<weather_noise> noise;
+    for( const time_point &t : {
+             calendar::turn_zero, calendar::turn_zero + 13_hours + 7_minutes,
+             calendar::turn_zero + calendar::season_length() + 3_days
+         } ) {
+        generator.get_weather_noise( origin, width, height, step, t, calendar::config, seed, noise );
+        REQUIRE( noise.size() == static_cast<size_t>( width * height ) );
+        for( int j = 0; j < height; j++ ) {
+            for( int i = 0; i < width; i++ ) {
+                const tripoint_abs_ms p( origin.x() + i * step, origin.y() + j * step, 0 );
+                CAPTURE( p, to_turns<int>( t - calendar::turn_zero ) );
+                check_same_noise( noise[j * width + i],
+                                  generator.get_weather_noise( p, t, calendar::config, seed ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "weather_manager_caches_weather_noise_per_omt_and_hour", "[weather]" )
+{
+    clear_all_state();
+    const weather_generator &generator = get_weather().get_cur_weather_gen();
+    const time_point hour = calendar::turn_zero + 30_days + 5_hours;
+    calendar::turn = hour + 20_minutes;
+
+    for( const point_abs_omt &p : {
+             point_abs_omt( 0, 0 ), point_abs_omt( 17, 3 ), point_abs_omt( -1, -33 )
+         } ) {
+        CAPTURE( p );
+        const weather_noise expected = generator.get_weather_noise( project_to<coords::ms>(
+                                           tripoint_abs_omt( p, 0 ) ), hour, calendar::config, g->get_seed() );
+        check_same_noise( get_weather().get_weather_noise( generator, p ), expected );
+        check_same_noise( get_weather().get_weather_noise( generator, p ), expected );
+        get_weather().clear_weather_noise();
+        check_same_noise( get_weather().get_weather_noise( generator, p ), expected );
+    }
+}
+